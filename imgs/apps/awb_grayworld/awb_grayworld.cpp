@@ -18,6 +18,9 @@ int main(int argc, char* argv[]) {
   string dst_filename = "";
   double scale = 1.1;
   int max_value = 255;
+  string method = "lab";
+  double p = 6.0;
+  int stride = 1;
 
   po::options_description options("Options");
   options.add_options()("help,h", "display this message")(
@@ -28,7 +31,13 @@ int main(int argc, char* argv[]) {
                               po::value<double>(&scale),
                               "chrominance shift multiplier [default is 1.1]")(
       "max-value,m", po::value<int>(&max_value),
-      "maximum value [default is 255]");
+      "maximum value [default is 255]")(
+      "method", po::value<string>(&method),
+      "method (lab|gray_world|white_patch|shades_of_gray) [default is lab]")(
+      "norm,p", po::value<double>(&p),
+      "shades of gray norm [default is 6]")(
+      "stride,s", po::value<int>(&stride),
+      "statistics proxy stride [default is 1]");
 
   po::positional_options_description positional_options;
   positional_options.add("source-filename", -1);
@@ -58,6 +67,7 @@ int main(int argc, char* argv[]) {
     cout << "Source filename: " << src_filename << endl;
     cout << "Size: " << src.size() << endl;
     cout << "Channels: " << src.channels() << endl;
+    cout << "Method: " << method << endl;
     cout << "Chrominance shift multiplier: " << scale << endl;
     cout << "Maximum value: " << max_value << endl;
     cout << "Destination filename: " << dst_filename << endl;
@@ -65,7 +75,20 @@ int main(int argc, char* argv[]) {
 
   clock_t startTime = clock();
 
-  cv::Mat dst = ipcv::GrayworldAwb(src, scale, max_value);
+  cv::Mat dst;
+  if (method == "lab") {
+    dst = ipcv::GrayworldAwb(src, scale, max_value);
+  } else {
+    // Linear RGB gains (the type maximum unless one was provided)
+    int gain_max_value = vm.count("max-value") ? max_value : -1;
+    auto awb_method = ipcv::ParseAwbMethod(method);
+    cv::Vec3d gains =
+        ipcv::AwbGains(src, awb_method, p, stride, gain_max_value);
+    if (verbose) {
+      cout << "Gains [BGR]: " << gains << endl;
+    }
+    dst = ipcv::ApplyAwbGains(src, gains, gain_max_value);
+  }
 
   clock_t endTime = clock();
 
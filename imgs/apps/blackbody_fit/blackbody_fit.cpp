@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "imgs/radiometry/blackbody_fit/BlackbodyFit.h"
+#include "imgs/radiometry/blackbody_fit/TemperatureEmissivity.h"
 #include "imgs/plot/plot.h"
 
 using namespace std;
@@ -59,6 +60,17 @@ int main(int argc, char* argv[]) {
 
   cout << "Derived temperature = " << derived_temp << " [K]" << endl;
 
+  // least-squares graybody fit over the same band for comparison
+  radiometry::FitParams fit_params;
+  fit_params.lower_limit = lower_limit;
+  fit_params.upper_limit = upper_limit;
+  auto fit = radiometry::FitBlackbody(
+      Eigen::Map<const Eigen::ArrayXd>(wavelength.data(), wavelength.size()),
+      Eigen::Map<const Eigen::ArrayXd>(radiance.data(), radiance.size()),
+      fit_params);
+  cout << "Graybody fit temperature = " << fit.temperature << " [K]" << endl;
+  cout << "Graybody fit emissivity = " << fit.emissivity << endl;
+
   // plot parameters
   plot::plot2d::Params params;
   params.set_x_label("Wavelength (microns)");
@@ -26,4 +26,8 @@ int main() {
   cout << "Temperature = "
        << Temperature::CalcTemp(rad_search, wavelength, tolerance) << " [K]"
        << endl;
+  // the closed-form inverse of Planck's equation doesn't need a tolerance
+  cout << "Brightness temperature = "
+       << Temperature::BrightnessTemperature(rad_search, wavelength) << " [K]"
+       << endl;
 }
@@ -7,6 +7,7 @@
 #include <opencv2/highgui.hpp>
 
 #include "imgs/ipcv/demosaicing/Demosaic.h"
+#include "imgs/ipcv/raw_reader/RawReader.h"
 
 using namespace std;
 
@@ -17,6 +18,7 @@ int main(int argc, char* argv[]) {
   string src_filename = "";
   string dst_filename = "";
   string pattern = "GBRG";
+  ipcv::RawOptions raw;
 
   po::options_description options("Options");
   options.add_options()("help,h", "display this message")(
@@ -24,7 +26,20 @@ int main(int argc, char* argv[]) {
       "source-filename,i", po::value<string>(&src_filename), "source filename")(
       "destination-filename,o", po::value<string>(&dst_filename),
       "destination filename")("pattern,p", po::value<string>(&pattern),
-                              "pattern [default is GBRG]");
+                              "pattern [default is GBRG]")(
+      "raw-format,f", po::value<string>(&raw.format),
+      "headerless raw source format raw10|raw12|raw14|raw16 [default is to "
+      "read an image file]")("raw-width", po::value<int>(&raw.width),
+                             "raw frame width [pixels]")(
+      "raw-height", po::value<int>(&raw.height), "raw frame height [pixels]")(
+      "raw-stride", po::value<size_t>(&raw.stride),
+      "raw row stride [bytes, default is the packed row length]")(
+      "raw-offset", po::value<size_t>(&raw.offset),
+      "raw bytes preceding the first row [default is 0]")(
+      "black-level", po::value<int>(&raw.black_level),
+      "raw black level [default is 0]")(
+      "white-level", po::value<int>(&raw.white_level),
+      "raw white level [default is the raw format maximum]");
 
   po::positional_options_description positional_options;
   positional_options.add("source-filename", -1);
@@ -48,12 +63,20 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
 
-  cv::Mat src = cv::imread(src_filename, cv::IMREAD_UNCHANGED);
+  // Raw sources are normalized to 8 bits since the GBTF result is 8-bit (the
+  // reader must outlive src since raw16 data is viewed in place)
+  ipcv::RawReader raw_reader;
+  cv::Mat src = ipcv::LoadCfa(src_filename, raw, 255, raw_reader);
 
   if (verbose) {
     cout << "Source filename: " << src_filename << endl;
     cout << "Size: " << src.size() << endl;
     cout << "Channels: " << src.channels() << endl;
+    if (!raw.format.empty()) {
+      cout << "Raw format: " << raw.format << endl;
+      cout << "Black level: " << raw.black_level << endl;
+      cout << "White level: " << raw.white_level << endl;
+    }
     cout << "Pattern: " << pattern << endl;
     cout << "Destination filename: " << dst_filename << endl;
   }
@@ -0,0 +1,422 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "imgs/ipcv/demosaicing/Demosaic.h"
+#include "imgs/ipcv/utils/Utils.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+namespace {
+
+/* One benchmark measurement
+ */
+struct Result {
+  string demosaicer;
+  string pattern;
+  int width;
+  int height;
+  int threads;
+  double seconds;
+  double megapixels_per_second;
+  long peak_rss_kib;
+  double psnr;
+  double delta_e_1976;
+  double delta_e_1994;
+};
+
+/* Build an 8-bit BGR reference from the source image
+ *
+ * A 3-channel source is used as is.  A single-channel (CFA) source is
+ * binned 2 x 2 into one BGR pixel per CFA tile, which needs no
+ * interpolation, then scaled to [0, 255] and display gamma encoded.
+ */
+cv::Mat Reference(const cv::Mat& src, const string& pattern, int max_value,
+                  double gamma) {
+  if (src.channels() == 3) {
+    cv::Mat reference;
+    src.convertTo(reference, CV_8U, 255.0 / max_value);
+    return reference;
+  }
+  if (src.channels() != 1) {
+    cerr << "Source must be a 3-channel image or a single-channel CFA" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cv::Mat cfa_src;
+  src.convertTo(cfa_src, CV_32F, 1.0 / max_value);
+  ipcv::Cfa cfa(pattern);
+
+  cv::Mat reference(src.rows / 2, src.cols / 2, CV_8UC3);
+  for (int r = 0; r < reference.rows; r++) {
+    const float* row0 = cfa_src.ptr<float>(2 * r);
+    const float* row1 = cfa_src.ptr<float>(2 * r + 1);
+    cv::Vec3b* dst = reference.ptr<cv::Vec3b>(r);
+    for (int c = 0; c < reference.cols; c++) {
+      float bgr[3] = {0, 0, 0};
+      bgr[cfa.color(0, 0)] += row0[2 * c];
+      bgr[cfa.color(0, 1)] += row0[2 * c + 1];
+      bgr[cfa.color(1, 0)] += row1[2 * c];
+      bgr[cfa.color(1, 1)] += row1[2 * c + 1];
+      bgr[ipcv::Cfa::green] /= 2;
+      for (int k = 0; k < 3; k++) {
+        float v = pow(min(max(bgr[k], 0.0f), 1.0f), 1.0 / gamma);
+        dst[c][k] = cv::saturate_cast<uint8_t>(255 * v);
+      }
+    }
+  }
+  return reference;
+}
+
+/* Sample an 8-bit BGR image through the provided CFA
+ */
+cv::Mat Mosaic(const cv::Mat& bgr, const string& pattern) {
+  ipcv::Cfa cfa(pattern);
+  cv::Mat mosaic(bgr.size(), CV_8UC1);
+  for (int r = 0; r < bgr.rows; r++) {
+    const cv::Vec3b* src = bgr.ptr<cv::Vec3b>(r);
+    uint8_t* dst = mosaic.ptr<uint8_t>(r);
+    for (int c = 0; c < bgr.cols; c++) {
+      dst[c] = src[c][cfa.color(r, c)];
+    }
+  }
+  return mosaic;
+}
+
+/* Demosaic a CFA with the named algorithm, returning its native output
+ *
+ * Laroche and Prescott is given the CFA values in a 16-bit image, which is
+ * its documented input, the other demosaicers take the 8-bit CFA.
+ */
+cv::Mat Demosaic(const string& demosaicer, const cv::Mat& mosaic,
+                 const cv::Mat& mosaic_16u, const string& pattern) {
+  cv::Mat dst;
+  if (demosaicer == "bilinear") {
+    dst = ipcv::Bilinear(mosaic, pattern);
+  } else if (demosaicer == "laroche_prescott") {
+    dst = ipcv::LarochePrescott(mosaic_16u, pattern, 255);
+  } else if (demosaicer == "malvar_he_cutler") {
+    dst = ipcv::MalvarHeCutler(mosaic, pattern, 255);
+  } else if (demosaicer == "gbtf") {
+    ipcv::GBTF(mosaic, dst, pattern);
+  } else {
+    cerr << "Invalid demosaicer provided: " << demosaicer << endl;
+    exit(EXIT_FAILURE);
+  }
+  return dst;
+}
+
+/* Reset the process peak resident set size to the current resident set
+ * size, so that the next PeakRssKib reading covers only the work done in
+ * between (Linux, returns false where the high-water mark cannot be reset)
+ */
+bool ResetPeakRss() {
+  ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5" << flush;
+  return static_cast<bool>(clear_refs);
+}
+
+/* Peak resident set size of the process since the last reset [KiB], -1 if
+ * it is unavailable
+ */
+long PeakRssKib() {
+  ifstream status("/proc/self/status");
+  string line;
+  while (getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return stol(line.substr(6));
+    }
+  }
+  return -1;
+}
+
+/* Quote a string for a JSON document
+ */
+string JsonString(const string& value) {
+  string quoted = "\"";
+  for (unsigned char ch : value) {
+    if ((ch == '"') || (ch == '\\')) {
+      quoted += '\\';
+      quoted += ch;
+    } else if (ch < 0x20) {
+      char escape[8];
+      snprintf(escape, sizeof(escape), "\\u%04x", ch);
+      quoted += escape;
+    } else {
+      quoted += ch;
+    }
+  }
+  return quoted + "\"";
+}
+
+/* Quote a string for a CSV field where it needs it (RFC 4180)
+ */
+string CsvField(const string& value) {
+  if (value.find_first_of(",\"\r\n") == string::npos) {
+    return value;
+  }
+  string quoted = "\"";
+  for (char ch : value) {
+    quoted += ch;
+    if (ch == '"') {
+      quoted += '"';
+    }
+  }
+  return quoted + "\"";
+}
+
+void WriteCsv(ostream& out, const vector<Result>& results,
+              const string& label) {
+  out << "label,demosaicer,pattern,width,height,threads,seconds,"
+         "megapixels_per_second,peak_rss_kib,psnr,delta_e_1976,delta_e_1994"
+      << endl;
+  for (const auto& result : results) {
+    out << CsvField(label) << "," << result.demosaicer << ","
+        << result.pattern << "," << result.width << "," << result.height
+        << "," << result.threads << "," << result.seconds << ","
+        << result.megapixels_per_second << "," << result.peak_rss_kib << ","
+        << result.psnr << "," << result.delta_e_1976 << "," << result.delta_e_1994 << endl;
+  }
+}
+
+void WriteJson(ostream& out, const vector<Result>& results,
+               const string& label) {
+  out << "{" << endl;
+  out << "  \"label\": " << JsonString(label) << "," << endl;
+  out << "  \"results\": [" << endl;
+  for (size_t idx = 0; idx < results.size(); idx++) {
+    const auto& result = results[idx];
+    out << "    {\"demosaicer\": \"" << result.demosaicer << "\", "
+        << "\"pattern\": \"" << result.pattern << "\", "
+        << "\"width\": " << result.width << ", "
+        << "\"height\": " << result.height << ", "
+        << "\"threads\": " << result.threads << ", "
+        << "\"seconds\": " << result.seconds << ", "
+        << "\"megapixels_per_second\": " << result.megapixels_per_second
+        << ", "
+        << "\"peak_rss_kib\": " << result.peak_rss_kib << ", "
+        << "\"psnr\": " << result.psnr << ", "
+        << "\"delta_e_1976\": " << result.delta_e_1976 << ", "
+        << "\"delta_e_1994\": " << result.delta_e_1994 << "}"
+        << ((idx + 1 < results.size()) ? "," : "") << endl;
+  }
+  out << "  ]" << endl;
+  out << "}" << endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  bool verbose = false;
+  string src_filename = "";
+  string dst_filename = "";
+  string src_pattern = "GBRG";
+  int max_value = -1;
+  double gamma = 2.2;
+  vector<string> demosaicers = {"bilinear", "laroche_prescott",
+                                "malvar_he_cutler", "gbtf"};
+  vector<string> patterns = {"GBRG", "GRBG", "BGGR", "RGGB"};
+  vector<double> scales = {0.5, 1.0, 2.0};
+  vector<int> threads = {1, cv::getNumberOfCPUs()};
+  int repetitions = 3;
+  int border = 8;
+  string format = "csv";
+  string label = "";
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "verbose,v", po::bool_switch(&verbose), "verbose [default is silent]")(
+      "source-filename,i", po::value<string>(&src_filename),
+      "source filename (3-channel reference or single-channel CFA)")(
+      "destination-filename,o", po::value<string>(&dst_filename),
+      "destination filename [default is standard output]")(
+      "source-pattern,p", po::value<string>(&src_pattern),
+      "CFA layout of a single-channel source [default is GBRG]")(
+      "max-value,m", po::value<int>(&max_value),
+      "maximum value of the source [default is the maximum of the source "
+      "data type]")("gamma", po::value<double>(&gamma),
+                    "display gamma applied to a CFA source reference "
+                    "[default is 2.2]")(
+      "demosaicers,d", po::value<vector<string>>(&demosaicers)->multitoken(),
+      "demosaicers bilinear|laroche_prescott|malvar_he_cutler|gbtf [default "
+      "is all]")("patterns", po::value<vector<string>>(&patterns)->multitoken(),
+                 "CFA patterns [default is GBRG GRBG BGGR RGGB]")(
+      "scales,s", po::value<vector<double>>(&scales)->multitoken(),
+      "reference image scale factors [default is 0.5 1 2]")(
+      "threads,t", po::value<vector<int>>(&threads)->multitoken(),
+      "thread counts [default is 1 and the number of CPUs]")(
+      "repetitions,r", po::value<int>(&repetitions),
+      "timed repetitions per measurement, the median is reported [default "
+      "is 3]")("border,b", po::value<int>(&border),
+               "border excluded from the quality metrics [pixels, default is "
+               "8]")("format,f", po::value<string>(&format),
+                     "output format csv|json [default is csv]")(
+      "label,l", po::value<string>(&label),
+      "label recorded with the results (e.g. a version) [default is empty]");
+
+  po::positional_options_description positional_options;
+  positional_options.add("source-filename", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(options)
+                .positional(positional_options)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options] source-filename" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (!boost::filesystem::exists(src_filename)) {
+    cerr << "Provided source file does not exists" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if ((format != "csv") && (format != "json")) {
+    cerr << "Invalid output format provided: " << format << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (repetitions < 1) {
+    cerr << "At least one repetition must be requested" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cv::Mat src = cv::imread(src_filename, cv::IMREAD_UNCHANGED);
+  if (max_value < 0) {
+    max_value = (src.depth() == CV_8U) ? 255 : 65535;
+  }
+  cv::Mat reference = Reference(src, src_pattern, max_value, gamma);
+
+  // Progress is reported on the error stream so that results written to
+  // the standard output remain machine readable
+  if (verbose) {
+    cerr << "Source filename: " << src_filename << endl;
+    cerr << "Size: " << src.size() << endl;
+    cerr << "Channels: " << src.channels() << endl;
+    cerr << "Reference size: " << reference.size() << endl;
+    cerr << "Repetitions: " << repetitions << endl;
+    cerr << "Destination filename: " << dst_filename << endl;
+  }
+
+  std::sort(scales.begin(), scales.end());
+
+  // The thread count is a process-wide OpenCV setting, restored afterwards
+  int caller_threads = cv::getNumThreads();
+
+  vector<Result> results;
+  for (auto scale : scales) {
+    cv::Mat scaled;
+    cv::resize(reference, scaled, cv::Size(), scale, scale,
+               (scale < 1) ? cv::INTER_AREA : cv::INTER_CUBIC);
+    // Even dimensions keep every pattern's tile complete
+    scaled = scaled(cv::Rect(0, 0, scaled.cols & ~1, scaled.rows & ~1));
+    if ((scaled.cols <= 2 * border + 16) || (scaled.rows <= 2 * border + 16)) {
+      cerr << "Scale " << scale << " is too small, skipping" << endl;
+      continue;
+    }
+    cv::Rect interior(border, border, scaled.cols - 2 * border,
+                      scaled.rows - 2 * border);
+    cv::Mat truth = scaled(interior).clone();
+    double megapixels = scaled.total() / 1.0e6;
+
+    for (const auto& pattern : patterns) {
+      cv::Mat mosaic = Mosaic(scaled, pattern);
+      // Same [0, 255] values, so every demosaicer sees identical data
+      cv::Mat mosaic_16u;
+      mosaic.convertTo(mosaic_16u, CV_16U);
+
+      for (const auto& demosaicer : demosaicers) {
+        // Quality does not depend on the thread count, so it is measured
+        // once per image (the conversion to 8 bits is not timed)
+        cv::Mat dst = Demosaic(demosaicer, mosaic, mosaic_16u, pattern);
+        if (dst.depth() != CV_8U) {
+          dst.convertTo(dst, CV_8U);
+        }
+        cv::Mat estimate = dst(interior).clone();
+        double psnr = ipcv::Psnr(estimate, truth, 255);
+        double delta_e_1976 = ipcv::DeltaE(estimate, truth, 255, 1976);
+        double delta_e_1994 = ipcv::DeltaE(estimate, truth, 255, 1994);
+
+        for (auto thread_count : threads) {
+          cv::setNumThreads(thread_count);
+
+          // The peak resident set size is a process high-water mark, it is
+          // reset so that it covers only these runs (the inputs and earlier
+          // results still resident are included, as they are for any caller)
+          bool peak_reset = ResetPeakRss();
+
+          // Wall time (clock() would sum the time of every thread)
+          vector<double> seconds;
+          for (int idx = 0; idx < repetitions; idx++) {
+            auto start = chrono::steady_clock::now();
+            Demosaic(demosaicer, mosaic, mosaic_16u, pattern);
+            auto end = chrono::steady_clock::now();
+            seconds.push_back(chrono::duration<double>(end - start).count());
+          }
+          std::nth_element(seconds.begin(),
+                           seconds.begin() + seconds.size() / 2,
+                           seconds.end());
+          double median = seconds[seconds.size() / 2];
+
+          Result result;
+          result.demosaicer = demosaicer;
+          result.pattern = pattern;
+          result.width = scaled.cols;
+          result.height = scaled.rows;
+          result.threads = thread_count;
+          result.seconds = median;
+          result.megapixels_per_second = megapixels / median;
+          result.peak_rss_kib = peak_reset ? PeakRssKib() : -1;
+          result.psnr = psnr;
+          result.delta_e_1976 = delta_e_1976;
+          result.delta_e_1994 = delta_e_1994;
+          results.push_back(result);
+
+          if (verbose) {
+            cerr << demosaicer << " " << pattern << " " << scaled.size()
+                 << " threads=" << thread_count
+                 << " MP/s=" << result.megapixels_per_second
+                 << " PSNR=" << psnr << " dE76=" << delta_e_1976
+                 << " dE94=" << delta_e_1994 << endl;
+          }
+        }
+      }
+    }
+  }
+  cv::setNumThreads(caller_threads);
+
+  ofstream file;
+  if (!dst_filename.empty()) {
+    file.open(dst_filename);
+    if (!file) {
+      cerr << "Unable to open destination file: " << dst_filename << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  ostream& out = dst_filename.empty() ? cout : file;
+  if (format == "json") {
+    WriteJson(out, results, label);
+  } else {
+    WriteCsv(out, results, label);
+  }
+
+  return EXIT_SUCCESS;
+}
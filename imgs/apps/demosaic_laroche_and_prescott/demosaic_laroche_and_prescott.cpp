@@ -9,6 +9,7 @@
 #include <opencv2/imgcodecs.hpp>
 
 #include "imgs/ipcv/demosaicing/Demosaic.h"
+#include "imgs/ipcv/raw_reader/RawReader.h"
 #include "imgs/ipcv/utils/Utils.h"
 
 using namespace std;
@@ -20,6 +21,7 @@ int main(int argc, char* argv[]) {
   string src_filename = "";
   string dst_filename = "";
   string pattern = "GBRG";
+  ipcv::RawOptions raw;
   int max_value = 65535;
 
   po::options_description options("Options");
@@ -30,7 +32,20 @@ int main(int argc, char* argv[]) {
       "destination filename")("pattern,p", po::value<string>(&pattern),
                               "pattern [default is GBRG]")(
       "max-value,m", po::value<int>(&max_value),
-      "maximum value [default is 65535]");
+      "maximum value [default is 65535]")(
+      "raw-format,f", po::value<string>(&raw.format),
+      "headerless raw source format raw10|raw12|raw14|raw16 [default is to "
+      "read an image file]")("raw-width", po::value<int>(&raw.width),
+                             "raw frame width [pixels]")(
+      "raw-height", po::value<int>(&raw.height), "raw frame height [pixels]")(
+      "raw-stride", po::value<size_t>(&raw.stride),
+      "raw row stride [bytes, default is the packed row length]")(
+      "raw-offset", po::value<size_t>(&raw.offset),
+      "raw bytes preceding the first row [default is 0]")(
+      "black-level", po::value<int>(&raw.black_level),
+      "raw black level [default is 0]")(
+      "white-level", po::value<int>(&raw.white_level),
+      "raw white level [default is the raw format maximum]");
 
   po::positional_options_description positional_options;
   positional_options.add("source-filename", -1);
@@ -54,12 +69,20 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
 
-  cv::Mat src = cv::imread(src_filename, cv::IMREAD_UNCHANGED);
+  // Raw sources are normalized to the maximum value (the reader must outlive
+  // src since raw16 data is viewed in place)
+  ipcv::RawReader raw_reader;
+  cv::Mat src = ipcv::LoadCfa(src_filename, raw, max_value, raw_reader);
 
   if (verbose) {
     cout << "Source filename: " << src_filename << endl;
     cout << "Size: " << src.size() << endl;
     cout << "Channels: " << src.channels() << endl;
+    if (!raw.format.empty()) {
+      cout << "Raw format: " << raw.format << endl;
+      cout << "Black level: " << raw.black_level << endl;
+      cout << "White level: " << raw.white_level << endl;
+    }
     cout << "Pattern: " << pattern << endl;
     cout << "Maximum value: " << max_value << endl;
     cout << "Destination filename: " << dst_filename << endl;
@@ -0,0 +1,110 @@
+#include <ctime>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+#include "imgs/ipcv/demosaicing/Demosaic.h"
+#include "imgs/ipcv/raw_reader/RawReader.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  bool verbose = false;
+  string src_filename = "";
+  string dst_filename = "";
+  string pattern = "GBRG";
+  ipcv::RawOptions raw;
+  int max_value = -1;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "verbose,v", po::bool_switch(&verbose), "verbose [default is silent]")(
+      "source-filename,i", po::value<string>(&src_filename), "source filename")(
+      "destination-filename,o", po::value<string>(&dst_filename),
+      "destination filename")("pattern,p", po::value<string>(&pattern),
+                              "pattern [default is GBRG]")(
+      "max-value,m", po::value<int>(&max_value),
+      "maximum value [default is the maximum of the source data type]")(
+      "raw-format,f", po::value<string>(&raw.format),
+      "headerless raw source format raw10|raw12|raw14|raw16 [default is to "
+      "read an image file]")("raw-width", po::value<int>(&raw.width),
+                             "raw frame width [pixels]")(
+      "raw-height", po::value<int>(&raw.height), "raw frame height [pixels]")(
+      "raw-stride", po::value<size_t>(&raw.stride),
+      "raw row stride [bytes, default is the packed row length]")(
+      "raw-offset", po::value<size_t>(&raw.offset),
+      "raw bytes preceding the first row [default is 0]")(
+      "black-level", po::value<int>(&raw.black_level),
+      "raw black level [default is 0]")(
+      "white-level", po::value<int>(&raw.white_level),
+      "raw white level [default is the raw format maximum]");
+
+  po::positional_options_description positional_options;
+  positional_options.add("source-filename", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(options)
+                .positional(positional_options)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options] source-filename" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (!boost::filesystem::exists(src_filename)) {
+    cerr << "Provided source file does not exists" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Raw sources are unpacked to the full 16-bit range (the reader must
+  // outlive src since raw16 data is viewed in place)
+  ipcv::RawReader raw_reader;
+  cv::Mat src = ipcv::LoadCfa(src_filename, raw, 65535, raw_reader);
+
+  if (verbose) {
+    cout << "Source filename: " << src_filename << endl;
+    cout << "Size: " << src.size() << endl;
+    cout << "Channels: " << src.channels() << endl;
+    if (!raw.format.empty()) {
+      cout << "Raw format: " << raw.format << endl;
+      cout << "Black level: " << raw.black_level << endl;
+      cout << "White level: " << raw.white_level << endl;
+    }
+    cout << "Pattern: " << pattern << endl;
+    cout << "Maximum value: " << max_value << endl;
+    cout << "Destination filename: " << dst_filename << endl;
+  }
+
+  clock_t startTime = clock();
+
+  cv::Mat dst = ipcv::MalvarHeCutler(src, pattern, max_value);
+
+  clock_t endTime = clock();
+
+  if (verbose) {
+    cout << "Elapsed time: "
+         << (endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC)
+         << " [s]" << endl;
+  }
+
+  if (dst_filename.empty()) {
+    cv::imshow(src_filename, src);
+    cv::imshow(src_filename + " [CFA Interpolated]", dst);
+    cv::waitKey(0);
+  } else {
+    cv::imwrite(dst_filename, dst);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <eigen3/Eigen/Dense>
+#include <opencv2/core.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+#include "imgs/color/hyperspectral/HyperspectralRenderer.h"
+#include "imgs/utils/file/csvfile/CsvTable.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  bool verbose = false;
+  string src_filename = "";
+  string dst_filename = "";
+  int rows = 0;
+  int cols = 0;
+  int bands = 0;
+  string interleave = "bip";
+  string data_type = "float32";
+  size_t offset = 0;
+  string wavelengths_filename = "";
+  size_t header_lines = 1;
+  double first_wavelength = 400;
+  double last_wavelength = 700;
+  string illuminant = "d65";
+  int observer = 10;
+  double scale = 1.0;
+  int bits = 8;
+  int tile_rows = 16;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "verbose,v", po::bool_switch(&verbose), "verbose [default is silent]")(
+      "source-filename,i", po::value<string>(&src_filename),
+      "headerless cube filename")(
+      "destination-filename,o", po::value<string>(&dst_filename),
+      "destination filename")("rows", po::value<int>(&rows), "cube rows")(
+      "cols", po::value<int>(&cols), "cube columns")(
+      "bands", po::value<int>(&bands), "cube bands")(
+      "interleave", po::value<string>(&interleave),
+      "interleave bip|bil|bsq [default is bip]")(
+      "data-type", po::value<string>(&data_type),
+      "sample type uint8|uint16|int16|float32|float64 [default is float32]")(
+      "offset", po::value<size_t>(&offset),
+      "bytes preceding the first sample [default is 0]")(
+      "wavelengths-filename,w", po::value<string>(&wavelengths_filename),
+      "CSV file with the band wavelengths [nm] in its first column [default "
+      "is uniform spacing]")(
+      "header-lines", po::value<size_t>(&header_lines),
+      "wavelengths file header lines [default is 1]")(
+      "first-wavelength", po::value<double>(&first_wavelength),
+      "first band wavelength for uniform spacing [default is 400 nm]")(
+      "last-wavelength", po::value<double>(&last_wavelength),
+      "last band wavelength for uniform spacing [default is 700 nm]")(
+      "illuminant", po::value<string>(&illuminant),
+      "CIE reference illuminant a|d65 [default is d65]")(
+      "observer", po::value<int>(&observer),
+      "CIE standard observer 2|10 [default is 10 degree]")(
+      "scale,s", po::value<double>(&scale),
+      "multiplier taking samples to unit reflectance [default is 1]")(
+      "bits,b", po::value<int>(&bits),
+      "destination bits per channel 8|16 [default is 8]")(
+      "tile-rows", po::value<int>(&tile_rows),
+      "rows per parallel tile [default is 16]");
+
+  po::positional_options_description positional_options;
+  positional_options.add("source-filename", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(options)
+                .positional(positional_options)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options] source-filename" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (!boost::filesystem::exists(src_filename)) {
+    cerr << "Provided source file does not exists" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A headerless cube has no other source for its dimensions
+  if (!vm.count("rows") || !vm.count("cols") || !vm.count("bands")) {
+    cerr << "Cube rows, cols, and bands must be provided" << endl;
+    return EXIT_FAILURE;
+  }
+  if ((rows <= 0) || (cols <= 0) || (bands <= 0)) {
+    cerr << "Cube rows, cols, and bands must be positive" << endl;
+    return EXIT_FAILURE;
+  }
+
+  color::CubeLayout layout;
+  layout.rows = rows;
+  layout.cols = cols;
+  layout.bands = bands;
+  layout.interleave = color::ParseInterleave(interleave);
+  layout.offset = offset;
+  if (data_type == "uint8") {
+    layout.depth = CV_8U;
+  } else if (data_type == "uint16") {
+    layout.depth = CV_16U;
+  } else if (data_type == "int16") {
+    layout.depth = CV_16S;
+  } else if (data_type == "float32") {
+    layout.depth = CV_32F;
+  } else if (data_type == "float64") {
+    layout.depth = CV_64F;
+  } else {
+    cerr << "Invalid data type provided: " << data_type << endl;
+    return EXIT_FAILURE;
+  }
+
+  int reference_illuminant;
+  if (illuminant == "a") {
+    reference_illuminant = color::CIE::ReferenceIlluminant::a;
+  } else if (illuminant == "d65") {
+    reference_illuminant = color::CIE::ReferenceIlluminant::d65;
+  } else {
+    cerr << "Invalid illuminant provided: " << illuminant << endl;
+    return EXIT_FAILURE;
+  }
+
+  int standard_observer;
+  if (observer == 2) {
+    standard_observer = color::CIE::StandardObserver::two_deg;
+  } else if (observer == 10) {
+    standard_observer = color::CIE::StandardObserver::ten_deg;
+  } else {
+    cerr << "Invalid observer provided: " << observer << endl;
+    return EXIT_FAILURE;
+  }
+
+  if ((bits != 8) && (bits != 16)) {
+    cerr << "Destination bits per channel must be 8 or 16" << endl;
+    return EXIT_FAILURE;
+  }
+
+  Eigen::VectorXd wavelengths;
+  if (wavelengths_filename.empty()) {
+    wavelengths =
+        Eigen::VectorXd::LinSpaced(bands, first_wavelength, last_wavelength);
+  } else {
+    wavelengths = utils::CsvTable(wavelengths_filename, header_lines).column(1);
+  }
+  if (wavelengths.size() != bands) {
+    cerr << "Wavelength count (" << wavelengths.size()
+         << ") does not match the band count (" << bands << ")" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (verbose) {
+    cout << "Source filename: " << src_filename << endl;
+    cout << "Size: " << cols << " x " << rows << " x " << bands << endl;
+    cout << "Interleave: " << interleave << endl;
+    cout << "Data type: " << data_type << endl;
+    cout << "Wavelengths: " << wavelengths(0) << " - "
+         << wavelengths(wavelengths.size() - 1) << " [nm]" << endl;
+    cout << "Illuminant: " << illuminant << endl;
+    cout << "Observer: " << observer << " [deg]" << endl;
+    cout << "Scale: " << scale << endl;
+    cout << "Bits: " << bits << endl;
+    cout << "Tile rows: " << tile_rows << endl;
+    cout << "Destination filename: " << dst_filename << endl;
+  }
+
+  clock_t startTime = clock();
+
+  color::HyperspectralRenderer renderer(wavelengths, reference_illuminant,
+                                        standard_observer, scale,
+                                        (bits == 8) ? CV_8U : CV_16U,
+                                        tile_rows);
+  cv::Mat dst = renderer.Render(src_filename, layout);
+
+  clock_t endTime = clock();
+
+  if (verbose) {
+    cout << "Elapsed time: "
+         << (endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC)
+         << " [s]" << endl;
+  }
+
+  if (dst_filename.empty()) {
+    cv::imshow(src_filename + " [Rendered]", dst);
+    cv::waitKey(0);
+  } else {
+    cv::imwrite(dst_filename, dst);
+  }
+
+  return EXIT_SUCCESS;
+}
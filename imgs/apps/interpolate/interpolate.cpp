@@ -1,22 +1,153 @@
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
 
 #include "imgs/numerical/interpolation/interpolation.h"
 
 using namespace std;
 
-int main() {
+namespace po = boost::program_options;
+
+namespace {
+
+/* Mean wall time of one call [s]
+ */
+double Time(const function<void()>& call, int repetitions) {
+  auto start = chrono::steady_clock::now();
+  for (int idx = 0; idx < repetitions; idx++) {
+    call();
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double>(end - start).count() / repetitions;
+}
+
+void Benchmark(int samples, int queries, int columns, int repetitions) {
+  mt19937 generator(0);
+  uniform_real_distribution<double> uniform(0, 1);
+
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(samples, 360, 830);
+  Eigen::MatrixXd y(samples, columns);
+  for (Eigen::Index idx = 0; idx < y.size(); idx++) {
+    y.data()[idx] = uniform(generator);
+  }
+
+  Eigen::VectorXd shuffled(queries);
+  for (Eigen::Index idx = 0; idx < queries; idx++) {
+    shuffled[idx] = 360 + 470 * uniform(generator);
+  }
+  Eigen::VectorXd sorted = shuffled;
+  sort(sorted.data(), sorted.data() + queries);
+
+  cout << "Samples: " << samples << endl;
+  cout << "Queries: " << queries << endl;
+  cout << "Columns: " << columns << endl;
+  cout << "Repetitions: " << repetitions << endl;
+  cout << endl;
+
+  Eigen::VectorXd y0 = y.col(0);
+  auto report = [&](const string& label, const function<void()>& call) {
+    cout << label << ": " << Time(call, repetitions) * 1e6 << " [us]"
+         << endl;
+  };
+
+  report("Linear, unsorted queries (binary search)",
+         [&]() { numerical::Interp1(shuffled, x, y0); });
+  report("Linear, sorted queries (merge walk)",
+         [&]() { numerical::Interp1(sorted, x, y0); });
+  report("Linear, " + to_string(columns) + " columns, one call each", [&]() {
+    for (int j = 0; j < columns; j++) {
+      numerical::Interp1(sorted, x, y.col(j));
+    }
+  });
+  report("Linear, " + to_string(columns) + " columns, one plan",
+         [&]() { numerical::Interp1Columns(sorted, x, y); });
+
+  numerical::Interp1Plan plan(sorted, x);
+  report("Plan construction, sorted queries",
+         [&]() { numerical::Interp1Plan(sorted, x); });
+  report("Linear, reused plan", [&]() { plan.Apply(y0); });
+  report("Spline, reused plan",
+         [&]() { plan.Apply(y0, numerical::InterpMethod::spline); });
+  report("PCHIP, reused plan",
+         [&]() { plan.Apply(y0, numerical::InterpMethod::pchip); });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  string method = "linear";
+  bool benchmark = false;
+  int samples = 471;
+  int queries = 10000;
+  int columns = 4;
+  int repetitions = 100;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "method,m", po::value<string>(&method),
+      "method linear|spline|pchip [default is linear]")(
+      "benchmark,b", po::bool_switch(&benchmark),
+      "time the interpolation variants instead [default is off]")(
+      "samples", po::value<int>(&samples),
+      "benchmark samples [default is 471]")(
+      "queries", po::value<int>(&queries),
+      "benchmark query points [default is 10000]")(
+      "columns", po::value<int>(&columns),
+      "benchmark dependent vectors [default is 4]")(
+      "repetitions", po::value<int>(&repetitions),
+      "benchmark repetitions [default is 100]");
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(options).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (benchmark) {
+    if ((samples < 2) || (queries < 1) || (columns < 1) ||
+        (repetitions < 1)) {
+      cerr << "Benchmark sizes must be positive (at least 2 samples)"
+           << endl;
+      return EXIT_FAILURE;
+    }
+    Benchmark(samples, queries, columns, repetitions);
+    return EXIT_SUCCESS;
+  }
+
+  numerical::InterpMethod interp_method;
+  if (method == "linear") {
+    interp_method = numerical::InterpMethod::linear;
+  } else if (method == "spline") {
+    interp_method = numerical::InterpMethod::spline;
+  } else if (method == "pchip") {
+    interp_method = numerical::InterpMethod::pchip;
+  } else {
+    cerr << "Invalid method provided: " << method << endl;
+    return EXIT_FAILURE;
+  }
+
   Eigen::VectorXd x(11);
   x << 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10;
   Eigen::VectorXd y(11);
-  for (size_t idx = 0; idx < static_cast<size_t>(x.size()); idx++) {    
+  for (size_t idx = 0; idx < static_cast<size_t>(x.size()); idx++) {
     y[idx] = pow(x[idx], 2);
   }
 
   Eigen::VectorXd xhat(4);
   xhat << 1.7, 4, 6.2, 7.8;
 
-  Eigen::VectorXd yhat = numerical::Interp1(xhat, x, y);
+  Eigen::VectorXd yhat = numerical::Interp1(xhat, x, y, interp_method);
 
   cout << "Original data:" << endl;
   for (size_t idx = 0; idx < static_cast<size_t>(x.size()); idx++) {
@@ -0,0 +1,179 @@
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+#include "imgs/ipcv/raw_pipeline/RawPipeline.h"
+#include "imgs/ipcv/raw_reader/RawReader.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  bool verbose = false;
+  string src_filename = "";
+  string dst_filename = "";
+  string pattern = "GBRG";
+  string demosaicer = "bilinear";
+  string raw_format = "";
+  int raw_width = 0;
+  int raw_height = 0;
+  size_t raw_stride = 0;
+  size_t raw_offset = 0;
+  int black_level = 0;
+  int white_level = -1;
+  vector<double> gains;
+  vector<double> color_matrix;
+  double gamma = 2.2;
+  int max_value = 255;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "verbose,v", po::bool_switch(&verbose), "verbose [default is silent]")(
+      "source-filename,i", po::value<string>(&src_filename), "source filename")(
+      "destination-filename,o", po::value<string>(&dst_filename),
+      "destination filename")("pattern,p", po::value<string>(&pattern),
+                              "pattern [default is GBRG]")(
+      "demosaicer,d", po::value<string>(&demosaicer),
+      "demosaicer bilinear|laroche_prescott|malvar_he_cutler|gbtf [default is "
+      "bilinear]")(
+      "raw-format,f", po::value<string>(&raw_format),
+      "headerless raw source format raw10|raw12|raw14|raw16 [default is to "
+      "read an image file]")("raw-width", po::value<int>(&raw_width),
+                             "raw frame width [pixels]")(
+      "raw-height", po::value<int>(&raw_height), "raw frame height [pixels]")(
+      "raw-stride", po::value<size_t>(&raw_stride),
+      "raw row stride [bytes, default is the packed row length]")(
+      "raw-offset", po::value<size_t>(&raw_offset),
+      "raw bytes preceding the first row [default is 0]")(
+      "black-level", po::value<int>(&black_level),
+      "black level [default is 0]")(
+      "white-level", po::value<int>(&white_level),
+      "white level [default is the source data type maximum]")(
+      "gains,g", po::value<vector<double>>(&gains)->multitoken(),
+      "white balance gains B G R [default is gray world]")(
+      "color-matrix,c", po::value<vector<double>>(&color_matrix)->multitoken(),
+      "3x3 color matrix on RGB, 9 values in row order [default is the "
+      "identity]")("gamma", po::value<double>(&gamma),
+                   "gamma [default is 2.2]")(
+      "max-value,m", po::value<int>(&max_value),
+      "maximum destination value [default is 255]");
+
+  po::positional_options_description positional_options;
+  positional_options.add("source-filename", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(options)
+                .positional(positional_options)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options] source-filename" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (!boost::filesystem::exists(src_filename)) {
+    cerr << "Provided source file does not exists" << endl;
+    return EXIT_FAILURE;
+  }
+
+  ipcv::RawPipeline::Demosaicer algorithm;
+  if (demosaicer == "bilinear") {
+    algorithm = ipcv::RawPipeline::Demosaicer::bilinear;
+  } else if (demosaicer == "laroche_prescott") {
+    algorithm = ipcv::RawPipeline::Demosaicer::laroche_prescott;
+  } else if (demosaicer == "malvar_he_cutler") {
+    algorithm = ipcv::RawPipeline::Demosaicer::malvar_he_cutler;
+  } else if (demosaicer == "gbtf") {
+    algorithm = ipcv::RawPipeline::Demosaicer::gbtf;
+  } else {
+    cerr << "Invalid demosaicer provided: " << demosaicer << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!gains.empty() && (gains.size() != 3)) {
+    cerr << "Three white balance gains must be provided" << endl;
+    return EXIT_FAILURE;
+  }
+  if (!color_matrix.empty() && (color_matrix.size() != 9)) {
+    cerr << "Nine color matrix values must be provided" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The source is left at its native scale since the pipeline subtracts the
+  // black level itself (the reader must outlive src since raw16 data is
+  // viewed in place)
+  ipcv::RawReader raw_reader;
+  cv::Mat src;
+  if (raw_format.empty()) {
+    src = cv::imread(src_filename, cv::IMREAD_UNCHANGED);
+  } else {
+    raw_reader.Open(src_filename, ipcv::ParseRawFormat(raw_format), raw_width,
+                    raw_height, raw_stride, raw_offset);
+    int max_sample = (1 << raw_reader.bits()) - 1;
+    src = raw_reader.Read(0, max_sample, max_sample);
+    if (white_level < 0) {
+      white_level = max_sample;
+    }
+  }
+
+  ipcv::RawPipeline pipeline(pattern, algorithm);
+  pipeline.set_black_level(black_level);
+  pipeline.set_white_level(white_level);
+  if (!gains.empty()) {
+    pipeline.set_gains(cv::Vec3d(gains[0], gains[1], gains[2]));
+  }
+  if (!color_matrix.empty()) {
+    cv::Matx33d m;
+    for (int idx = 0; idx < 9; idx++) {
+      m(idx / 3, idx % 3) = color_matrix[idx];
+    }
+    pipeline.set_color_matrix(m);
+  }
+  pipeline.set_gamma(gamma);
+  pipeline.set_max_value(max_value);
+
+  if (verbose) {
+    cout << "Source filename: " << src_filename << endl;
+    cout << "Size: " << src.size() << endl;
+    cout << "Channels: " << src.channels() << endl;
+    cout << "Pattern: " << pattern << endl;
+    cout << "Demosaicer: " << demosaicer << endl;
+    cout << "Black level: " << black_level << endl;
+    cout << "White level: " << white_level << endl;
+    cout << "Gamma: " << gamma << endl;
+    cout << "Maximum value: " << max_value << endl;
+    cout << "Destination filename: " << dst_filename << endl;
+  }
+
+  clock_t startTime = clock();
+
+  cv::Mat dst = pipeline.Process(src);
+
+  clock_t endTime = clock();
+
+  if (verbose) {
+    cout << "Elapsed time: "
+         << (endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC)
+         << " [s]" << endl;
+  }
+
+  if (dst_filename.empty()) {
+    cv::imshow(src_filename + " [Rendered]", dst);
+    cv::waitKey(0);
+  } else {
+    cv::imwrite(dst_filename, dst);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@ int main(int argc, char* argv[]) {
   string dst_filename = "";
   int row_seams = 100;
   int col_seams = 100;
+  bool enlarge = false;
 
   po::options_description options("Options");
   options.add_options()("help,h", "display this message")(
@@ -27,7 +28,9 @@ int main(int argc, char* argv[]) {
       "destination-filename,o", po::value<string>(&dst_filename),
       "destination filename")("rows,r", po::value<int>(&row_seams),
       "row seams [default is 100]")("cols,c", po::value<int>(&col_seams),
-                              "column seams [default is 100]");
+                              "column seams [default is 100]")(
+      "enlarge,e", po::bool_switch(&enlarge),
+      "insert seams rather than remove them [default is remove]");
 
   po::positional_options_description positional_options;
   positional_options.add("source-filename", -1);
@@ -61,13 +64,19 @@ int main(int argc, char* argv[]) {
     cout << "Channels: " << src.channels() << endl;
     cout << "Row seams: " << row_seams << endl;
     cout << "Column seams: " << col_seams << endl;
+    cout << "Enlarge: " << (enlarge ? "yes" : "no") << endl;
     cout << "Destination filename: " << dst_filename << endl;
   }
 
   clock_t startTime = clock();
 
   cv::Mat dst;
-  dst = ipcv::SeamCarving(src, row_seams, col_seams);
+  if (enlarge) {
+    dst = ipcv::InsertSeams(src, row_seams, 'r');
+    dst = ipcv::InsertSeams(dst, col_seams, 'c');
+  } else {
+    dst = ipcv::SeamCarving(src, row_seams, col_seams);
+  }
 
   clock_t endTime = clock();
 
@@ -7,9 +7,11 @@
  */
 
 // including libraries
+#include <functional>
 #include <iostream>
 #include <vector>
-#include "imgs/numerical/sorting/Sorting.h"
+#include "imgs/numerical/sorting/ParallelSort.h"
+#include "imgs/numerical/sorting/RadixSort.h"
 
 using namespace std;
 
@@ -28,14 +30,14 @@ int main() {
   print_vector(testvect);
 
   cout << "Sorted vector (ascending) ..." << endl;
-  bool ascending = true;  // true = ascending, false = descending
-  auto ascvect =
-      Bubble(testvect, ascending);  // making a new vector and assigning the
-                                    // resulting values to it
+  // radix sorting handles any integral or floating point type in linear time
+  auto ascvect = testvect;  // making a copy so the original stays unsorted
+  numerical::RadixSort(ascvect);
   print_vector(ascvect);  // printing the new vector
 
-  cout << "Sorted vector (descending) ..." << endl;  // same stuff as above
-  ascending = false;
-  auto descvect = Bubble(testvect, ascending);
+  cout << "Sorted vector (descending) ..." << endl;
+  // any ordering works with the (parallel) merge sort
+  auto descvect = testvect;
+  numerical::ParallelSort(descvect.begin(), descvect.end(), greater<>());
   print_vector(descvect);
-}
\ No newline at end of file
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "imgs/numerical/sorting/ParallelSort.h"
+#include "imgs/numerical/sorting/RadixSort.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+namespace {
+
+/* Mean wall time of sorting a fresh copy of the keys [s] (the copy is not
+ * timed), after checking the result against std::sort
+ */
+template <typename T>
+double Time(const vector<T>& keys, const function<void(vector<T>&)>& sort,
+            int repetitions, bool& correct) {
+  vector<T> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  double total = 0;
+  vector<T> work;
+  for (int idx = 0; idx < repetitions; idx++) {
+    work = keys;
+    auto start = chrono::steady_clock::now();
+    sort(work);
+    auto end = chrono::steady_clock::now();
+    total += chrono::duration<double>(end - start).count();
+  }
+  correct = (work == expected);
+  return total / repetitions;
+}
+
+template <typename T>
+void Compare(const string& label, const vector<T>& keys, int repetitions,
+             unsigned int threads) {
+  cout << label << endl;
+  auto report = [&](const string& name,
+                    const function<void(vector<T>&)>& sort) {
+    bool correct;
+    double seconds = Time(keys, sort, repetitions, correct);
+    cout << "  " << name << ": " << seconds * 1e3 << " [ms]"
+         << (correct ? "" : " (INCORRECT)") << endl;
+  };
+
+  report("std::sort", [](vector<T>& v) { std::sort(v.begin(), v.end()); });
+  report("std::stable_sort",
+         [](vector<T>& v) { std::stable_sort(v.begin(), v.end()); });
+  report("RadixSort", [](vector<T>& v) { numerical::RadixSort(v); });
+  report("ParallelSort", [&](vector<T>& v) {
+    numerical::ParallelSort(v.begin(), v.end(), less<>(), threads);
+  });
+}
+
+/* Argsort of scores, std::sort of an index vector against the radix and
+ * parallel merge argsorts
+ */
+void CompareArgSort(const vector<float>& scores, int repetitions,
+                    unsigned int threads) {
+  cout << "Argsort, float32 scores" << endl;
+  auto report = [&](const string& name,
+                    const function<vector<uint32_t>()>& argsort) {
+    double total = 0;
+    vector<uint32_t> index;
+    for (int idx = 0; idx < repetitions; idx++) {
+      auto start = chrono::steady_clock::now();
+      index = argsort();
+      auto end = chrono::steady_clock::now();
+      total += chrono::duration<double>(end - start).count();
+    }
+    bool correct = is_sorted(index.begin(), index.end(),
+                             [&](uint32_t a, uint32_t b) {
+                               return scores[a] < scores[b];
+                             });
+    cout << "  " << name << ": " << total / repetitions * 1e3 << " [ms]"
+         << (correct ? "" : " (INCORRECT)") << endl;
+  };
+
+  report("std::sort", [&]() {
+    vector<uint32_t> index(scores.size());
+    iota(index.begin(), index.end(), 0);
+    std::sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) {
+      return scores[a] < scores[b];
+    });
+    return index;
+  });
+  report("RadixArgSort", [&]() { return numerical::RadixArgSort(scores); });
+  report("ArgSort (parallel merge)", [&]() {
+    return numerical::ArgSort(scores, less<>(), threads);
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t size = 640 * 480;
+  int repetitions = 10;
+  unsigned int threads = 0;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "size,n", po::value<size_t>(&size),
+      "keys to sort [default is 307200, one 640 x 480 frame]")(
+      "repetitions,r", po::value<int>(&repetitions),
+      "repetitions of each sort [default is 10]")(
+      "threads,t", po::value<unsigned int>(&threads),
+      "parallel merge sort threads, 0 for one per hardware thread [default "
+      "is 0]");
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(options).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if ((size < 1) || (repetitions < 1)) {
+    cerr << "Size and repetitions must be positive" << endl;
+    return EXIT_FAILURE;
+  }
+
+  mt19937 generator(0);
+  vector<uint8_t> intensities8(size);
+  vector<uint16_t> intensities16(size);
+  vector<float> scores(size);
+  uniform_int_distribution<int> byte(0, 255);
+  uniform_int_distribution<int> word(0, 65535);
+  normal_distribution<float> normal(0, 100);
+  for (size_t idx = 0; idx < size; idx++) {
+    intensities8[idx] = static_cast<uint8_t>(byte(generator));
+    intensities16[idx] = static_cast<uint16_t>(word(generator));
+    scores[idx] = normal(generator);
+  }
+
+  cout << "Size: " << size << endl;
+  cout << "Repetitions: " << repetitions << endl;
+  cout << endl;
+
+  Compare("Pixel intensities, uint8", intensities8, repetitions, threads);
+  Compare("Pixel intensities, uint16", intensities16, repetitions, threads);
+  Compare("Keypoint scores, float32", scores, repetitions, threads);
+  CompareArgSort(scores, repetitions, threads);
+
+  return EXIT_SUCCESS;
+}
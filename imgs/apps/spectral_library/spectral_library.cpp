@@ -0,0 +1,122 @@
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "imgs/color/spectrum/SpectralLibrary.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  bool verbose = false;
+  string src_filename = "";
+  string dst_filename = "";
+  size_t header_lines = 1;
+  size_t label_line = 1;
+  string data_type = "float64";
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "display this message")(
+      "verbose,v", po::bool_switch(&verbose), "verbose [default is silent]")(
+      "source-filename,i", po::value<string>(&src_filename),
+      "CSV file (wavelengths in the first column, one spectrum per remaining "
+      "column) or spectral library")(
+      "destination-filename,o", po::value<string>(&dst_filename),
+      "destination spectral library filename [default lists the source "
+      "library]")(
+      "header-lines", po::value<size_t>(&header_lines),
+      "CSV header lines [default is 1]")(
+      "label-line", po::value<size_t>(&label_line),
+      "CSV line holding the spectrum names, 0 for none [default is 1]")(
+      "data-type", po::value<string>(&data_type),
+      "stored value type float32|float64 [default is float64]");
+
+  po::positional_options_description positional_options;
+  positional_options.add("source-filename", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(options)
+                .positional(positional_options)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << "Usage: " << argv[0] << " [options] source-filename" << endl;
+    cout << options << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (!boost::filesystem::exists(src_filename)) {
+    cerr << "Provided source file does not exists" << endl;
+    return EXIT_FAILURE;
+  }
+
+  color::SpectralLibrary::Type type;
+  if (data_type == "float32") {
+    type = color::SpectralLibrary::Type::float32;
+  } else if (data_type == "float64") {
+    type = color::SpectralLibrary::Type::float64;
+  } else {
+    cerr << "Invalid data type provided: " << data_type << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!dst_filename.empty()) {
+    if (verbose) {
+      cout << "Source filename: " << src_filename << endl;
+      cout << "Destination filename: " << dst_filename << endl;
+      cout << "Data type: " << data_type << endl;
+    }
+
+    clock_t startTime = clock();
+    color::SpectralLibrary::FromCsv(src_filename, dst_filename, header_lines,
+                                    label_line, type);
+    clock_t endTime = clock();
+
+    if (verbose) {
+      cout << "Elapsed time: "
+           << (endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC)
+           << " [s]" << endl;
+    }
+  }
+
+  // List the library (the one just written, or the source)
+  string filename = dst_filename.empty() ? src_filename : dst_filename;
+  if (!color::SpectralLibrary::IsLibrary(filename)) {
+    cerr << "Provided file is not a spectral library: " << filename << endl;
+    return EXIT_FAILURE;
+  }
+
+  clock_t startTime = clock();
+  color::SpectralLibrary library(filename);
+  clock_t endTime = clock();
+
+  auto wavelengths = library.wavelengths();
+  cout << "Spectra: " << library.size() << endl;
+  cout << "Bands: " << library.bands() << endl;
+  if (library.bands() > 0) {
+    cout << "Wavelengths: " << wavelengths(0) << " - "
+         << wavelengths(library.bands() - 1) << endl;
+  }
+  cout << "Data type: "
+       << ((library.type() == color::SpectralLibrary::Type::float32)
+               ? "float32"
+               : "float64")
+       << endl;
+  if (verbose) {
+    for (size_t idx = 0; idx < library.names().size(); idx++) {
+      cout << idx << ": " << library.names()[idx] << endl;
+    }
+    cout << "Load time: "
+         << (endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC)
+         << " [s]" << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
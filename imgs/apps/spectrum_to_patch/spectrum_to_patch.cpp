@@ -1,4 +1,6 @@
 // Again, not sure how many of these includes are needed
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -93,7 +95,24 @@ int main(int argc, char* argv[]) {
       throw runtime_error("Specified file not found, exiting...");
     }
 
-    color::Spectrum steve(filename, header_lines, label_line);
+    // Binary spectral libraries can hold many spectra, one is picked by its
+    // name or index as the second argument (the first one otherwise)
+    color::Spectrum steve;
+    if (color::SpectralLibrary::IsLibrary(filename)) {
+      color::SpectralLibrary library(filename);
+      size_t index = 0;
+      if (argc > 2) {
+        std::string which = argv[2];
+        bool digits = !which.empty() &&
+                      all_of(which.begin(), which.end(), [](unsigned char ch) {
+                        return std::isdigit(ch);
+                      });
+        index = digits ? stoul(which) : library.Find(which);
+      }
+      steve = color::Spectrum(library, index);
+    } else {
+      steve = color::Spectrum(filename, header_lines, label_line);
+    }
 
     Eigen::Vector3d xyz = steve.xyz(RI, SO);
 
@@ -5,17 +5,26 @@
  *  \date 6 Apr 2021
  *  \note I'll say this again, if you've even opened this file and read this
  * code pls DM me on Discord the confirmation phrase "tomato costume"
+ *
+ *  \description
+ *    Three stage pipeline, capture (decode, L*a*b*, Laplacian pyramid) on
+ *    one thread, temporal filtering on the main thread (pyramid levels in
+ *    parallel), and encode/display on a third.  A fixed set of frame buffers
+ *    is allocated up front and only their indices travel through lock-free
+ *    single producer, single consumer rings (free -> captured -> processed
+ *    -> free), so the stages never clone or allocate per frame and capture
+ *    stalls when every buffer is in flight instead of queueing the whole
+ *    video in memory.
  */
 
-#include <iostream>
-#include <vector>
 #include <algorithm>
-#include <thread>
 #include <chrono>
-#include <list>
-#include <mutex>
-#include <regex>
-#include <condition_variable>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
@@ -23,15 +32,99 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include "imgs/ipcv/color_conversion/ColorConversion.h"
+#include "imgs/numerical/sorting/Selection.h"
+#include "imgs/utils/concurrency/SpscRing.h"
+
 using namespace std;
 
 namespace po = boost::program_options;
 
+using Clock = chrono::steady_clock;
+
+// One frame's worth of preallocated images, the rings pass its index around
+struct FrameBuffer {
+  cv::Mat frame;            // captured 8-bit BGR
+  cv::Mat lab;              // L*a*b* of the frame
+  vector<cv::Mat> pyramid;  // Laplacian levels, then the low pass residual
+  cv::Mat magnified;        // magnified L*a*b*
+  cv::Mat bgr;              // magnified 8-bit BGR
+  int index = 0;
+};
+
+// Latency [ms] and input queue depth of a pipeline stage (idle buffers for
+// capture), only ever touched by the thread running that stage
+struct StageStats {
+  explicit StageStats(const string& name) : name(name) {}
+
+  void Add(Clock::time_point start, size_t depth) {
+    double ms =
+        chrono::duration<double, milli>(Clock::now() - start).count();
+    frames++;
+    total_ms += ms;
+    max_ms = max(max_ms, ms);
+    p95_ms.Add(ms);
+    total_depth += depth;
+    max_depth = max(max_depth, depth);
+  }
+
+  void Print() const {
+    if (frames == 0) {
+      return;
+    }
+    cout << left << setw(8) << name << right << fixed << setprecision(2)
+         << " mean " << setw(8) << total_ms / frames << " ms"
+         << "  p95 " << setw(8) << p95_ms.value() << " ms"
+         << "  max " << setw(8) << max_ms << " ms"
+         << "  queue mean " << setw(5) << total_depth / frames << "  max "
+         << max_depth << endl;
+  }
+
+  string name;
+  size_t frames = 0;
+  double total_ms = 0;
+  double max_ms = 0;
+  numerical::P2Quantile p95_ms{0.95};
+  double total_depth = 0;
+  size_t max_depth = 0;
+};
+
+// Level sizes of a pyramid built by repeated cv::pyrDown
+vector<cv::Size> PyramidSizes(cv::Size size, int levels) {
+  vector<cv::Size> sizes{size};
+  for (int l = 0; l < levels; l++) {
+    size = cv::Size((size.width + 1) / 2, (size.height + 1) / 2);
+    sizes.push_back(size);
+  }
+  return sizes;
+}
+
+// Laplacian pyramid of src written into the (preallocated) levels, down and
+// up are per-level scratch images kept by the caller
+void BuildPyramid(const cv::Mat& src, vector<cv::Mat>& down,
+                  vector<cv::Mat>& up, vector<cv::Mat>& pyramid) {
+  int levels = static_cast<int>(pyramid.size()) - 1;
+  if (levels == 0) {
+    src.copyTo(pyramid[0]);
+    return;
+  }
+
+  const cv::Mat* current = &src;
+  for (int l = 0; l < levels; l++) {
+    cv::Mat& next = (l + 1 == levels) ? pyramid[levels] : down[l];
+    cv::pyrDown(*current, next);
+    cv::pyrUp(next, up[l], current->size());
+    cv::subtract(*current, up[l], pyramid[l]);
+    current = &next;
+  }
+}
+
 int main(int argc, char* argv[]) {
   bool verbose = false;
   string src_filename = "";
   string dst_filename = "null.avi";
   int pyr_levels = 5;
+  int frame_buffers = 4;
   double magnification = 10;
   double wavelength = 16;
   double h_freq = 3;
@@ -57,7 +150,9 @@ int main(int argc, char* argv[]) {
       "chrominance,c", po::value<double>(&chrominance),
       "chrominance attenuation (I and Q in YIQ color space)")(
       "oomph,o", po::value<double>(&oomph),
-      "give it a little oomph (additional magnification scaling)");
+      "give it a little oomph (additional magnification scaling)")(
+      "buffers,n", po::value<int>(&frame_buffers),
+      "frames in flight between the pipeline stages [default is 4]");
 
   po::positional_options_description positional_options;
   positional_options.add("source-filename", -1);
@@ -76,6 +171,13 @@ int main(int argc, char* argv[]) {
     return EXIT_SUCCESS;
   }
 
+  if ((pyr_levels < 0) || (frame_buffers < 1)) {
+    cerr << "Pyramid levels must be non-negative and at least one frame "
+            "buffer is needed"
+         << endl;
+    return EXIT_FAILURE;
+  }
+
   if (verbose) {
     cout << "Source filename: " << src_filename << endl;
     cout << "Magnification factor: " << magnification << endl;
@@ -84,203 +186,177 @@ int main(int argc, char* argv[]) {
     cout << "Low cutoff frequency [hz]: " << l_freq << endl;
     cout << "Chrominance attenuation: " << chrominance << endl;
     cout << "Oomph factor: " << oomph << endl;
+    cout << "Frame buffers: " << frame_buffers << endl;
   }
 
-  bool in_done = false;
-  mutex in_mutex;
-  condition_variable in_notif;
-  list<vector<cv::Mat>> in_queue;
-
-  bool out_done = false;
-  mutex out_mutex;
-  condition_variable out_notif;
-  list<tuple<cv::Mat, cv::Mat>> out_queue;
-
   cv::VideoCapture cap(src_filename);
+  if (!cap.isOpened()) {
+    cerr << "Unable to open the source video: " << src_filename << endl;
+    return EXIT_FAILURE;
+  }
   auto width = cap.get(cv::CAP_PROP_FRAME_WIDTH);
   auto height = cap.get(cv::CAP_PROP_FRAME_HEIGHT);
   auto fps = cap.get(cv::CAP_PROP_FPS);
-  cv::VideoWriter video(dst_filename,
-                        cv::VideoWriter::fourcc('X', 'V', 'I', 'D'), fps,
-                        cv::Size(width, height));
-
-  auto in_thread = thread([&]() {
-    cv::Mat frame;
-    while (true) {
-      if (!cap.read(frame)) {
-        in_done = true;
-        in_notif.notify_all();
-        return;
-      }
-
-      auto in = frame.clone();
+  bool display = (dst_filename == "null.avi");
+  cv::VideoWriter video;
+  if (!display) {
+    video.open(dst_filename, cv::VideoWriter::fourcc('X', 'V', 'I', 'D'), fps,
+               cv::Size(width, height));
+  }
 
-      in.convertTo(in, CV_32FC3, 1.0 / 255.0f);
-      cv::cvtColor(in, in, cv::COLOR_BGR2Lab);
+  // Every image the pipeline touches is allocated here, the OpenCV calls
+  // below write into them in place
+  auto sizes = PyramidSizes(cv::Size(width, height), pyr_levels);
+  vector<FrameBuffer> buffers(frame_buffers);
+  for (auto& buffer : buffers) {
+    buffer.frame.create(sizes[0], CV_8UC3);
+    buffer.lab.create(sizes[0], CV_32FC3);
+    buffer.magnified.create(sizes[0], CV_32FC3);
+    buffer.bgr.create(sizes[0], CV_8UC3);
+    for (const auto& size : sizes) {
+      buffer.pyramid.emplace_back(size, CV_32FC3);
+    }
+  }
 
-      vector<cv::Mat> pyramid;
-      {
-        auto current_frame = in;
-        for (int l = 0; l < pyr_levels; l++) {
-          cv::Mat down, up;
+  utils::SpscRing<size_t> free_ring(frame_buffers);
+  utils::SpscRing<size_t> captured_ring(frame_buffers);
+  utils::SpscRing<size_t> processed_ring(frame_buffers);
+  for (size_t slot = 0; slot < buffers.size(); slot++) {
+    free_ring.Push(slot);
+  }
 
-          pyrDown(current_frame, down);
-          pyrUp(down, up, current_frame.size());
+  StageStats capture_stats("capture");
+  StageStats process_stats("process");
+  StageStats encode_stats("encode");
 
-          pyramid.push_back(current_frame - up);
-          current_frame = down;
-        }
+  auto in_thread = thread([&]() {
+    vector<cv::Mat> down(pyr_levels);
+    vector<cv::Mat> up(pyr_levels);
+    for (int l = 0; l < pyr_levels; l++) {
+      down[l].create(sizes[l + 1], CV_32FC3);
+      up[l].create(sizes[l], CV_32FC3);
+    }
 
-        pyramid.push_back(current_frame);
-        pyramid.push_back(in);
+    int frame_idx = 0;
+    size_t slot;
+    while (free_ring.Pop(slot)) {
+      size_t depth = free_ring.size();
+      auto t_start = Clock::now();
+      auto& buffer = buffers[slot];
+      if (!cap.read(buffer.frame)) {
+        captured_ring.Close();
+        return;
       }
+      buffer.index = frame_idx++;
 
-      unique_lock<mutex> lock(in_mutex);
-      in_queue.push_back(pyramid);
-      in_notif.notify_one();
+      // Converted straight from 8-bit BGR, no normalized copy is needed
+      ipcv::BgrToLab(buffer.frame, buffer.lab);
+      BuildPyramid(buffer.lab, down, up, buffer.pyramid);
+
+      capture_stats.Add(t_start, depth);
+      captured_ring.Push(slot);
     }
   });
 
   auto out_thread = thread([&]() {
-    tuple<cv::Mat, cv::Mat> out;
-    while (true) {
-      {
-        unique_lock<mutex> lock(out_mutex);
-        out_notif.wait(
-            lock, [&]() { return out_done || !out_queue.empty(); });
-        if (out_done && out_queue.empty()) {
-          return;
-        }
-
-        out = out_queue.front();
-        out_queue.pop_front();
-      }
-
-      auto src = get<0>(out);
-      auto dst = get<1>(out);
-
-      cv::cvtColor(src, src, cv::COLOR_Lab2BGR);
-      src.convertTo(src, CV_8UC3, 255.0, 1.0 / 255.0);
-
-      cv::cvtColor(dst, dst, cv::COLOR_Lab2BGR);
-      dst.convertTo(dst, CV_8UC3, 255.0, 1.0 / 255.0);
-
-      if (dst_filename == "null.avi") {
-        cv::imshow("In", src);
-        cv::imshow("Out", dst);
+    size_t slot;
+    while (processed_ring.Pop(slot)) {
+      size_t depth = processed_ring.size();
+      auto t_start = Clock::now();
+      auto& buffer = buffers[slot];
+
+      ipcv::LabToBgr(buffer.magnified, buffer.bgr, CV_8U);
+      if (display) {
+        cv::imshow("In", buffer.frame);
+        cv::imshow("Out", buffer.bgr);
         cv::waitKey(30);
       } else {
-        video.write(dst);
+        video.write(buffer.bgr);
       }
+
+      encode_stats.Add(t_start, depth);
+      free_ring.Push(slot);
     }
-    if (dst_filename != "null.avi") {
+    if (!display) {
       video.release();
     }
   });
 
-  auto frame_idx = 0;
-  vector<cv::Mat> low_pass;
-  vector<cv::Mat> high_pass;
-  vector<cv::Mat> band_pass;
-
-  while (true) {
-    auto t_start = chrono::high_resolution_clock::now();
-
-    vector<cv::Mat> pyramid;
-    {
-      unique_lock<mutex> lock(in_mutex);
-      in_notif.wait(
-          lock, [&]() { return in_done || !in_queue.empty(); });
-      if (in_done && in_queue.empty()) {
-        unique_lock<mutex> lock(out_mutex);
-        out_done = true;
-        out_notif.notify_all();
-
-        break;
-      }
-
-      pyramid = in_queue.front();
-      in_queue.pop_front();
+  // Temporal filter state and the collapsed band pass of every level, the
+  // finest and coarsest levels are never magnified so their band pass stays
+  // zero
+  vector<cv::Mat> low_pass(pyr_levels + 1);
+  vector<cv::Mat> high_pass(pyr_levels + 1);
+  vector<cv::Mat> band_pass(pyr_levels + 1);
+  vector<cv::Mat> collapsed(pyr_levels + 1);
+  vector<double> gain(pyr_levels + 1);
+  {
+    auto delta = wavelength / 8.0 / (1.0 + magnification);
+    auto lambda = sqrt(width * width + height * height) / 3;
+    for (int l = pyr_levels; l >= 0; l--) {
+      low_pass[l].create(sizes[l], CV_32FC3);
+      high_pass[l].create(sizes[l], CV_32FC3);
+      band_pass[l] = cv::Mat::zeros(sizes[l], CV_32FC3);
+      collapsed[l].create(sizes[l], CV_32FC3);
+
+      auto current_frame_mag = (lambda / delta / 8 - 1) * oomph;
+      gain[l] = min(magnification, current_frame_mag);
+      lambda /= 2.0;
     }
+  }
 
-    cv::Mat in = pyramid[pyr_levels + 1];
-
-    if (frame_idx == 0) {
-      for (int l = 0; l < pyramid.size(); l++) {
-        band_pass.push_back(pyramid[l].clone());
-        low_pass.push_back(pyramid[l].clone());
-        high_pass.push_back(pyramid[l].clone());
+  size_t slot;
+  while (captured_ring.Pop(slot)) {
+    size_t depth = captured_ring.size();
+    auto t_start = Clock::now();
+    auto& buffer = buffers[slot];
+    const auto& pyramid = buffer.pyramid;
+
+    if (buffer.index == 0) {
+      for (int l = 0; l <= pyr_levels; l++) {
+        pyramid[l].copyTo(low_pass[l]);
+        pyramid[l].copyTo(high_pass[l]);
       }
-    }
-
-    if (frame_idx > 0) {
-      auto delta = wavelength / 8.0 / (1.0 + magnification);
-      auto lambda = sqrt((float)(width * width + height * height)) / 3;
-
-      vector<thread> workers;
-      for (int pyr_level = pyr_levels; pyr_level >= 0; pyr_level--) {
-        workers.push_back(thread([&, pyr_level, lambda]() {
-          if (pyr_level == pyr_levels || pyr_level == 0) {
-            band_pass[pyr_level] *= 0;
-            return;
+      buffer.lab.copyTo(buffer.magnified);
+    } else {
+      if (pyr_levels > 1) {
+        cv::parallel_for_(cv::Range(1, pyr_levels), [&](const cv::Range& r) {
+          for (int l = r.start; l < r.end; l++) {
+            cv::addWeighted(low_pass[l], 1 - h_freq, pyramid[l], h_freq, 0,
+                            low_pass[l]);
+            cv::addWeighted(high_pass[l], 1 - l_freq, pyramid[l], l_freq, 0,
+                            high_pass[l]);
+            cv::addWeighted(low_pass[l], gain[l], high_pass[l], -gain[l], 0,
+                            band_pass[l]);
           }
-
-          low_pass[pyr_level] =
-              (1 - h_freq) * low_pass[pyr_level] + h_freq * pyramid[pyr_level];
-          high_pass[pyr_level] =
-              (1 - l_freq) * high_pass[pyr_level] + l_freq * pyramid[pyr_level];
-          band_pass[pyr_level] = low_pass[pyr_level] - high_pass[pyr_level];
-
-          auto current_frame_mag = (lambda / delta / 8 - 1) * oomph;
-          band_pass[pyr_level] *= min(magnification, current_frame_mag);
-        }));
-
-        lambda /= 2.0;
+        });
       }
 
-      for_each(workers.begin(), workers.end(),
-                    [](thread& t) { t.join(); });
-    }
-
-    cv::Mat motion;
-    {
-      auto current_frame = band_pass[pyr_levels];
-      for (int pyr_level = pyr_levels - 1; pyr_level >= 0; --pyr_level) {
-        cv::Mat up;
-        pyrUp(current_frame, up, band_pass[pyr_level].size());
-        current_frame = up + band_pass[pyr_level];
+      cv::Mat* motion = &band_pass[pyr_levels];
+      for (int l = pyr_levels - 1; l >= 0; l--) {
+        cv::pyrUp(*motion, collapsed[l], sizes[l]);
+        collapsed[l] += band_pass[l];
+        motion = &collapsed[l];
       }
-      motion = current_frame;
-    }
 
-    if (frame_idx > 0) {
-      cv::Mat channel[3];
-      split(motion, channel);
-      channel[1] = channel[1] * chrominance;
-      channel[2] = channel[2] * chrominance;
-      cv::merge(channel, 3, motion);
-
-      motion = in + motion;
+      cv::multiply(*motion, cv::Scalar(1, chrominance, chrominance), *motion);
+      cv::add(buffer.lab, *motion, buffer.magnified);
     }
 
-    auto t_now = chrono::high_resolution_clock::now();
-    chrono::milliseconds elapsed =
-        chrono::duration_cast<chrono::milliseconds>(t_now - t_start);
-
+    process_stats.Add(t_start, depth);
     if (verbose) {
-    cout << "Frame #" << frame_idx << " processed in " << elapsed.count() << " ms :)"
-              << endl;
+      cout << "Frame #" << buffer.index << " processed in " << fixed
+           << setprecision(2)
+           << chrono::duration<double, milli>(Clock::now() - t_start).count()
+           << " ms :) (" << depth << " waiting)" << endl;
     }
 
-    frame_idx++;
-
-    unique_lock<mutex> lock(out_mutex);
-    out_queue.push_back(tuple<cv::Mat, cv::Mat>(in, motion));
-    out_notif.notify_one();
+    processed_ring.Push(slot);
   }
+  processed_ring.Close();
 
   cout << endl;
-  if (dst_filename == "null.avi") {
+  if (display) {
     cout << "Displaying..." << endl;
   } else {
     cout << "Saving..." << endl;
@@ -289,5 +365,10 @@ int main(int argc, char* argv[]) {
   in_thread.join();
   out_thread.join();
 
+  cout << endl;
+  capture_stats.Print();
+  process_stats.Print();
+  encode_stats.Print();
+
   return EXIT_SUCCESS;
 }
@@ -3,14 +3,41 @@
  * \file imgs/color/cie/CIE.h
  * \author Carl Salvaggio, Ph.D. (salvaggio@cis.rit.edu)
  * \date 21 February 2020
+ *
+ * \description
+ *   The CIE reference illuminants and standard observers tabulated at 1 nm
+ *   from 360 to 830 nm.  The tables are static constexpr arrays, so neither
+ *   startup nor constructing a CIE object initializes anything, and the
+ *   getters return read-only Eigen::Map views of them (no copies).  Coarser
+ *   resampled variants (e.g. the standard 5 nm and 10 nm tables) are strided
+ *   views of every interval-th 1 nm sample, which are the tabulated values
+ *   at those wavelengths.
  */
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
 #include <eigen3/Eigen/Dense>
 
 namespace color {
 
+namespace detail {
+
+/* Wavelengths [nm] at 1 nm spacing starting at first
+ */
+template <std::size_t N>
+constexpr std::array<double, N> CieWavelengths(double first) {
+  std::array<double, N> wavelengths{};
+  for (std::size_t idx = 0; idx < N; idx++) {
+    wavelengths[idx] = first + idx;
+  }
+  return wavelengths;
+}
+}  // namespace detail
+
 class CIE {
  public:
   /* CIE refererence illuminant enumeration
@@ -21,564 +48,660 @@ class CIE {
   */
   enum StandardObserver { two_deg = 0, ten_deg = 1 };
 
-  /* Constructor
+  /* Read-only views of the tables
   */
-  CIE() {
-    // CIE REFERENCE ILLUMINANT DATA
-    reference_illuminant_a_ << 6.14462, 6.29955, 6.45724, 6.61774, 6.78105,
-        6.9472, 7.11621, 7.28811, 7.46292, 7.64066, 7.82135, 8.00501, 8.19167,
-        8.38134, 8.57404, 8.7698, 8.96864, 9.17056, 9.37561, 9.58378, 9.7951,
-        10.0096, 10.2273, 10.4481, 10.6722, 10.8996, 11.1302, 11.364, 11.6012,
-        11.8416, 12.0853, 12.3324, 12.5828, 12.8366, 13.0938, 13.3543, 13.6182,
-        13.8855, 14.1563, 14.4304, 14.708, 14.9891, 15.2736, 15.5616, 15.853,
-        16.148, 16.4464, 16.7484, 17.0538, 17.3628, 17.6753, 17.9913, 18.3108,
-        18.6339, 18.9605, 19.2907, 19.6244, 19.9617, 20.3026, 20.647, 20.995,
-        21.3465, 21.7016, 22.0603, 22.4225, 22.7883, 23.1577, 23.5307, 23.9072,
-        24.2873, 24.6709, 25.0581, 25.4489, 25.8432, 26.2411, 26.6425, 27.0475,
-        27.456, 27.8681, 28.2836, 28.7027, 29.1253, 29.5515, 29.9811, 30.4142,
-        30.8508, 31.2909, 31.7345, 32.1815, 32.632, 33.0859, 33.5432, 34.004,
-        34.4682, 34.9358, 35.4068, 35.8811, 36.3588, 36.8399, 37.3243, 37.8121,
-        38.3031, 38.7975, 39.2951, 39.796, 40.3002, 40.8076, 41.3182, 41.832,
-        42.3491, 42.8693, 43.3926, 43.9192, 44.4488, 44.9816, 45.5174, 46.0563,
-        46.5983, 47.1433, 47.6913, 48.2423, 48.7963, 49.3533, 49.9132, 50.476,
-        51.0418, 51.6104, 52.1818, 52.7561, 53.3332, 53.9132, 54.4958, 55.0813,
-        55.6694, 56.2603, 56.8539, 57.4501, 58.0489, 58.6504, 59.2545, 59.8611,
-        60.4703, 61.082, 61.6962, 62.3128, 62.932, 63.5535, 64.1775, 64.8038,
-        65.4325, 66.0635, 66.6968, 67.3324, 67.9702, 68.6102, 69.2525, 69.8969,
-        70.5435, 71.1922, 71.843, 72.4959, 73.1508, 73.8077, 74.4666, 75.1275,
-        75.7903, 76.4551, 77.1217, 77.7902, 78.4605, 79.1326, 79.8065, 80.4821,
-        81.1595, 81.8386, 82.5193, 83.2017, 83.8856, 84.5712, 85.2584, 85.947,
-        86.6372, 87.3288, 88.0219, 88.7165, 89.4124, 90.1097, 90.8083, 91.5082,
-        92.2095, 92.912, 93.6157, 94.3206, 95.0267, 95.7339, 96.4423, 97.1518,
-        97.8623, 98.5739, 99.2864, 100, 100.715, 101.43, 102.146, 102.864,
-        103.582, 104.301, 105.02, 105.741, 106.462, 107.184, 107.906, 108.63,
-        109.354, 110.078, 110.803, 111.529, 112.255, 112.982, 113.709, 114.436,
-        115.164, 115.893, 116.622, 117.351, 118.08, 118.81, 119.54, 120.27,
-        121.001, 121.731, 122.462, 123.193, 123.924, 124.655, 125.386, 126.118,
-        126.849, 127.58, 128.312, 129.043, 129.774, 130.505, 131.236, 131.966,
-        132.697, 133.427, 134.157, 134.887, 135.617, 136.346, 137.075, 137.804,
-        138.532, 139.26, 139.988, 140.715, 141.441, 142.167, 142.89, 143.618,
-        144.343, 145.067, 145.79, 146.513, 147.235, 147.957, 148.678, 149.398,
-        150.117, 150.836, 151.554, 152.271, 152.988, 153.704, 154.418, 155.132,
-        155.845, 156.558, 157.269, 157.979, 158.689, 159.397, 160.104, 160.811,
-        161.516, 162.221, 162.924, 163.626, 164.327, 165.028, 165.726, 166.424,
-        167.121, 167.816, 168.51, 169.203, 169.895, 170.586, 171.275, 171.963,
-        172.65, 173.335, 174.019, 174.702, 175.383, 176.063, 176.741, 177.419,
-        178.094, 178.769, 179.441, 180.113, 180.783, 181.451, 182.118, 182.783,
-        183.447, 184.109, 184.77, 185.429, 186.087, 186.743, 187.397, 188.05,
-        188.701, 189.35, 189.998, 190.644, 191.288, 191.931, 192.572, 193.211,
-        193.849, 194.484, 195.118, 195.75, 196.381, 197.009, 197.636, 198.261,
-        198.884, 199.506, 200.125, 200.743, 201.359, 201.972, 202.584, 203.195,
-        203.803, 204.409, 205.013, 205.616, 206.216, 206.815, 207.411, 208.006,
-        208.599, 209.189, 209.778, 210.365, 210.949, 211.532, 212.112, 212.691,
-        213.268, 213.842, 214.415, 214.985, 215.553, 216.12, 216.684, 217.246,
-        217.806, 218.364, 218.92, 219.473, 220.025, 220.574, 221.122, 221.667,
-        222.21, 222.751, 223.29, 223.826, 224.361, 224.893, 225.423, 225.951,
-        226.477, 227, 227.522, 228.041, 228.558, 229.073, 229.585, 230.096,
-        230.604, 231.11, 231.614, 232.115, 232.615, 233.112, 233.606, 234.099,
-        234.589, 235.078, 235.564, 236.047, 236.529, 237.008, 237.485, 237.959,
-        238.432, 238.902, 239.37, 239.836, 240.299, 240.76, 241.219, 241.675,
-        242.13, 242.582, 243.031, 243.479, 243.924, 244.367, 244.808, 245.246,
-        245.682, 246.116, 246.548, 246.977, 247.404, 247.829, 248.251, 248.671,
-        249.089, 249.505, 249.918, 250.329, 250.738, 251.144, 251.548, 251.95,
-        252.35, 252.747, 253.142, 253.535, 253.925, 254.314, 254.7, 255.083,
-        255.465, 255.844, 256.221, 256.595, 256.968, 257.338, 257.706, 258.071,
-        258.434, 258.795, 259.154, 259.511, 259.865, 260.217, 260.567, 260.914,
-        261.259, 261.602;
-    reference_illuminant_.col(ReferenceIlluminant::a) = 
-        reference_illuminant_a_;
+  using VectorView =
+      Eigen::Map<const Eigen::VectorXd, 0, Eigen::InnerStride<>>;
+  using MatrixView =
+      Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 3>, 0,
+                 Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
 
-    reference_illuminant_d65_ << 46.6383, 47.1834, 47.7285, 48.2735, 48.8186,
-        49.3637, 49.9088, 50.4539, 50.9989, 51.544, 52.0891, 51.8777, 51.6664,
-        51.455, 51.2437, 51.0323, 50.8209, 50.6096, 50.3982, 50.1869, 49.9755,
-        50.4428, 50.91, 51.3773, 51.8446, 52.3118, 52.7791, 53.2464, 53.7137,
-        54.1809, 54.6482, 57.4589, 60.2695, 63.0802, 65.8909, 68.7015, 71.5122,
-        74.3229, 77.1336, 79.9442, 82.7549, 83.628, 84.5011, 85.3742, 86.2473,
-        87.1204, 87.9936, 88.8667, 89.7398, 90.6129, 91.486, 91.6806, 91.8752,
-        92.0697, 92.2643, 92.4589, 92.6535, 92.8481, 93.0426, 93.2372, 93.4318,
-        92.7568, 92.0819, 91.4069, 90.732, 90.057, 89.3821, 88.7071, 88.0322,
-        87.3572, 86.6823, 88.5006, 90.3188, 92.1371, 93.9554, 95.7736, 97.5919,
-        99.4102, 101.228, 103.047, 104.865, 106.079, 107.294, 108.508, 109.722,
-        110.936, 112.151, 113.365, 114.579, 115.794, 117.008, 117.088, 117.169,
-        117.249, 117.33, 117.41, 117.49, 117.571, 117.651, 117.732, 117.812,
-        117.517, 117.222, 116.927, 116.632, 116.336, 116.041, 115.746, 115.451,
-        115.156, 114.861, 114.967, 115.073, 115.18, 115.286, 115.392, 115.498,
-        115.604, 115.711, 115.817, 115.923, 115.212, 114.501, 113.789, 113.078,
-        112.367, 111.656, 110.945, 110.233, 109.522, 108.811, 108.865, 108.92,
-        108.974, 109.028, 109.082, 109.137, 109.191, 109.245, 109.3, 109.354,
-        109.199, 109.044, 108.888, 108.733, 108.578, 108.423, 108.268, 108.112,
-        107.957, 107.802, 107.501, 107.2, 106.898, 106.597, 106.296, 105.995,
-        105.694, 105.392, 105.091, 104.79, 105.08, 105.37, 105.66, 105.95,
-        106.239, 106.529, 106.819, 107.109, 107.399, 107.689, 107.361, 107.032,
-        106.704, 106.375, 106.047, 105.719, 105.39, 105.062, 104.733, 104.405,
-        104.369, 104.333, 104.297, 104.261, 104.225, 104.19, 104.154, 104.118,
-        104.082, 104.046, 103.641, 103.237, 102.832, 102.428, 102.023, 101.618,
-        101.214, 100.809, 100.405, 100, 99.6334, 99.2668, 98.9003, 98.5337,
-        98.1671, 97.8005, 97.4339, 97.0674, 96.7008, 96.3342, 96.2796, 96.225,
-        96.1703, 96.1157, 96.0611, 96.0065, 95.9519, 95.8972, 95.8426, 95.788,
-        95.0778, 94.3675, 93.6573, 92.947, 92.2368, 91.5266, 90.8163, 90.1061,
-        89.3958, 88.6856, 88.8177, 88.9497, 89.0818, 89.2138, 89.3459, 89.478,
-        89.61, 89.7421, 89.8741, 90.0062, 89.9655, 89.9248, 89.8841, 89.8434,
-        89.8026, 89.7619, 89.721, 89.6805, 89.6398, 89.5991, 89.4091, 89.219,
-        89.029, 88.8389, 88.6489, 88.4589, 88.2688, 88.0788, 87.8887, 87.6987,
-        87.2577, 86.8167, 86.3757, 85.9347, 85.4936, 85.0526, 84.6116, 84.1706,
-        83.7296, 83.2886, 83.3297, 83.3707, 83.4118, 83.4528, 83.4939, 83.535,
-        83.576, 83.6171, 83.6581, 83.6992, 83.332, 82.9647, 82.5975, 82.2302,
-        81.863, 81.4958, 81.1285, 80.7613, 80.394, 80.0268, 80.0456, 80.0644,
-        80.0831, 80.1019, 80.1207, 80.1395, 80.1583, 80.177, 80.1958, 80.2146,
-        80.4209, 80.6272, 80.8336, 81.0399, 81.2462, 81.4525, 81.6588, 81.8652,
-        82.0715, 82.2778, 81.8784, 81.4791, 81.0797, 80.6804, 80.281, 79.8816,
-        79.4823, 79.0829, 78.6836, 78.2842, 77.4279, 76.5716, 75.7153, 74.859,
-        74.0027, 73.1465, 72.2902, 71.4339, 70.5776, 69.7213, 69.9101, 70.0989,
-        70.2876, 70.4764, 70.6652, 70.854, 71.0428, 71.2315, 71.4203, 71.6091,
-        71.8831, 72.1571, 72.4311, 72.7051, 72.979, 73.253, 73.527, 73.801,
-        74.075, 74.349, 73.0745, 71.8, 70.5255, 69.251, 67.9765, 66.702,
-        65.4275, 64.153, 62.8785, 61.604, 62.4322, 63.2603, 64.0885, 64.9166,
-        65.7448, 66.573, 67.4011, 68.2293, 69.0574, 69.8856, 70.4057, 70.9259,
-        71.446, 71.9662, 72.4863, 73.0064, 73.5266, 74.0467, 74.5669, 75.087,
-        73.9376, 72.7881, 71.6387, 70.4893, 69.3398, 68.1904, 67.041, 65.8916,
-        64.7421, 63.5927, 61.8752, 60.1578, 58.4403, 56.7229, 55.0054, 53.288,
-        51.5705, 49.8531, 48.1356, 46.4182, 48.4569, 50.4956, 52.5344, 54.5731,
-        56.6118, 58.6505, 60.6892, 62.728, 64.7667, 66.8054, 66.4631, 66.1209,
-        65.7786, 65.4364, 65.0941, 64.7518, 64.4096, 64.0673, 63.7251, 63.3828,
-        63.4749, 63.567, 63.6592, 63.7513, 63.8434, 63.9355, 64.0276, 64.1198,
-        64.2119, 64.304, 63.8188, 63.3336, 62.8484, 62.3632, 61.8779, 61.3927,
-        60.9075, 60.4223, 59.9371, 59.4519, 58.7026, 57.9533, 57.204, 56.4547,
-        55.7054, 54.9562, 54.2069, 53.4576, 52.7083, 51.959, 52.5072, 53.0553,
-        53.6035, 54.1516, 54.6998, 55.248, 55.7961, 56.3443, 56.8924, 57.4406,
-        57.7278, 58.015, 58.3022, 58.5894, 58.8765, 59.1637, 59.4509, 59.7381,
-        60.0253, 60.3125;
-    reference_illuminant_.col(ReferenceIlluminant::d65) =
-        reference_illuminant_d65_;
+  /* Tabulated wavelength range [nm] and number of 1 nm samples
+  */
+  static constexpr int kFirstWavelength = 360;
+  static constexpr int kLastWavelength = 830;
+  static constexpr int kSamples = kLastWavelength - kFirstWavelength + 1;
 
-    // CIE STANDARD OBSERVER DATA
-    // CIE 1931 2-degree Standard Observer (x-bar)
-    // CIE 1931 2-degree Standard Observer (y-bar)
-    // CIE 1931 2-degree Standard Observer (z-bar)
-    // CIE 1964 10-degree Standard Observer (x-bar)
-    // CIE 1964 10-degree Standard Observer (y-bar)
-    // CIE 1964 10-degree Standard Observer (z-bar)
-    standard_observer_ << 0.0001299, 3.92E-06, 0.0006061, 0.000000122,
-        0.000000013, 0.000000535, 0.0001458, 4.39E-06, 0.0006809, 0.000000185,
-        0.00000002, 0.000000811, 0.0001638, 4.93E-06, 0.0007651, 0.000000279,
-        0.000000031, 0.000001221, 0.000184, 5.53E-06, 0.00086, 0.000000417,
-        0.000000046, 0.000001829, 0.0002067, 6.21E-06, 0.0009666, 0.000000621,
-        0.000000068, 0.000002722, 0.0002321, 6.97E-06, 0.001086, 0.000000919,
-        0.000000101, 0.000004028, 0.0002607, 7.81E-06, 0.0012206, 0.000001352,
-        0.000000148, 0.000005926, 0.0002931, 8.77E-06, 0.0013727, 0.000001977,
-        0.000000216, 0.000008665, 0.0003294, 9.84E-06, 0.0015436, 0.000002872,
-        0.000000314, 0.000012596, 0.0003699, 1.10E-05, 0.0017343, 0.00000415,
-        0.000000454, 0.000018201, 0.0004149, 1.24E-05, 0.001946, 0.000005959,
-        0.000000651, 0.000026144, 0.0004642, 1.39E-05, 0.0021778, 0.000008506,
-        0.000000929, 0.00003733, 0.000519, 1.56E-05, 0.0024358, 0.000012069,
-        0.000001318, 0.000052987, 0.0005819, 1.74E-05, 0.002732, 0.000017023,
-        0.000001857, 0.000074764, 0.0006552, 1.96E-05, 0.0030781, 0.000023868,
-        0.000002602, 0.00010487, 0.0007416, 2.20E-05, 0.003486, 0.000033266,
-        0.000003625, 0.00014622, 0.000845, 2.48E-05, 0.0039752, 0.000046087,
-        0.000005019, 0.00020266, 0.0009645, 2.80E-05, 0.0045409, 0.000063472,
-        0.000006907, 0.00027923, 0.0010949, 3.15E-05, 0.0051583, 0.000086892,
-        0.000009449, 0.00038245, 0.0012312, 3.52E-05, 0.0058029, 0.000118246,
-        0.000012848, 0.00052072, 0.001368, 0.000039, 0.00645, 0.000159952,
-        0.000017364, 0.000704776, 0.0015021, 4.28E-05, 0.0070832, 0.00021508,
-        0.000023327, 0.00094823, 0.0016423, 4.69E-05, 0.0077455, 0.00028749,
-        0.00003115, 0.0012682, 0.0018024, 5.16E-05, 0.0085012, 0.00038199,
-        0.00004135, 0.0016861, 0.0019958, 5.72E-05, 0.0094145, 0.00050455,
-        0.00005456, 0.0022285, 0.002236, 0.000064, 0.01055, 0.00066244,
-        0.00007156, 0.0029278, 0.0025354, 7.23E-05, 0.0119658, 0.0008645,
-        0.0000933, 0.0038237, 0.0028926, 8.22E-05, 0.0136559, 0.0011215,
-        0.00012087, 0.0049642, 0.0033008, 9.35E-05, 0.0155881, 0.00144616,
-        0.00015564, 0.0064067, 0.0037532, 0.0001061, 0.0177302, 0.00185359,
-        0.0001992, 0.0082193, 0.004243, 0.00012, 0.02005, 0.0023616, 0.0002534,
-        0.0104822, 0.0047624, 0.000135, 0.0225114, 0.0029906, 0.0003202,
-        0.013289, 0.00533, 0.0001515, 0.0252029, 0.0037645, 0.0004024, 0.016747,
-        0.0059787, 0.0001702, 0.0282797, 0.0047102, 0.0005023, 0.02098,
-        0.0067411, 0.0001918, 0.031897, 0.0058581, 0.0006232, 0.026127, 0.00765,
-        0.000217, 0.03621, 0.0072423, 0.0007685, 0.032344, 0.0087514, 0.0002469,
-        0.0414377, 0.0088996, 0.0009417, 0.039802, 0.0100289, 0.0002812,
-        0.0475037, 0.0108709, 0.0011478, 0.048691, 0.0114217, 0.0003185,
-        0.0541199, 0.0131989, 0.0013903, 0.05921, 0.012869, 0.0003573, 0.060998,
-        0.0159292, 0.001674, 0.071576, 0.01431, 0.000396, 0.06785, 0.0191097,
-        0.0020044, 0.0860109, 0.0157044, 0.0004337, 0.0744863, 0.022788,
-        0.002386, 0.10274, 0.0171474, 0.000473, 0.0813616, 0.027011, 0.002822,
-        0.122, 0.0187812, 0.0005179, 0.0891536, 0.031829, 0.003319, 0.14402,
-        0.020748, 0.0005722, 0.0985405, 0.037278, 0.00388, 0.16899, 0.02319,
-        0.00064, 0.1102, 0.0434, 0.004509, 0.19712, 0.0262074, 0.0007246,
-        0.1246133, 0.050223, 0.005209, 0.22857, 0.0297825, 0.0008255, 0.1417017,
-        0.057764, 0.005985, 0.26347, 0.0338809, 0.0009412, 0.1613035, 0.066038,
-        0.006833, 0.3019, 0.0384682, 0.0010699, 0.1832568, 0.075033, 0.007757,
-        0.34387, 0.04351, 0.00121, 0.2074, 0.084736, 0.008756, 0.389366,
-        0.0489956, 0.0013621, 0.2336921, 0.095041, 0.009816, 0.43797, 0.0550226,
-        0.0015308, 0.2626114, 0.105836, 0.010918, 0.48922, 0.0617188, 0.0017204,
-        0.2947746, 0.117066, 0.012058, 0.5429, 0.069212, 0.0019353, 0.3307985,
-        0.128682, 0.013237, 0.59881, 0.07763, 0.00218, 0.3713, 0.140638,
-        0.014456, 0.65676, 0.0869581, 0.0024548, 0.4162091, 0.152893, 0.015717,
-        0.71658, 0.0971767, 0.002764, 0.4654642, 0.165416, 0.017025, 0.77812,
-        0.1084063, 0.0031178, 0.5196948, 0.178191, 0.018399, 0.84131, 0.1207672,
-        0.0035264, 0.5795303, 0.191214, 0.019848, 0.90611, 0.13438, 0.004,
-        0.6456, 0.204492, 0.021391, 0.972542, 0.1493582, 0.0045462, 0.7184838,
-        0.21765, 0.022992, 1.039, 0.1653957, 0.0051593, 0.7967133, 0.230267,
-        0.024598, 1.103, 0.1819831, 0.0058293, 0.8778459, 0.242311, 0.026213,
-        1.165, 0.198611, 0.0065462, 0.959439, 0.253793, 0.027841, 1.225,
-        0.21477, 0.0073, 1.0390501, 0.264737, 0.029497, 1.282, 0.2301868,
-        0.0080865, 1.1153673, 0.275195, 0.031195, 1.338, 0.2448797, 0.0089087,
-        1.1884971, 0.285301, 0.032927, 1.393, 0.2587773, 0.0097677, 1.2581233,
-        0.295143, 0.034738, 1.446, 0.2718079, 0.0106644, 1.3239296, 0.304869,
-        0.036654, 1.499, 0.2839, 0.0116, 1.3856, 0.314679, 0.038676, 1.553,
-        0.2949438, 0.0125732, 1.4426352, 0.324355, 0.040792, 1.607, 0.3048965,
-        0.0135827, 1.4948035, 0.33357, 0.042946, 1.659, 0.3137873, 0.0146297,
-        1.5421903, 0.342243, 0.045114, 1.708, 0.3216454, 0.0157151, 1.5848807,
-        0.350312, 0.047333, 1.755, 0.3285, 0.01684, 1.62296, 0.357719, 0.049602,
-        1.798, 0.3343513, 0.0180074, 1.6564048, 0.364482, 0.051934, 1.839,
-        0.3392101, 0.0192145, 1.6852959, 0.370493, 0.054337, 1.877, 0.3431213,
-        0.0204539, 1.7098745, 0.375727, 0.056822, 1.91, 0.3461296, 0.0217182,
-        1.7303821, 0.380158, 0.059399, 1.941, 0.34828, 0.023, 1.74706, 0.383734,
-        0.062077, 1.967, 0.3495999, 0.0242946, 1.7600446, 0.386327, 0.064737,
-        1.989, 0.3501474, 0.0256102, 1.7696233, 0.387858, 0.067285, 2.006,
-        0.350013, 0.0269586, 1.7762637, 0.388396, 0.069764, 2.017, 0.349287,
-        0.0283513, 1.7804334, 0.387978, 0.072218, 2.024, 0.34806, 0.0298,
-        1.7826, 0.386726, 0.074704, 2.027, 0.3463733, 0.0313108, 1.7829682,
-        0.384696, 0.077272, 2.026, 0.3442624, 0.0328837, 1.7816998, 0.382006,
-        0.079979, 2.022, 0.3418088, 0.0345211, 1.7791982, 0.378709, 0.082874,
-        2.015, 0.3390941, 0.0362257, 1.7758671, 0.374915, 0.086, 2.006, 0.3362,
-        0.038, 1.77211, 0.370702, 0.089456, 1.995, 0.3331977, 0.0398467,
-        1.7682589, 0.366089, 0.092947, 1.981, 0.3300411, 0.041768, 1.764039,
-        0.361045, 0.096275, 1.965, 0.3266357, 0.043766, 1.7589438, 0.355518,
-        0.099535, 1.946, 0.3228868, 0.0458427, 1.7524663, 0.349486, 0.102829,
-        1.925, 0.3187, 0.048, 1.7441, 0.342957, 0.106256, 1.901, 0.3140251,
-        0.0502437, 1.7335595, 0.335893, 0.109901, 1.874, 0.308884, 0.052573,
-        1.7208581, 0.328284, 0.113835, 1.845, 0.3032904, 0.0549806, 1.7059369,
-        0.32015, 0.118167, 1.814, 0.2972579, 0.0574587, 1.6887372, 0.311475,
-        0.122932, 1.781, 0.2908, 0.06, 1.6692, 0.302273, 0.128201, 1.745,
-        0.2839701, 0.062602, 1.6475287, 0.292858, 0.133457, 1.709, 0.2767214,
-        0.0652775, 1.6234127, 0.283502, 0.138323, 1.672, 0.2689178, 0.0680421,
-        1.5960223, 0.274044, 0.143042, 1.635, 0.2604227, 0.0709111, 1.564528,
-        0.264263, 0.147787, 1.596, 0.2511, 0.0739, 1.5281, 0.254085, 0.152761,
-        1.555, 0.2408475, 0.077016, 1.4861114, 0.243392, 0.158102, 1.512,
-        0.2298512, 0.0802664, 1.4395215, 0.232187, 0.163941, 1.467, 0.2184072,
-        0.0836668, 1.3898799, 0.220488, 0.170362, 1.42, 0.2068115, 0.0872328,
-        1.3387362, 0.208198, 0.177425, 1.37, 0.19536, 0.09098, 1.28764,
-        0.195618, 0.18519, 1.318, 0.1842136, 0.0949176, 1.2374223, 0.183034,
-        0.193025, 1.262, 0.1733273, 0.0990458, 1.1878243, 0.170222, 0.200313,
-        1.205, 0.1626881, 0.1033674, 1.1387611, 0.157348, 0.207156, 1.147,
-        0.1522833, 0.1078846, 1.090148, 0.14465, 0.213644, 1.088, 0.1421,
-        0.1126, 1.0419, 0.132349, 0.21994, 1.03, 0.1321786, 0.117532, 0.9941976,
-        0.120584, 0.22617, 0.97383, 0.1225696, 0.1226744, 0.9473473, 0.109456,
-        0.232467, 0.91943, 0.1132752, 0.1279928, 0.9014531, 0.099042, 0.239025,
-        0.86746, 0.1042979, 0.1334528, 0.8566193, 0.089388, 0.245997, 0.81828,
-        0.09564, 0.13902, 0.8129501, 0.080507, 0.253589, 0.772125, 0.0872996,
-        0.1446764, 0.7705173, 0.072034, 0.261876, 0.72829, 0.079308, 0.1504693,
-        0.7294448, 0.06371, 0.270643, 0.68604, 0.0717178, 0.1564619, 0.6899136,
-        0.055694, 0.279645, 0.64553, 0.064581, 0.1627177, 0.6521049, 0.048117,
-        0.288694, 0.60685, 0.05795, 0.1693, 0.6162, 0.041072, 0.297665, 0.57006,
-        0.0518621, 0.1762431, 0.5823286, 0.034642, 0.306469, 0.53522, 0.0462815,
-        0.1835581, 0.5504162, 0.028896, 0.315035, 0.50234, 0.0411509, 0.1912735,
-        0.5203376, 0.023876, 0.323335, 0.4714, 0.0364128, 0.199418, 0.4919673,
-        0.019628, 0.331366, 0.44239, 0.03201, 0.20802, 0.46518, 0.016172,
-        0.339133, 0.415254, 0.0279172, 0.2171199, 0.4399246, 0.0133, 0.34786,
-        0.390024, 0.0241444, 0.2267345, 0.4161836, 0.010759, 0.358326, 0.366399,
-        0.020687, 0.2368571, 0.3938822, 0.008542, 0.370001, 0.344015, 0.0175404,
-        0.2474812, 0.3729459, 0.006661, 0.382464, 0.322689, 0.0147, 0.2586,
-        0.3533, 0.005132, 0.395379, 0.302356, 0.0121618, 0.2701849, 0.3348578,
-        0.003982, 0.408482, 0.283036, 0.00992, 0.2822939, 0.3175521, 0.003239,
-        0.421588, 0.264816, 0.0079672, 0.2950505, 0.3013375, 0.002934, 0.434619,
-        0.247848, 0.0062963, 0.308578, 0.2861686, 0.003114, 0.447601, 0.232318,
-        0.0049, 0.323, 0.272, 0.003816, 0.460777, 0.218502, 0.0037772,
-        0.3384021, 0.2588171, 0.005095, 0.47434, 0.205851, 0.0029453, 0.3546858,
-        0.2464838, 0.006936, 0.4882, 0.193596, 0.0024249, 0.3716986, 0.2347718,
-        0.009299, 0.50234, 0.181736, 0.0022363, 0.3892875, 0.2234533, 0.012147,
-        0.51674, 0.170281, 0.0024, 0.4073, 0.2123, 0.015444, 0.53136, 0.159249,
-        0.0029255, 0.4256299, 0.2011692, 0.019156, 0.54619, 0.148673, 0.0038366,
-        0.4443096, 0.1901196, 0.02325, 0.56118, 0.138609, 0.0051748, 0.4633944,
-        0.1792254, 0.02769, 0.57629, 0.129096, 0.0069821, 0.4829395, 0.1685608,
-        0.032444, 0.5915, 0.120215, 0.0093, 0.503, 0.1582, 0.037465, 0.606741,
-        0.112044, 0.0121495, 0.5235693, 0.1481383, 0.042956, 0.62215, 0.10471,
-        0.0155359, 0.544512, 0.1383758, 0.049114, 0.63783, 0.098196, 0.0194775,
-        0.56569, 0.1289942, 0.05592, 0.65371, 0.092361, 0.0239928, 0.5869653,
-        0.1200751, 0.063349, 0.66968, 0.087088, 0.0291, 0.6082, 0.1117,
-        0.071358, 0.68566, 0.082248, 0.0348149, 0.6293456, 0.1039048, 0.079901,
-        0.70155, 0.077744, 0.0411202, 0.6503068, 0.0966675, 0.088909, 0.71723,
-        0.073456, 0.047985, 0.6708752, 0.0899827, 0.098293, 0.73257, 0.069268,
-        0.0553786, 0.6908424, 0.0838453, 0.107949, 0.74746, 0.06506, 0.06327,
-        0.71, 0.07825, 0.117749, 0.761757, 0.060709, 0.071635, 0.7281852,
-        0.073209, 0.127839, 0.77534, 0.056457, 0.0804622, 0.7454636, 0.0686782,
-        0.13845, 0.78822, 0.052609, 0.08974, 0.7619694, 0.0645678, 0.149516,
-        0.80046, 0.049122, 0.0994565, 0.7778368, 0.0607884, 0.161041, 0.81214,
-        0.045954, 0.1096, 0.7932, 0.05725, 0.172953, 0.82333, 0.04305,
-        0.1201674, 0.8081104, 0.0539044, 0.185209, 0.83412, 0.040368, 0.1311145,
-        0.8224962, 0.0507466, 0.197755, 0.8446, 0.037839, 0.1423679, 0.8363068,
-        0.0477528, 0.210538, 0.85487, 0.035384, 0.1538542, 0.8494916, 0.0448986,
-        0.22346, 0.86504, 0.032949, 0.1655, 0.862, 0.04216, 0.236491, 0.875211,
-        0.030451, 0.1772571, 0.8738108, 0.0395073, 0.249633, 0.88537, 0.028029,
-        0.18914, 0.8849624, 0.0369356, 0.262972, 0.89537, 0.025862, 0.2011694,
-        0.8954936, 0.0344584, 0.276515, 0.90515, 0.02392, 0.2133658, 0.9054432,
-        0.0320887, 0.290269, 0.91465, 0.022174, 0.2257499, 0.9148501, 0.02984,
-        0.304213, 0.92381, 0.020584, 0.2383209, 0.9237348, 0.0277118, 0.318361,
-        0.93255, 0.019127, 0.2510668, 0.9320924, 0.0256944, 0.332705, 0.94081,
-        0.01774, 0.2639922, 0.9399226, 0.0237872, 0.347232, 0.94852, 0.016403,
-        0.2771017, 0.9472252, 0.0219893, 0.361926, 0.9556, 0.015064, 0.2904,
-        0.954, 0.0203, 0.376772, 0.961988, 0.013676, 0.3038912, 0.9602561,
-        0.0187181, 0.391683, 0.96754, 0.012308, 0.3175726, 0.9660074, 0.0172404,
-        0.406594, 0.97223, 0.011056, 0.3314384, 0.9712606, 0.0158636, 0.421539,
-        0.97617, 0.009915, 0.3454828, 0.9760225, 0.0145846, 0.436517, 0.97946,
-        0.008872, 0.3597, 0.9803, 0.0134, 0.451584, 0.9822, 0.007918, 0.3740839,
-        0.9840924, 0.0123072, 0.466782, 0.98452, 0.00703, 0.3886396, 0.9874182,
-        0.0113019, 0.482147, 0.98652, 0.006223, 0.4033784, 0.9903128, 0.0103779,
-        0.497738, 0.98832, 0.005453, 0.4183115, 0.9928116, 0.0095293, 0.513606,
-        0.99002, 0.004714, 0.4334499, 0.9949501, 0.00875, 0.529826, 0.991761,
-        0.003988, 0.4487953, 0.9967108, 0.0080352, 0.54644, 0.99353, 0.003289,
-        0.464336, 0.9980983, 0.0073816, 0.563426, 0.99523, 0.002646, 0.480064,
-        0.999112, 0.0067854, 0.580726, 0.99677, 0.002063, 0.4959713, 0.9997482,
-        0.0062428, 0.59829, 0.99809, 0.001533, 0.5120501, 1, 0.00575, 0.616053,
-        0.99911, 0.001091, 0.5282959, 0.9998567, 0.0053036, 0.633948, 0.99977,
-        0.000711, 0.5446916, 0.9993046, 0.0048998, 0.651901, 1, 0.000407,
-        0.5612094, 0.9983255, 0.0045342, 0.669824, 0.99971, 0.000184, 0.5778215,
-        0.9968987, 0.0042024, 0.687632, 0.99885, 0.000047, 0.5945, 0.995,
-        0.0039, 0.705224, 0.99734, 0, 0.6112209, 0.9926005, 0.0036232, 0.722773,
-        0.99526, 0, 0.6279758, 0.9897426, 0.0033706, 0.740483, 0.99274, 0,
-        0.6447602, 0.9864444, 0.0031414, 0.758273, 0.98975, 0, 0.6615697,
-        0.9827241, 0.0029348, 0.776083, 0.9863, 0, 0.6784, 0.9786, 0.00275,
-        0.793832, 0.98238, 0, 0.6952392, 0.9740837, 0.0025852, 0.811436,
-        0.97798, 0, 0.7120586, 0.9691712, 0.0024386, 0.828822, 0.97311, 0,
-        0.7288284, 0.9638568, 0.0023094, 0.845879, 0.96774, 0, 0.7455188,
-        0.9581349, 0.0021968, 0.862525, 0.96189, 0, 0.7621, 0.952, 0.0021,
-        0.878655, 0.955552, 0, 0.7785432, 0.9454504, 0.0020177, 0.894208,
-        0.948601, 0, 0.7948256, 0.9384992, 0.0019482, 0.909206, 0.940981, 0,
-        0.8109264, 0.9311628, 0.0018898, 0.923672, 0.932798, 0, 0.8268248,
-        0.9234576, 0.0018409, 0.937638, 0.924158, 0, 0.8425, 0.9154, 0.0018,
-        0.951162, 0.915175, 0, 0.8579325, 0.9070064, 0.0017663, 0.964283,
-        0.905954, 0, 0.8730816, 0.8982772, 0.0017378, 0.977068, 0.896608, 0,
-        0.8878944, 0.8892048, 0.0017112, 0.98959, 0.887249, 0, 0.9023181,
-        0.8797816, 0.0016831, 1.002, 0.877986, 0, 0.9163, 0.87, 0.00165, 1.014,
-        0.868934, 0, 0.9297995, 0.8598613, 0.0016101, 1.026, 0.860164, 0,
-        0.9427984, 0.849392, 0.0015644, 1.039, 0.851519, 0, 0.9552776, 0.838622,
-        0.0015136, 1.051, 0.842963, 0, 0.9672179, 0.8275813, 0.0014585, 1.063,
-        0.834393, 0, 0.9786, 0.8163, 0.0014, 1.074, 0.825623, 0, 0.9893856,
-        0.8047947, 0.0013367, 1.085, 0.816764, 0, 0.9995488, 0.793082, 0.00127,
-        1.095, 0.807544, 0, 1.0090892, 0.781192, 0.001205, 1.104, 0.797947, 0,
-        1.0180064, 0.7691547, 0.0011467, 1.112, 0.787893, 0, 1.0263, 0.757,
-        0.0011, 1.119, 0.777405, 0, 1.0339827, 0.7447541, 0.0010688, 1.124,
-        0.76649, 0, 1.040986, 0.7324224, 0.0010494, 1.128, 0.755309, 0,
-        1.047188, 0.7200036, 0.0010356, 1.131, 0.743845, 0, 1.0524667,
-        0.7074965, 0.0010212, 1.133, 0.73219, 0, 1.0567, 0.6949, 0.001, 1.134,
-        0.720353, 0, 1.0597944, 0.6822192, 0.0009686, 1.134, 0.708281, 0,
-        1.0617992, 0.6694716, 0.0009299, 1.133, 0.696055, 0, 1.0628068,
-        0.6566744, 0.0008869, 1.131, 0.683621, 0, 1.0629096, 0.6438448,
-        0.0008426, 1.128, 0.671048, 0, 1.0622, 0.631, 0.0008, 1.124, 0.658341,
-        0, 1.0607352, 0.6181555, 0.000761, 1.119, 0.645545, 0, 1.0584436,
-        0.6053144, 0.0007237, 1.113, 0.632718, 0, 1.0552244, 0.5924756,
-        0.0006859, 1.106, 0.619815, 0, 1.0509768, 0.5796379, 0.0006454, 1.098,
-        0.606887, 0, 1.0456, 0.5668, 0.0006, 1.089, 0.593878, 0, 1.0390369,
-        0.5539611, 0.0005479, 1.079, 0.580781, 0, 1.0313608, 0.5411372,
-        0.0004916, 1.068, 0.567653, 0, 1.0226662, 0.5283528, 0.0004354, 1.057,
-        0.55449, 0, 1.0130477, 0.5156323, 0.0003835, 1.044, 0.541228, 0, 1.0026,
-        0.503, 0.00034, 1.03, 0.527963, 0, 0.9913675, 0.4904688, 0.0003073,
-        1.016, 0.514634, 0, 0.9793314, 0.4780304, 0.0002832, 1.001, 0.501363, 0,
-        0.9664916, 0.4656776, 0.0002654, 0.98479, 0.488124, 0, 0.9528479,
-        0.4534032, 0.0002518, 0.96808, 0.474935, 0, 0.9384, 0.4412, 0.00024,
-        0.95074, 0.461834, 0, 0.923194, 0.42908, 0.0002295, 0.9328, 0.448823, 0,
-        0.907244, 0.417036, 0.0002206, 0.91434, 0.435917, 0, 0.890502, 0.405032,
-        0.000212, 0.89539, 0.423153, 0, 0.87292, 0.393032, 0.0002022, 0.87603,
-        0.410526, 0, 0.8544499, 0.381, 0.00019, 0.856297, 0.398057, 0, 0.835084,
-        0.3689184, 0.0001742, 0.83635, 0.385835, 0, 0.814946, 0.3568272,
-        0.0001556, 0.81629, 0.373951, 0, 0.794186, 0.3447768, 0.000136, 0.79605,
-        0.362311, 0, 0.772954, 0.3328176, 0.0001169, 0.77561, 0.350863, 0,
-        0.7514, 0.321, 0.0001, 0.75493, 0.339554, 0, 0.7295836, 0.3093381,
-        8.61E-05, 0.73399, 0.328309, 0, 0.7075888, 0.2978504, 0.0000746,
-        0.71278, 0.317118, 0, 0.6856022, 0.2865936, 0.000065, 0.69129, 0.305936,
-        0, 0.6638104, 0.2756245, 5.69E-05, 0.66952, 0.294737, 0, 0.6424, 0.265,
-        5.00E-05, 0.647467, 0.283493, 0, 0.6215149, 0.2547632, 4.42E-05,
-        0.62511, 0.272222, 0, 0.6011138, 0.2448896, 3.95E-05, 0.60252, 0.26099,
-        0, 0.5811052, 0.2353344, 3.57E-05, 0.57989, 0.249877, 0, 0.5613977,
-        0.2260528, 3.26E-05, 0.55737, 0.238946, 0, 0.5419, 0.217, 0.00003,
-        0.53511, 0.228254, 0, 0.5225995, 0.2081616, 2.77E-05, 0.51324, 0.217853,
-        0, 0.5035464, 0.1995488, 2.56E-05, 0.49186, 0.20778, 0, 0.4847436,
-        0.1911552, 2.36E-05, 0.47108, 0.198072, 0, 0.4661939, 0.1829744,
-        2.18E-05, 0.45096, 0.188748, 0, 0.4479, 0.175, 0.00002, 0.431567,
-        0.179828, 0, 0.4298613, 0.1672235, 1.81E-05, 0.41287, 0.171285, 0,
-        0.412098, 0.1596464, 0.0000162, 0.39475, 0.163059, 0, 0.394644,
-        0.1522776, 0.0000142, 0.37721, 0.155151, 0, 0.3775333, 0.1451259,
-        1.21E-05, 0.36019, 0.147535, 0, 0.3608, 0.1382, 0.00001, 0.34369,
-        0.140211, 0, 0.3444563, 0.1315003, 7.73E-06, 0.32769, 0.13317, 0,
-        0.3285168, 0.1250248, 0.0000054, 0.31217, 0.1264, 0, 0.3130192,
-        0.1187792, 0.0000032, 0.29711, 0.119892, 0, 0.2980011, 0.1127691,
-        1.33E-06, 0.2825, 0.11364, 0, 0.2835, 0.107, 0, 0.268329, 0.107633, 0,
-        0.2695448, 0.1014762, 0, 0.25459, 0.10187, 0, 0.2561184, 0.0961886, 0,
-        0.2413, 0.096347, 0, 0.2431896, 0.091123, 0, 0.22848, 0.091063, 0,
-        0.2307272, 0.0862649, 0, 0.21614, 0.08601, 0, 0.2187, 0.0816, 0, 0.2043,
-        0.081187, 0, 0.2070971, 0.0771206, 0, 0.19295, 0.076583, 0, 0.1959232,
-        0.0728255, 0, 0.18211, 0.072198, 0, 0.1851708, 0.0687101, 0, 0.17177,
-        0.068024, 0, 0.1748323, 0.0647698, 0, 0.16192, 0.064052, 0, 0.1649,
-        0.061, 0, 0.152568, 0.060281, 0, 0.1553667, 0.0573962, 0, 0.14367,
-        0.056697, 0, 0.14623, 0.053955, 0, 0.1352, 0.053292, 0, 0.13749,
-        0.0506738, 0, 0.12713, 0.050059, 0, 0.1291467, 0.0475497, 0, 0.11948,
-        0.046998, 0, 0.1212, 0.04458, 0, 0.11221, 0.044096, 0, 0.1136397,
-        0.0417587, 0, 0.10531, 0.041345, 0, 0.106465, 0.039085, 0, 0.098786,
-        0.0387507, 0, 0.0996904, 0.0365638, 0, 0.09261, 0.0362978, 0, 0.0933306,
-        0.0342005, 0, 0.086773, 0.0339832, 0, 0.0874, 0.032, 0, 0.0812606,
-        0.0318004, 0, 0.081901, 0.0299626, 0, 0.076048, 0.0297395, 0, 0.0768043,
-        0.0280766, 0, 0.071114, 0.0277918, 0, 0.0720771, 0.0263294, 0, 0.066454,
-        0.0259551, 0, 0.0676866, 0.0247081, 0, 0.062062, 0.0242263, 0, 0.0636,
-        0.0232, 0, 0.05793, 0.0226017, 0, 0.0598069, 0.0218008, 0, 0.05405,
-        0.0210779, 0, 0.0562822, 0.0205011, 0, 0.050412, 0.0196505, 0, 0.052971,
-        0.0192811, 0, 0.047006, 0.0183153, 0, 0.0498186, 0.0181207, 0, 0.043823,
-        0.0170686, 0, 0.04677, 0.017, 0, 0.0408508, 0.0159051, 0, 0.0437841,
-        0.0159038, 0, 0.038072, 0.0148183, 0, 0.0408754, 0.0148372, 0, 0.035468,
-        0.0138008, 0, 0.0380726, 0.0138107, 0, 0.033031, 0.0128495, 0,
-        0.0354046, 0.0128348, 0, 0.030753, 0.0119607, 0, 0.0329, 0.01192, 0,
-        0.028623, 0.0111303, 0, 0.0305642, 0.0110683, 0, 0.026635, 0.0103555, 0,
-        0.0283806, 0.0102734, 0, 0.024781, 0.0096332, 0, 0.0263448, 0.0095333,
-        0, 0.023052, 0.0089599, 0, 0.0244528, 0.0088462, 0, 0.021441, 0.0083324,
-        0, 0.0227, 0.00821, 0, 0.0199413, 0.0077488, 0, 0.0210843, 0.0076238, 0,
-        0.018544, 0.0072046, 0, 0.0195999, 0.0070854, 0, 0.017241, 0.0066975, 0,
-        0.0182373, 0.0065915, 0, 0.016027, 0.0062251, 0, 0.0169872, 0.0061385,
-        0, 0.014896, 0.005785, 0, 0.01584, 0.005723, 0, 0.013842, 0.0053751, 0,
-        0.0147906, 0.0053431, 0, 0.012862, 0.0049941, 0, 0.0138313, 0.0049958,
-        0, 0.011949, 0.0046392, 0, 0.0129487, 0.0046764, 0, 0.0111, 0.0043093,
-        0, 0.0121292, 0.0043801, 0, 0.010311, 0.0040028, 0, 0.0113592, 0.004102,
-        0, 0.00957688, 0.00371774, 0, 0.0106294, 0.0038385, 0, 0.008894,
-        0.00345262, 0, 0.0099388, 0.0035891, 0, 0.0082581, 0.00320583, 0,
-        0.0092884, 0.0033542, 0, 0.0076664, 0.00297623, 0, 0.0086789, 0.0031341,
-        0, 0.0071163, 0.00276281, 0, 0.0081109, 0.002929, 0, 0.0066052,
-        0.00256456, 0, 0.0075824, 0.0027381, 0, 0.0061306, 0.00238048, 0,
-        0.0070887, 0.0025599, 0, 0.0056903, 0.00220971, 0, 0.0066273, 0.0023932,
-        0, 0.0052819, 0.00205132, 0, 0.0061954, 0.0022373, 0, 0.0049033,
-        0.00190449, 0, 0.0057903, 0.002091, 0, 0.00455263, 0.00176847, 0,
-        0.0054098, 0.0019536, 0, 0.0042275, 0.00164236, 0, 0.0050526, 0.0018246,
-        0, 0.0039258, 0.00152535, 0, 0.0047175, 0.0017036, 0, 0.0036457,
-        0.00141672, 0, 0.0044035, 0.0015902, 0, 0.0033859, 0.00131595, 0,
-        0.0041095, 0.001484, 0, 0.0031447, 0.00122239, 0, 0.0038339, 0.0013845,
-        0, 0.0029208, 0.00113555, 0, 0.0035757, 0.0012913, 0, 0.002713,
-        0.00105494, 0, 0.0033343, 0.0012041, 0, 0.0025202, 0.00098014, 0,
-        0.0031091, 0.0011227, 0, 0.0023411, 0.00091066, 0, 0.0028993, 0.001047,
-        0, 0.00217496, 0.00084619, 0, 0.0027043, 0.0009766, 0, 0.0020206,
-        0.00078629, 0, 0.002523, 0.0009111, 0, 0.0018773, 0.00073068, 0,
-        0.0023542, 0.0008501, 0, 0.0017441, 0.00067899, 0, 0.0021966, 0.0007932,
-        0, 0.0016205, 0.00063101, 0, 0.0020492, 0.00074, 0, 0.0015057,
-        0.00058644, 0, 0.001911, 0.0006901, 0, 0.0013992, 0.00054511, 0,
-        0.0017814, 0.0006433, 0, 0.0013004, 0.00050672, 0, 0.0016601, 0.0005995,
-        0, 0.0012087, 0.00047111, 0, 0.0015465, 0.0005585, 0, 0.0011236,
-        0.00043805, 0, 0.00144, 0.00052, 0, 0.00104476, 0.00040741, 0, 0.00134,
-        0.0004839, 0, 0.00097156, 0.000378962, 0, 0.0012463, 0.0004501, 0,
-        0.0009036, 0.000352543, 0, 0.0011585, 0.0004183, 0, 0.00084048,
-        0.000328001, 0, 0.0010764, 0.0003887, 0, 0.00078187, 0.000305208, 0,
-        0.0009999, 0.0003611, 0, 0.00072745, 0.000284041, 0, 0.0009287,
-        0.0003354, 0, 0.0006769, 0.000264375, 0, 0.0008624, 0.0003114, 0,
-        0.00062996, 0.000246109, 0, 0.0008008, 0.0002892, 0, 0.00058637,
-        0.000229143, 0, 0.0007434, 0.0002685, 0, 0.00054587, 0.000213376, 0,
-        0.0006901, 0.0002492, 0, 0.000508258, 0.00019873, 0, 0.0006405,
-        0.0002313, 0, 0.0004733, 0.000185115, 0, 0.0005945, 0.0002147, 0,
-        0.0004408, 0.000172454, 0, 0.0005519, 0.0001993, 0, 0.00041058,
-        0.000160678, 0, 0.0005124, 0.000185, 0, 0.00038249, 0.00014973, 0,
-        0.000476, 0.0001719, 0, 0.00035638, 0.00013955, 0, 0.0004425, 0.0001598,
-        0, 0.00033211, 0.000130086, 0, 0.0004115, 0.0001486, 0, 0.00030955,
-        0.00012129, 0, 0.000383, 0.0001383, 0, 0.00028858, 0.000113106, 0,
-        0.0003566, 0.0001288, 0, 0.00026909, 0.000105501, 0, 0.0003323, 0.00012,
-        0, 0.000250969, 0.000098428, 0, 0.0003098, 0.0001119, 0, 0.00023413,
-        0.000091853, 0, 0.0002889, 0.0001043, 0, 0.00021847, 0.000085738, 0,
-        0.0002695, 9.73E-05, 0, 0.00020391, 0.000080048, 0, 0.0002516, 9.09E-05,
-        0, 0.00019035, 0.000074751, 0, 0.0002348, 0.0000848, 0, 0.00017773,
-        0.000069819, 0, 0.0002192, 7.92E-05, 0, 0.00016597, 0.000065222, 0,
-        0.0002045, 7.39E-05, 0, 0.00015502, 0.000060939, 0, 0.0001908, 6.89E-05,
-        0, 0.0001448, 0.000056942, 0, 0.0001781, 6.43E-05, 0, 0.00013528,
-        0.000053217, 0, 0.0001662, 0.00006, 0, 0.00012639, 0.000049737, 0,
-        0.000155, 5.60E-05, 0, 0.0001181, 0.000046491, 0, 0.0001446, 5.22E-05,
-        0, 0.00011037, 0.000043464, 0, 0.0001349, 4.87E-05, 0, 0.00010315,
-        0.000040635, 0, 0.0001259, 4.55E-05, 0, 0.000096427, 0.000038, 0,
-        0.0001174, 0.0000424, 0, 0.000090151, 0.00003554, 0, 0.0001096,
-        3.96E-05, 0, 0.000084294, 0.000033245, 0, 0.0001022, 3.69E-05, 0,
-        0.00007883, 0.000031101, 0, 9.54E-05, 3.45E-05, 0, 0.000073729,
-        0.000029099, 0, 8.90E-05, 3.22E-05, 0, 0.000068969, 0.000027231, 0,
-        8.31E-05, 0.00003, 0, 0.000064526, 0.000025486, 0, 7.75E-05, 2.80E-05,
-        0, 0.000060376, 0.000023856, 0, 7.23E-05, 2.61E-05, 0, 0.0000565,
-        0.000022333, 0, 6.75E-05, 2.44E-05, 0, 0.00005288, 0.00002091, 0,
-        6.29E-05, 2.27E-05, 0, 0.000049498, 0.000019581, 0, 5.87E-05, 0.0000212,
-        0, 0.000046339, 0.000018338, 0, 5.48E-05, 1.98E-05, 0, 0.000043389,
-        0.000017178, 0, 5.11E-05, 1.85E-05, 0, 0.000040634, 0.000016093, 0,
-        4.77E-05, 1.72E-05, 0, 0.00003806, 0.00001508, 0, 4.45E-05, 1.61E-05, 0,
-        0.000035657, 0.000014134, 0, 4.15E-05, 1.50E-05, 0, 0.000033412,
-        0.000013249, 0, 3.87E-05, 1.40E-05, 0, 0.000031315, 0.000012423, 0,
-        3.61E-05, 1.31E-05, 0, 0.000029355, 0.00001165, 0, 3.37E-05, 1.22E-05,
-        0, 0.000027524, 0.000010928, 0, 3.15E-05, 1.14E-05, 0, 0.000025811,
-        0.000010252, 0, 2.94E-05, 0.0000106, 0, 0.000024209, 0.00000962, 0,
-        2.74E-05, 9.89E-06, 0, 0.000022711, 0.000009028, 0, 2.55E-05, 9.22E-06,
-        0, 0.000021308, 0.000008474, 0, 2.38E-05, 8.59E-06, 0, 0.000019994,
-        0.000007955, 0, 2.22E-05, 8.01E-06, 0, 0.000018764, 0.000007469, 0,
-        2.07E-05, 7.47E-06, 0, 0.000017612, 0.000007013, 0, 1.93E-05, 6.96E-06,
-        0, 0.000016532, 0.000006586, 0, 1.80E-05, 6.49E-06, 0, 0.000015521,
-        0.000006186, 0, 1.68E-05, 6.05E-06, 0, 0.000014574, 0.000005811, 0,
-        1.56E-05, 5.64E-06, 0, 0.000013686, 0.000005459, 0, 1.46E-05, 5.26E-06,
-        0, 0.000012855, 0.00000513, 0, 1.36E-05, 4.90E-06, 0, 0.000012075,
-        0.000004821, 0, 1.27E-05, 4.57E-06, 0, 0.000011345, 0.000004531, 0,
-        1.18E-05, 4.26E-06, 0, 0.000010659, 0.000004259, 0, 1.10E-05, 3.97E-06,
-        0, 0.000010017, 0.000004004, 0, 1.03E-05, 3.70E-06, 0, 0.000009414,
-        0.000003765, 0, 9.56E-06, 3.45E-06, 0, 0.000008848, 0.00000354, 0,
-        8.91E-06, 3.22E-06, 0, 0.000008317, 0.000003329, 0, 8.31E-06, 3.00E-06,
-        0, 0.000007819, 0.000003131, 0, 7.75E-06, 2.80E-06, 0, 0.000007352,
-        0.000002945, 0, 7.22E-06, 2.61E-06, 0, 0.000006913, 0.000002771, 0,
-        6.73E-06, 2.43E-06, 0, 0.000006502, 0.000002607, 0, 6.28E-06, 2.27E-06,
-        0, 0.000006115, 0.000002453, 0, 5.85E-06, 2.11E-06, 0, 0.000005753,
-        0.000002309, 0, 5.46E-06, 1.97E-06, 0, 0.000005413, 0.000002173, 0,
-        5.09E-06, 1.84E-06, 0, 0.000005093, 0.000002046, 0, 4.74E-06, 1.71E-06,
-        0, 0.000004794, 0.000001927, 0, 4.42E-06, 1.60E-06, 0, 0.000004512,
-        0.000001814, 0, 4.12E-06, 1.49E-06, 0, 0.000004248, 0.000001709, 0,
-        3.84E-06, 1.39E-06, 0, 0.000004, 0.00000161, 0, 3.58E-06, 1.29E-06, 0,
-        0.000003767, 0.000001517, 0, 3.34E-06, 1.21E-06, 0, 0.000003548,
-        0.000001429, 0, 3.11E-06, 1.12E-06, 0, 0.000003342, 0.000001347, 0,
-        2.90E-06, 1.05E-06, 0, 0.000003148, 0.000001269, 0, 2.71E-06, 9.77E-07,
-        0, 0.000002966, 0.000001197, 0, 2.52E-06, 9.11E-07, 0, 0.000002795,
-        0.000001128, 0, 2.35E-06, 8.49E-07, 0, 0.000002634, 0.000001064, 0,
-        2.19E-06, 7.92E-07, 0, 0.000002483, 0.000001003, 0, 2.04E-06, 7.38E-07,
-        0, 0.000002341, 0.000000946, 0, 1.91E-06, 6.88E-07, 0, 0.000002208,
-        0.000000893, 0, 1.78E-06, 6.42E-07, 0, 0.000002082, 0.000000842, 0,
-        1.66E-06, 5.98E-07, 0, 0.000001964, 0.000000795, 0, 1.54E-06, 5.58E-07,
-        0, 0.000001852, 0.00000075, 0, 1.44E-06, 5.20E-07, 0, 0.000001746,
-        0.000000707, 0, 1.34E-06, 4.85E-07, 0, 0.000001647, 0.000000667, 0,
-        1.25E-06, 4.52E-07, 0, 0.000001553, 0.00000063, 0;
+  /* Number of samples at the provided interval [nm] (1, 5, and 10 nm give
+   * the standard tables, any positive interval is allowed)
+  */
+  static int samples(int interval = 1) {
+    if (interval < 1) {
+      throw std::runtime_error("CIE sampling interval must be positive");
+    }
+    return (kSamples - 1) / interval + 1;
   }
 
   /* CIE wavelengths getter
   */
-  Eigen::VectorXd wavelengths() const { return wavelengths_; }
+  static VectorView wavelengths(int interval = 1) {
+    return VectorView(kWavelengths.data(), samples(interval),
+                      Eigen::InnerStride<>(interval));
+  }
 
   /* CIE reference illuminant getter
   */
-  Eigen::VectorXd reference_illuminant(
-      int illuminant = ReferenceIlluminant::d65) const {
-    return reference_illuminant_.col(illuminant);
+  static VectorView reference_illuminant(
+      int illuminant = ReferenceIlluminant::d65, int interval = 1) {
+    return VectorView(kReferenceIlluminant[illuminant], samples(interval),
+                      Eigen::InnerStride<>(interval));
   }
 
-  /* CIE standard observer getter
+  /* CIE standard observer getter (x-bar, y-bar, and z-bar columns)
   */
-  Eigen::MatrixXd standard_observer(
-      int observer = StandardObserver::ten_deg) const {
-    return standard_observer_.block<471, 3>(0, 3 * observer);
+  static MatrixView standard_observer(int observer = StandardObserver::ten_deg,
+                                      int interval = 1) {
+    return MatrixView(kStandardObserver[observer][0], samples(interval), 3,
+                      Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
+                          kSamples, interval));
   }
 
   /* CIE standard observer (x-bar) getter
   */
-  Eigen::VectorXd xbar(int observer = StandardObserver::ten_deg) const {
-    return standard_observer_.col(3 * observer + 0);
+  static VectorView xbar(int observer = StandardObserver::ten_deg,
+                         int interval = 1) {
+    return VectorView(kStandardObserver[observer][0], samples(interval),
+                      Eigen::InnerStride<>(interval));
   }
 
   /* CIE standard observer (y-bar) getter
   */
-  Eigen::VectorXd ybar(int observer = StandardObserver::ten_deg) const {
-    return standard_observer_.col(3 * observer + 1);
+  static VectorView ybar(int observer = StandardObserver::ten_deg,
+                         int interval = 1) {
+    return VectorView(kStandardObserver[observer][1], samples(interval),
+                      Eigen::InnerStride<>(interval));
   }
 
   /* CIE standard observer (z-bar) getter
   */
-  Eigen::VectorXd zbar(int observer = StandardObserver::ten_deg) const {
-    return standard_observer_.col(3 * observer + 2);
+  static VectorView zbar(int observer = StandardObserver::ten_deg,
+                         int interval = 1) {
+    return VectorView(kStandardObserver[observer][2], samples(interval),
+                      Eigen::InnerStride<>(interval));
   }
 
  private:
-  Eigen::VectorXd wavelengths_ = Eigen::VectorXd::LinSpaced(471, 360, 830);
+  static constexpr std::array<double, kSamples> kWavelengths =
+      detail::CieWavelengths<kSamples>(kFirstWavelength);
 
-  Eigen::VectorXd reference_illuminant_d65_ = Eigen::VectorXd(471);
-  Eigen::VectorXd reference_illuminant_a_ = Eigen::VectorXd(471);
-  Eigen::MatrixXd reference_illuminant_ = Eigen::MatrixXd(471, 2);
+  // CIE REFERENCE ILLUMINANT DATA
+  static constexpr double kReferenceIlluminant[2][kSamples] = {
+      // CIE reference illuminant A
+      {
+          6.14462, 6.29955, 6.45724, 6.61774, 6.78105, 6.9472, 7.11621, 7.28811,
+          7.46292, 7.64066, 7.82135, 8.00501, 8.19167, 8.38134, 8.57404, 8.7698,
+          8.96864, 9.17056, 9.37561, 9.58378, 9.7951, 10.0096, 10.2273, 10.4481,
+          10.6722, 10.8996, 11.1302, 11.364, 11.6012, 11.8416, 12.0853, 12.3324,
+          12.5828, 12.8366, 13.0938, 13.3543, 13.6182, 13.8855, 14.1563,
+          14.4304, 14.708, 14.9891, 15.2736, 15.5616, 15.853, 16.148, 16.4464,
+          16.7484, 17.0538, 17.3628, 17.6753, 17.9913, 18.3108, 18.6339,
+          18.9605, 19.2907, 19.6244, 19.9617, 20.3026, 20.647, 20.995, 21.3465,
+          21.7016, 22.0603, 22.4225, 22.7883, 23.1577, 23.5307, 23.9072,
+          24.2873, 24.6709, 25.0581, 25.4489, 25.8432, 26.2411, 26.6425,
+          27.0475, 27.456, 27.8681, 28.2836, 28.7027, 29.1253, 29.5515, 29.9811,
+          30.4142, 30.8508, 31.2909, 31.7345, 32.1815, 32.632, 33.0859, 33.5432,
+          34.004, 34.4682, 34.9358, 35.4068, 35.8811, 36.3588, 36.8399, 37.3243,
+          37.8121, 38.3031, 38.7975, 39.2951, 39.796, 40.3002, 40.8076, 41.3182,
+          41.832, 42.3491, 42.8693, 43.3926, 43.9192, 44.4488, 44.9816, 45.5174,
+          46.0563, 46.5983, 47.1433, 47.6913, 48.2423, 48.7963, 49.3533,
+          49.9132, 50.476, 51.0418, 51.6104, 52.1818, 52.7561, 53.3332, 53.9132,
+          54.4958, 55.0813, 55.6694, 56.2603, 56.8539, 57.4501, 58.0489,
+          58.6504, 59.2545, 59.8611, 60.4703, 61.082, 61.6962, 62.3128, 62.932,
+          63.5535, 64.1775, 64.8038, 65.4325, 66.0635, 66.6968, 67.3324,
+          67.9702, 68.6102, 69.2525, 69.8969, 70.5435, 71.1922, 71.843, 72.4959,
+          73.1508, 73.8077, 74.4666, 75.1275, 75.7903, 76.4551, 77.1217,
+          77.7902, 78.4605, 79.1326, 79.8065, 80.4821, 81.1595, 81.8386,
+          82.5193, 83.2017, 83.8856, 84.5712, 85.2584, 85.947, 86.6372, 87.3288,
+          88.0219, 88.7165, 89.4124, 90.1097, 90.8083, 91.5082, 92.2095, 92.912,
+          93.6157, 94.3206, 95.0267, 95.7339, 96.4423, 97.1518, 97.8623,
+          98.5739, 99.2864, 100, 100.715, 101.43, 102.146, 102.864, 103.582,
+          104.301, 105.02, 105.741, 106.462, 107.184, 107.906, 108.63, 109.354,
+          110.078, 110.803, 111.529, 112.255, 112.982, 113.709, 114.436,
+          115.164, 115.893, 116.622, 117.351, 118.08, 118.81, 119.54, 120.27,
+          121.001, 121.731, 122.462, 123.193, 123.924, 124.655, 125.386,
+          126.118, 126.849, 127.58, 128.312, 129.043, 129.774, 130.505, 131.236,
+          131.966, 132.697, 133.427, 134.157, 134.887, 135.617, 136.346,
+          137.075, 137.804, 138.532, 139.26, 139.988, 140.715, 141.441, 142.167,
+          142.89, 143.618, 144.343, 145.067, 145.79, 146.513, 147.235, 147.957,
+          148.678, 149.398, 150.117, 150.836, 151.554, 152.271, 152.988,
+          153.704, 154.418, 155.132, 155.845, 156.558, 157.269, 157.979,
+          158.689, 159.397, 160.104, 160.811, 161.516, 162.221, 162.924,
+          163.626, 164.327, 165.028, 165.726, 166.424, 167.121, 167.816, 168.51,
+          169.203, 169.895, 170.586, 171.275, 171.963, 172.65, 173.335, 174.019,
+          174.702, 175.383, 176.063, 176.741, 177.419, 178.094, 178.769,
+          179.441, 180.113, 180.783, 181.451, 182.118, 182.783, 183.447,
+          184.109, 184.77, 185.429, 186.087, 186.743, 187.397, 188.05, 188.701,
+          189.35, 189.998, 190.644, 191.288, 191.931, 192.572, 193.211, 193.849,
+          194.484, 195.118, 195.75, 196.381, 197.009, 197.636, 198.261, 198.884,
+          199.506, 200.125, 200.743, 201.359, 201.972, 202.584, 203.195,
+          203.803, 204.409, 205.013, 205.616, 206.216, 206.815, 207.411,
+          208.006, 208.599, 209.189, 209.778, 210.365, 210.949, 211.532,
+          212.112, 212.691, 213.268, 213.842, 214.415, 214.985, 215.553, 216.12,
+          216.684, 217.246, 217.806, 218.364, 218.92, 219.473, 220.025, 220.574,
+          221.122, 221.667, 222.21, 222.751, 223.29, 223.826, 224.361, 224.893,
+          225.423, 225.951, 226.477, 227, 227.522, 228.041, 228.558, 229.073,
+          229.585, 230.096, 230.604, 231.11, 231.614, 232.115, 232.615, 233.112,
+          233.606, 234.099, 234.589, 235.078, 235.564, 236.047, 236.529,
+          237.008, 237.485, 237.959, 238.432, 238.902, 239.37, 239.836, 240.299,
+          240.76, 241.219, 241.675, 242.13, 242.582, 243.031, 243.479, 243.924,
+          244.367, 244.808, 245.246, 245.682, 246.116, 246.548, 246.977,
+          247.404, 247.829, 248.251, 248.671, 249.089, 249.505, 249.918,
+          250.329, 250.738, 251.144, 251.548, 251.95, 252.35, 252.747, 253.142,
+          253.535, 253.925, 254.314, 254.7, 255.083, 255.465, 255.844, 256.221,
+          256.595, 256.968, 257.338, 257.706, 258.071, 258.434, 258.795,
+          259.154, 259.511, 259.865, 260.217, 260.567, 260.914, 261.259, 261.602
+      },
+      // CIE reference illuminant D65
+      {
+          46.6383, 47.1834, 47.7285, 48.2735, 48.8186, 49.3637, 49.9088,
+          50.4539, 50.9989, 51.544, 52.0891, 51.8777, 51.6664, 51.455, 51.2437,
+          51.0323, 50.8209, 50.6096, 50.3982, 50.1869, 49.9755, 50.4428, 50.91,
+          51.3773, 51.8446, 52.3118, 52.7791, 53.2464, 53.7137, 54.1809,
+          54.6482, 57.4589, 60.2695, 63.0802, 65.8909, 68.7015, 71.5122,
+          74.3229, 77.1336, 79.9442, 82.7549, 83.628, 84.5011, 85.3742, 86.2473,
+          87.1204, 87.9936, 88.8667, 89.7398, 90.6129, 91.486, 91.6806, 91.8752,
+          92.0697, 92.2643, 92.4589, 92.6535, 92.8481, 93.0426, 93.2372,
+          93.4318, 92.7568, 92.0819, 91.4069, 90.732, 90.057, 89.3821, 88.7071,
+          88.0322, 87.3572, 86.6823, 88.5006, 90.3188, 92.1371, 93.9554,
+          95.7736, 97.5919, 99.4102, 101.228, 103.047, 104.865, 106.079,
+          107.294, 108.508, 109.722, 110.936, 112.151, 113.365, 114.579,
+          115.794, 117.008, 117.088, 117.169, 117.249, 117.33, 117.41, 117.49,
+          117.571, 117.651, 117.732, 117.812, 117.517, 117.222, 116.927,
+          116.632, 116.336, 116.041, 115.746, 115.451, 115.156, 114.861,
+          114.967, 115.073, 115.18, 115.286, 115.392, 115.498, 115.604, 115.711,
+          115.817, 115.923, 115.212, 114.501, 113.789, 113.078, 112.367,
+          111.656, 110.945, 110.233, 109.522, 108.811, 108.865, 108.92, 108.974,
+          109.028, 109.082, 109.137, 109.191, 109.245, 109.3, 109.354, 109.199,
+          109.044, 108.888, 108.733, 108.578, 108.423, 108.268, 108.112,
+          107.957, 107.802, 107.501, 107.2, 106.898, 106.597, 106.296, 105.995,
+          105.694, 105.392, 105.091, 104.79, 105.08, 105.37, 105.66, 105.95,
+          106.239, 106.529, 106.819, 107.109, 107.399, 107.689, 107.361,
+          107.032, 106.704, 106.375, 106.047, 105.719, 105.39, 105.062, 104.733,
+          104.405, 104.369, 104.333, 104.297, 104.261, 104.225, 104.19, 104.154,
+          104.118, 104.082, 104.046, 103.641, 103.237, 102.832, 102.428,
+          102.023, 101.618, 101.214, 100.809, 100.405, 100, 99.6334, 99.2668,
+          98.9003, 98.5337, 98.1671, 97.8005, 97.4339, 97.0674, 96.7008,
+          96.3342, 96.2796, 96.225, 96.1703, 96.1157, 96.0611, 96.0065, 95.9519,
+          95.8972, 95.8426, 95.788, 95.0778, 94.3675, 93.6573, 92.947, 92.2368,
+          91.5266, 90.8163, 90.1061, 89.3958, 88.6856, 88.8177, 88.9497,
+          89.0818, 89.2138, 89.3459, 89.478, 89.61, 89.7421, 89.8741, 90.0062,
+          89.9655, 89.9248, 89.8841, 89.8434, 89.8026, 89.7619, 89.721, 89.6805,
+          89.6398, 89.5991, 89.4091, 89.219, 89.029, 88.8389, 88.6489, 88.4589,
+          88.2688, 88.0788, 87.8887, 87.6987, 87.2577, 86.8167, 86.3757,
+          85.9347, 85.4936, 85.0526, 84.6116, 84.1706, 83.7296, 83.2886,
+          83.3297, 83.3707, 83.4118, 83.4528, 83.4939, 83.535, 83.576, 83.6171,
+          83.6581, 83.6992, 83.332, 82.9647, 82.5975, 82.2302, 81.863, 81.4958,
+          81.1285, 80.7613, 80.394, 80.0268, 80.0456, 80.0644, 80.0831, 80.1019,
+          80.1207, 80.1395, 80.1583, 80.177, 80.1958, 80.2146, 80.4209, 80.6272,
+          80.8336, 81.0399, 81.2462, 81.4525, 81.6588, 81.8652, 82.0715,
+          82.2778, 81.8784, 81.4791, 81.0797, 80.6804, 80.281, 79.8816, 79.4823,
+          79.0829, 78.6836, 78.2842, 77.4279, 76.5716, 75.7153, 74.859, 74.0027,
+          73.1465, 72.2902, 71.4339, 70.5776, 69.7213, 69.9101, 70.0989,
+          70.2876, 70.4764, 70.6652, 70.854, 71.0428, 71.2315, 71.4203, 71.6091,
+          71.8831, 72.1571, 72.4311, 72.7051, 72.979, 73.253, 73.527, 73.801,
+          74.075, 74.349, 73.0745, 71.8, 70.5255, 69.251, 67.9765, 66.702,
+          65.4275, 64.153, 62.8785, 61.604, 62.4322, 63.2603, 64.0885, 64.9166,
+          65.7448, 66.573, 67.4011, 68.2293, 69.0574, 69.8856, 70.4057, 70.9259,
+          71.446, 71.9662, 72.4863, 73.0064, 73.5266, 74.0467, 74.5669, 75.087,
+          73.9376, 72.7881, 71.6387, 70.4893, 69.3398, 68.1904, 67.041, 65.8916,
+          64.7421, 63.5927, 61.8752, 60.1578, 58.4403, 56.7229, 55.0054, 53.288,
+          51.5705, 49.8531, 48.1356, 46.4182, 48.4569, 50.4956, 52.5344,
+          54.5731, 56.6118, 58.6505, 60.6892, 62.728, 64.7667, 66.8054, 66.4631,
+          66.1209, 65.7786, 65.4364, 65.0941, 64.7518, 64.4096, 64.0673,
+          63.7251, 63.3828, 63.4749, 63.567, 63.6592, 63.7513, 63.8434, 63.9355,
+          64.0276, 64.1198, 64.2119, 64.304, 63.8188, 63.3336, 62.8484, 62.3632,
+          61.8779, 61.3927, 60.9075, 60.4223, 59.9371, 59.4519, 58.7026,
+          57.9533, 57.204, 56.4547, 55.7054, 54.9562, 54.2069, 53.4576, 52.7083,
+          51.959, 52.5072, 53.0553, 53.6035, 54.1516, 54.6998, 55.248, 55.7961,
+          56.3443, 56.8924, 57.4406, 57.7278, 58.015, 58.3022, 58.5894, 58.8765,
+          59.1637, 59.4509, 59.7381, 60.0253, 60.3125
+      }
+  };
 
-  Eigen::MatrixXd standard_observer_ = Eigen::MatrixXd(471, 6);
+  // CIE STANDARD OBSERVER DATA
+  static constexpr double kStandardObserver[2][3][kSamples] = {
+      {
+          // CIE 1931 2-degree Standard Observer (x-bar)
+          {
+              0.0001299, 0.0001458, 0.0001638, 0.000184, 0.0002067, 0.0002321,
+              0.0002607, 0.0002931, 0.0003294, 0.0003699, 0.0004149, 0.0004642,
+              0.000519, 0.0005819, 0.0006552, 0.0007416, 0.000845, 0.0009645,
+              0.0010949, 0.0012312, 0.001368, 0.0015021, 0.0016423, 0.0018024,
+              0.0019958, 0.002236, 0.0025354, 0.0028926, 0.0033008, 0.0037532,
+              0.004243, 0.0047624, 0.00533, 0.0059787, 0.0067411, 0.00765,
+              0.0087514, 0.0100289, 0.0114217, 0.012869, 0.01431, 0.0157044,
+              0.0171474, 0.0187812, 0.020748, 0.02319, 0.0262074, 0.0297825,
+              0.0338809, 0.0384682, 0.04351, 0.0489956, 0.0550226, 0.0617188,
+              0.069212, 0.07763, 0.0869581, 0.0971767, 0.1084063, 0.1207672,
+              0.13438, 0.1493582, 0.1653957, 0.1819831, 0.198611, 0.21477,
+              0.2301868, 0.2448797, 0.2587773, 0.2718079, 0.2839, 0.2949438,
+              0.3048965, 0.3137873, 0.3216454, 0.3285, 0.3343513, 0.3392101,
+              0.3431213, 0.3461296, 0.34828, 0.3495999, 0.3501474, 0.350013,
+              0.349287, 0.34806, 0.3463733, 0.3442624, 0.3418088, 0.3390941,
+              0.3362, 0.3331977, 0.3300411, 0.3266357, 0.3228868, 0.3187,
+              0.3140251, 0.308884, 0.3032904, 0.2972579, 0.2908, 0.2839701,
+              0.2767214, 0.2689178, 0.2604227, 0.2511, 0.2408475, 0.2298512,
+              0.2184072, 0.2068115, 0.19536, 0.1842136, 0.1733273, 0.1626881,
+              0.1522833, 0.1421, 0.1321786, 0.1225696, 0.1132752, 0.1042979,
+              0.09564, 0.0872996, 0.079308, 0.0717178, 0.064581, 0.05795,
+              0.0518621, 0.0462815, 0.0411509, 0.0364128, 0.03201, 0.0279172,
+              0.0241444, 0.020687, 0.0175404, 0.0147, 0.0121618, 0.00992,
+              0.0079672, 0.0062963, 0.0049, 0.0037772, 0.0029453, 0.0024249,
+              0.0022363, 0.0024, 0.0029255, 0.0038366, 0.0051748, 0.0069821,
+              0.0093, 0.0121495, 0.0155359, 0.0194775, 0.0239928, 0.0291,
+              0.0348149, 0.0411202, 0.047985, 0.0553786, 0.06327, 0.071635,
+              0.0804622, 0.08974, 0.0994565, 0.1096, 0.1201674, 0.1311145,
+              0.1423679, 0.1538542, 0.1655, 0.1772571, 0.18914, 0.2011694,
+              0.2133658, 0.2257499, 0.2383209, 0.2510668, 0.2639922, 0.2771017,
+              0.2904, 0.3038912, 0.3175726, 0.3314384, 0.3454828, 0.3597,
+              0.3740839, 0.3886396, 0.4033784, 0.4183115, 0.4334499, 0.4487953,
+              0.464336, 0.480064, 0.4959713, 0.5120501, 0.5282959, 0.5446916,
+              0.5612094, 0.5778215, 0.5945, 0.6112209, 0.6279758, 0.6447602,
+              0.6615697, 0.6784, 0.6952392, 0.7120586, 0.7288284, 0.7455188,
+              0.7621, 0.7785432, 0.7948256, 0.8109264, 0.8268248, 0.8425,
+              0.8579325, 0.8730816, 0.8878944, 0.9023181, 0.9163, 0.9297995,
+              0.9427984, 0.9552776, 0.9672179, 0.9786, 0.9893856, 0.9995488,
+              1.0090892, 1.0180064, 1.0263, 1.0339827, 1.040986, 1.047188,
+              1.0524667, 1.0567, 1.0597944, 1.0617992, 1.0628068, 1.0629096,
+              1.0622, 1.0607352, 1.0584436, 1.0552244, 1.0509768, 1.0456,
+              1.0390369, 1.0313608, 1.0226662, 1.0130477, 1.0026, 0.9913675,
+              0.9793314, 0.9664916, 0.9528479, 0.9384, 0.923194, 0.907244,
+              0.890502, 0.87292, 0.8544499, 0.835084, 0.814946, 0.794186,
+              0.772954, 0.7514, 0.7295836, 0.7075888, 0.6856022, 0.6638104,
+              0.6424, 0.6215149, 0.6011138, 0.5811052, 0.5613977, 0.5419,
+              0.5225995, 0.5035464, 0.4847436, 0.4661939, 0.4479, 0.4298613,
+              0.412098, 0.394644, 0.3775333, 0.3608, 0.3444563, 0.3285168,
+              0.3130192, 0.2980011, 0.2835, 0.2695448, 0.2561184, 0.2431896,
+              0.2307272, 0.2187, 0.2070971, 0.1959232, 0.1851708, 0.1748323,
+              0.1649, 0.1553667, 0.14623, 0.13749, 0.1291467, 0.1212, 0.1136397,
+              0.106465, 0.0996904, 0.0933306, 0.0874, 0.081901, 0.0768043,
+              0.0720771, 0.0676866, 0.0636, 0.0598069, 0.0562822, 0.052971,
+              0.0498186, 0.04677, 0.0437841, 0.0408754, 0.0380726, 0.0354046,
+              0.0329, 0.0305642, 0.0283806, 0.0263448, 0.0244528, 0.0227,
+              0.0210843, 0.0195999, 0.0182373, 0.0169872, 0.01584, 0.0147906,
+              0.0138313, 0.0129487, 0.0121292, 0.0113592, 0.0106294, 0.0099388,
+              0.0092884, 0.0086789, 0.0081109, 0.0075824, 0.0070887, 0.0066273,
+              0.0061954, 0.0057903, 0.0054098, 0.0050526, 0.0047175, 0.0044035,
+              0.0041095, 0.0038339, 0.0035757, 0.0033343, 0.0031091, 0.0028993,
+              0.0027043, 0.002523, 0.0023542, 0.0021966, 0.0020492, 0.001911,
+              0.0017814, 0.0016601, 0.0015465, 0.00144, 0.00134, 0.0012463,
+              0.0011585, 0.0010764, 0.0009999, 0.0009287, 0.0008624, 0.0008008,
+              0.0007434, 0.0006901, 0.0006405, 0.0005945, 0.0005519, 0.0005124,
+              0.000476, 0.0004425, 0.0004115, 0.000383, 0.0003566, 0.0003323,
+              0.0003098, 0.0002889, 0.0002695, 0.0002516, 0.0002348, 0.0002192,
+              0.0002045, 0.0001908, 0.0001781, 0.0001662, 0.000155, 0.0001446,
+              0.0001349, 0.0001259, 0.0001174, 0.0001096, 0.0001022, 9.54E-05,
+              8.90E-05, 8.31E-05, 7.75E-05, 7.23E-05, 6.75E-05, 6.29E-05,
+              5.87E-05, 5.48E-05, 5.11E-05, 4.77E-05, 4.45E-05, 4.15E-05,
+              3.87E-05, 3.61E-05, 3.37E-05, 3.15E-05, 2.94E-05, 2.74E-05,
+              2.55E-05, 2.38E-05, 2.22E-05, 2.07E-05, 1.93E-05, 1.80E-05,
+              1.68E-05, 1.56E-05, 1.46E-05, 1.36E-05, 1.27E-05, 1.18E-05,
+              1.10E-05, 1.03E-05, 9.56E-06, 8.91E-06, 8.31E-06, 7.75E-06,
+              7.22E-06, 6.73E-06, 6.28E-06, 5.85E-06, 5.46E-06, 5.09E-06,
+              4.74E-06, 4.42E-06, 4.12E-06, 3.84E-06, 3.58E-06, 3.34E-06,
+              3.11E-06, 2.90E-06, 2.71E-06, 2.52E-06, 2.35E-06, 2.19E-06,
+              2.04E-06, 1.91E-06, 1.78E-06, 1.66E-06, 1.54E-06, 1.44E-06,
+              1.34E-06, 1.25E-06
+          },
+          // CIE 1931 2-degree Standard Observer (y-bar)
+          {
+              3.92E-06, 4.39E-06, 4.93E-06, 5.53E-06, 6.21E-06, 6.97E-06,
+              7.81E-06, 8.77E-06, 9.84E-06, 1.10E-05, 1.24E-05, 1.39E-05,
+              1.56E-05, 1.74E-05, 1.96E-05, 2.20E-05, 2.48E-05, 2.80E-05,
+              3.15E-05, 3.52E-05, 0.000039, 4.28E-05, 4.69E-05, 5.16E-05,
+              5.72E-05, 0.000064, 7.23E-05, 8.22E-05, 9.35E-05, 0.0001061,
+              0.00012, 0.000135, 0.0001515, 0.0001702, 0.0001918, 0.000217,
+              0.0002469, 0.0002812, 0.0003185, 0.0003573, 0.000396, 0.0004337,
+              0.000473, 0.0005179, 0.0005722, 0.00064, 0.0007246, 0.0008255,
+              0.0009412, 0.0010699, 0.00121, 0.0013621, 0.0015308, 0.0017204,
+              0.0019353, 0.00218, 0.0024548, 0.002764, 0.0031178, 0.0035264,
+              0.004, 0.0045462, 0.0051593, 0.0058293, 0.0065462, 0.0073,
+              0.0080865, 0.0089087, 0.0097677, 0.0106644, 0.0116, 0.0125732,
+              0.0135827, 0.0146297, 0.0157151, 0.01684, 0.0180074, 0.0192145,
+              0.0204539, 0.0217182, 0.023, 0.0242946, 0.0256102, 0.0269586,
+              0.0283513, 0.0298, 0.0313108, 0.0328837, 0.0345211, 0.0362257,
+              0.038, 0.0398467, 0.041768, 0.043766, 0.0458427, 0.048, 0.0502437,
+              0.052573, 0.0549806, 0.0574587, 0.06, 0.062602, 0.0652775,
+              0.0680421, 0.0709111, 0.0739, 0.077016, 0.0802664, 0.0836668,
+              0.0872328, 0.09098, 0.0949176, 0.0990458, 0.1033674, 0.1078846,
+              0.1126, 0.117532, 0.1226744, 0.1279928, 0.1334528, 0.13902,
+              0.1446764, 0.1504693, 0.1564619, 0.1627177, 0.1693, 0.1762431,
+              0.1835581, 0.1912735, 0.199418, 0.20802, 0.2171199, 0.2267345,
+              0.2368571, 0.2474812, 0.2586, 0.2701849, 0.2822939, 0.2950505,
+              0.308578, 0.323, 0.3384021, 0.3546858, 0.3716986, 0.3892875,
+              0.4073, 0.4256299, 0.4443096, 0.4633944, 0.4829395, 0.503,
+              0.5235693, 0.544512, 0.56569, 0.5869653, 0.6082, 0.6293456,
+              0.6503068, 0.6708752, 0.6908424, 0.71, 0.7281852, 0.7454636,
+              0.7619694, 0.7778368, 0.7932, 0.8081104, 0.8224962, 0.8363068,
+              0.8494916, 0.862, 0.8738108, 0.8849624, 0.8954936, 0.9054432,
+              0.9148501, 0.9237348, 0.9320924, 0.9399226, 0.9472252, 0.954,
+              0.9602561, 0.9660074, 0.9712606, 0.9760225, 0.9803, 0.9840924,
+              0.9874182, 0.9903128, 0.9928116, 0.9949501, 0.9967108, 0.9980983,
+              0.999112, 0.9997482, 1, 0.9998567, 0.9993046, 0.9983255,
+              0.9968987, 0.995, 0.9926005, 0.9897426, 0.9864444, 0.9827241,
+              0.9786, 0.9740837, 0.9691712, 0.9638568, 0.9581349, 0.952,
+              0.9454504, 0.9384992, 0.9311628, 0.9234576, 0.9154, 0.9070064,
+              0.8982772, 0.8892048, 0.8797816, 0.87, 0.8598613, 0.849392,
+              0.838622, 0.8275813, 0.8163, 0.8047947, 0.793082, 0.781192,
+              0.7691547, 0.757, 0.7447541, 0.7324224, 0.7200036, 0.7074965,
+              0.6949, 0.6822192, 0.6694716, 0.6566744, 0.6438448, 0.631,
+              0.6181555, 0.6053144, 0.5924756, 0.5796379, 0.5668, 0.5539611,
+              0.5411372, 0.5283528, 0.5156323, 0.503, 0.4904688, 0.4780304,
+              0.4656776, 0.4534032, 0.4412, 0.42908, 0.417036, 0.405032,
+              0.393032, 0.381, 0.3689184, 0.3568272, 0.3447768, 0.3328176,
+              0.321, 0.3093381, 0.2978504, 0.2865936, 0.2756245, 0.265,
+              0.2547632, 0.2448896, 0.2353344, 0.2260528, 0.217, 0.2081616,
+              0.1995488, 0.1911552, 0.1829744, 0.175, 0.1672235, 0.1596464,
+              0.1522776, 0.1451259, 0.1382, 0.1315003, 0.1250248, 0.1187792,
+              0.1127691, 0.107, 0.1014762, 0.0961886, 0.091123, 0.0862649,
+              0.0816, 0.0771206, 0.0728255, 0.0687101, 0.0647698, 0.061,
+              0.0573962, 0.053955, 0.0506738, 0.0475497, 0.04458, 0.0417587,
+              0.039085, 0.0365638, 0.0342005, 0.032, 0.0299626, 0.0280766,
+              0.0263294, 0.0247081, 0.0232, 0.0218008, 0.0205011, 0.0192811,
+              0.0181207, 0.017, 0.0159038, 0.0148372, 0.0138107, 0.0128348,
+              0.01192, 0.0110683, 0.0102734, 0.0095333, 0.0088462, 0.00821,
+              0.0076238, 0.0070854, 0.0065915, 0.0061385, 0.005723, 0.0053431,
+              0.0049958, 0.0046764, 0.0043801, 0.004102, 0.0038385, 0.0035891,
+              0.0033542, 0.0031341, 0.002929, 0.0027381, 0.0025599, 0.0023932,
+              0.0022373, 0.002091, 0.0019536, 0.0018246, 0.0017036, 0.0015902,
+              0.001484, 0.0013845, 0.0012913, 0.0012041, 0.0011227, 0.001047,
+              0.0009766, 0.0009111, 0.0008501, 0.0007932, 0.00074, 0.0006901,
+              0.0006433, 0.0005995, 0.0005585, 0.00052, 0.0004839, 0.0004501,
+              0.0004183, 0.0003887, 0.0003611, 0.0003354, 0.0003114, 0.0002892,
+              0.0002685, 0.0002492, 0.0002313, 0.0002147, 0.0001993, 0.000185,
+              0.0001719, 0.0001598, 0.0001486, 0.0001383, 0.0001288, 0.00012,
+              0.0001119, 0.0001043, 9.73E-05, 9.09E-05, 0.0000848, 7.92E-05,
+              7.39E-05, 6.89E-05, 6.43E-05, 0.00006, 5.60E-05, 5.22E-05,
+              4.87E-05, 4.55E-05, 0.0000424, 3.96E-05, 3.69E-05, 3.45E-05,
+              3.22E-05, 0.00003, 2.80E-05, 2.61E-05, 2.44E-05, 2.27E-05,
+              0.0000212, 1.98E-05, 1.85E-05, 1.72E-05, 1.61E-05, 1.50E-05,
+              1.40E-05, 1.31E-05, 1.22E-05, 1.14E-05, 0.0000106, 9.89E-06,
+              9.22E-06, 8.59E-06, 8.01E-06, 7.47E-06, 6.96E-06, 6.49E-06,
+              6.05E-06, 5.64E-06, 5.26E-06, 4.90E-06, 4.57E-06, 4.26E-06,
+              3.97E-06, 3.70E-06, 3.45E-06, 3.22E-06, 3.00E-06, 2.80E-06,
+              2.61E-06, 2.43E-06, 2.27E-06, 2.11E-06, 1.97E-06, 1.84E-06,
+              1.71E-06, 1.60E-06, 1.49E-06, 1.39E-06, 1.29E-06, 1.21E-06,
+              1.12E-06, 1.05E-06, 9.77E-07, 9.11E-07, 8.49E-07, 7.92E-07,
+              7.38E-07, 6.88E-07, 6.42E-07, 5.98E-07, 5.58E-07, 5.20E-07,
+              4.85E-07, 4.52E-07
+          },
+          // CIE 1931 2-degree Standard Observer (z-bar)
+          {
+              0.0006061, 0.0006809, 0.0007651, 0.00086, 0.0009666, 0.001086,
+              0.0012206, 0.0013727, 0.0015436, 0.0017343, 0.001946, 0.0021778,
+              0.0024358, 0.002732, 0.0030781, 0.003486, 0.0039752, 0.0045409,
+              0.0051583, 0.0058029, 0.00645, 0.0070832, 0.0077455, 0.0085012,
+              0.0094145, 0.01055, 0.0119658, 0.0136559, 0.0155881, 0.0177302,
+              0.02005, 0.0225114, 0.0252029, 0.0282797, 0.031897, 0.03621,
+              0.0414377, 0.0475037, 0.0541199, 0.060998, 0.06785, 0.0744863,
+              0.0813616, 0.0891536, 0.0985405, 0.1102, 0.1246133, 0.1417017,
+              0.1613035, 0.1832568, 0.2074, 0.2336921, 0.2626114, 0.2947746,
+              0.3307985, 0.3713, 0.4162091, 0.4654642, 0.5196948, 0.5795303,
+              0.6456, 0.7184838, 0.7967133, 0.8778459, 0.959439, 1.0390501,
+              1.1153673, 1.1884971, 1.2581233, 1.3239296, 1.3856, 1.4426352,
+              1.4948035, 1.5421903, 1.5848807, 1.62296, 1.6564048, 1.6852959,
+              1.7098745, 1.7303821, 1.74706, 1.7600446, 1.7696233, 1.7762637,
+              1.7804334, 1.7826, 1.7829682, 1.7816998, 1.7791982, 1.7758671,
+              1.77211, 1.7682589, 1.764039, 1.7589438, 1.7524663, 1.7441,
+              1.7335595, 1.7208581, 1.7059369, 1.6887372, 1.6692, 1.6475287,
+              1.6234127, 1.5960223, 1.564528, 1.5281, 1.4861114, 1.4395215,
+              1.3898799, 1.3387362, 1.28764, 1.2374223, 1.1878243, 1.1387611,
+              1.090148, 1.0419, 0.9941976, 0.9473473, 0.9014531, 0.8566193,
+              0.8129501, 0.7705173, 0.7294448, 0.6899136, 0.6521049, 0.6162,
+              0.5823286, 0.5504162, 0.5203376, 0.4919673, 0.46518, 0.4399246,
+              0.4161836, 0.3938822, 0.3729459, 0.3533, 0.3348578, 0.3175521,
+              0.3013375, 0.2861686, 0.272, 0.2588171, 0.2464838, 0.2347718,
+              0.2234533, 0.2123, 0.2011692, 0.1901196, 0.1792254, 0.1685608,
+              0.1582, 0.1481383, 0.1383758, 0.1289942, 0.1200751, 0.1117,
+              0.1039048, 0.0966675, 0.0899827, 0.0838453, 0.07825, 0.073209,
+              0.0686782, 0.0645678, 0.0607884, 0.05725, 0.0539044, 0.0507466,
+              0.0477528, 0.0448986, 0.04216, 0.0395073, 0.0369356, 0.0344584,
+              0.0320887, 0.02984, 0.0277118, 0.0256944, 0.0237872, 0.0219893,
+              0.0203, 0.0187181, 0.0172404, 0.0158636, 0.0145846, 0.0134,
+              0.0123072, 0.0113019, 0.0103779, 0.0095293, 0.00875, 0.0080352,
+              0.0073816, 0.0067854, 0.0062428, 0.00575, 0.0053036, 0.0048998,
+              0.0045342, 0.0042024, 0.0039, 0.0036232, 0.0033706, 0.0031414,
+              0.0029348, 0.00275, 0.0025852, 0.0024386, 0.0023094, 0.0021968,
+              0.0021, 0.0020177, 0.0019482, 0.0018898, 0.0018409, 0.0018,
+              0.0017663, 0.0017378, 0.0017112, 0.0016831, 0.00165, 0.0016101,
+              0.0015644, 0.0015136, 0.0014585, 0.0014, 0.0013367, 0.00127,
+              0.001205, 0.0011467, 0.0011, 0.0010688, 0.0010494, 0.0010356,
+              0.0010212, 0.001, 0.0009686, 0.0009299, 0.0008869, 0.0008426,
+              0.0008, 0.000761, 0.0007237, 0.0006859, 0.0006454, 0.0006,
+              0.0005479, 0.0004916, 0.0004354, 0.0003835, 0.00034, 0.0003073,
+              0.0002832, 0.0002654, 0.0002518, 0.00024, 0.0002295, 0.0002206,
+              0.000212, 0.0002022, 0.00019, 0.0001742, 0.0001556, 0.000136,
+              0.0001169, 0.0001, 8.61E-05, 0.0000746, 0.000065, 5.69E-05,
+              5.00E-05, 4.42E-05, 3.95E-05, 3.57E-05, 3.26E-05, 0.00003,
+              2.77E-05, 2.56E-05, 2.36E-05, 2.18E-05, 0.00002, 1.81E-05,
+              0.0000162, 0.0000142, 1.21E-05, 0.00001, 7.73E-06, 0.0000054,
+              0.0000032, 1.33E-06, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+          }
+      },
+      {
+          // CIE 1964 10-degree Standard Observer (x-bar)
+          {
+              0.000000122, 0.000000185, 0.000000279, 0.000000417, 0.000000621,
+              0.000000919, 0.000001352, 0.000001977, 0.000002872, 0.00000415,
+              0.000005959, 0.000008506, 0.000012069, 0.000017023, 0.000023868,
+              0.000033266, 0.000046087, 0.000063472, 0.000086892, 0.000118246,
+              0.000159952, 0.00021508, 0.00028749, 0.00038199, 0.00050455,
+              0.00066244, 0.0008645, 0.0011215, 0.00144616, 0.00185359,
+              0.0023616, 0.0029906, 0.0037645, 0.0047102, 0.0058581, 0.0072423,
+              0.0088996, 0.0108709, 0.0131989, 0.0159292, 0.0191097, 0.022788,
+              0.027011, 0.031829, 0.037278, 0.0434, 0.050223, 0.057764,
+              0.066038, 0.075033, 0.084736, 0.095041, 0.105836, 0.117066,
+              0.128682, 0.140638, 0.152893, 0.165416, 0.178191, 0.191214,
+              0.204492, 0.21765, 0.230267, 0.242311, 0.253793, 0.264737,
+              0.275195, 0.285301, 0.295143, 0.304869, 0.314679, 0.324355,
+              0.33357, 0.342243, 0.350312, 0.357719, 0.364482, 0.370493,
+              0.375727, 0.380158, 0.383734, 0.386327, 0.387858, 0.388396,
+              0.387978, 0.386726, 0.384696, 0.382006, 0.378709, 0.374915,
+              0.370702, 0.366089, 0.361045, 0.355518, 0.349486, 0.342957,
+              0.335893, 0.328284, 0.32015, 0.311475, 0.302273, 0.292858,
+              0.283502, 0.274044, 0.264263, 0.254085, 0.243392, 0.232187,
+              0.220488, 0.208198, 0.195618, 0.183034, 0.170222, 0.157348,
+              0.14465, 0.132349, 0.120584, 0.109456, 0.099042, 0.089388,
+              0.080507, 0.072034, 0.06371, 0.055694, 0.048117, 0.041072,
+              0.034642, 0.028896, 0.023876, 0.019628, 0.016172, 0.0133,
+              0.010759, 0.008542, 0.006661, 0.005132, 0.003982, 0.003239,
+              0.002934, 0.003114, 0.003816, 0.005095, 0.006936, 0.009299,
+              0.012147, 0.015444, 0.019156, 0.02325, 0.02769, 0.032444,
+              0.037465, 0.042956, 0.049114, 0.05592, 0.063349, 0.071358,
+              0.079901, 0.088909, 0.098293, 0.107949, 0.117749, 0.127839,
+              0.13845, 0.149516, 0.161041, 0.172953, 0.185209, 0.197755,
+              0.210538, 0.22346, 0.236491, 0.249633, 0.262972, 0.276515,
+              0.290269, 0.304213, 0.318361, 0.332705, 0.347232, 0.361926,
+              0.376772, 0.391683, 0.406594, 0.421539, 0.436517, 0.451584,
+              0.466782, 0.482147, 0.497738, 0.513606, 0.529826, 0.54644,
+              0.563426, 0.580726, 0.59829, 0.616053, 0.633948, 0.651901,
+              0.669824, 0.687632, 0.705224, 0.722773, 0.740483, 0.758273,
+              0.776083, 0.793832, 0.811436, 0.828822, 0.845879, 0.862525,
+              0.878655, 0.894208, 0.909206, 0.923672, 0.937638, 0.951162,
+              0.964283, 0.977068, 0.98959, 1.002, 1.014, 1.026, 1.039, 1.051,
+              1.063, 1.074, 1.085, 1.095, 1.104, 1.112, 1.119, 1.124, 1.128,
+              1.131, 1.133, 1.134, 1.134, 1.133, 1.131, 1.128, 1.124, 1.119,
+              1.113, 1.106, 1.098, 1.089, 1.079, 1.068, 1.057, 1.044, 1.03,
+              1.016, 1.001, 0.98479, 0.96808, 0.95074, 0.9328, 0.91434, 0.89539,
+              0.87603, 0.856297, 0.83635, 0.81629, 0.79605, 0.77561, 0.75493,
+              0.73399, 0.71278, 0.69129, 0.66952, 0.647467, 0.62511, 0.60252,
+              0.57989, 0.55737, 0.53511, 0.51324, 0.49186, 0.47108, 0.45096,
+              0.431567, 0.41287, 0.39475, 0.37721, 0.36019, 0.34369, 0.32769,
+              0.31217, 0.29711, 0.2825, 0.268329, 0.25459, 0.2413, 0.22848,
+              0.21614, 0.2043, 0.19295, 0.18211, 0.17177, 0.16192, 0.152568,
+              0.14367, 0.1352, 0.12713, 0.11948, 0.11221, 0.10531, 0.098786,
+              0.09261, 0.086773, 0.0812606, 0.076048, 0.071114, 0.066454,
+              0.062062, 0.05793, 0.05405, 0.050412, 0.047006, 0.043823,
+              0.0408508, 0.038072, 0.035468, 0.033031, 0.030753, 0.028623,
+              0.026635, 0.024781, 0.023052, 0.021441, 0.0199413, 0.018544,
+              0.017241, 0.016027, 0.014896, 0.013842, 0.012862, 0.011949,
+              0.0111, 0.010311, 0.00957688, 0.008894, 0.0082581, 0.0076664,
+              0.0071163, 0.0066052, 0.0061306, 0.0056903, 0.0052819, 0.0049033,
+              0.00455263, 0.0042275, 0.0039258, 0.0036457, 0.0033859, 0.0031447,
+              0.0029208, 0.002713, 0.0025202, 0.0023411, 0.00217496, 0.0020206,
+              0.0018773, 0.0017441, 0.0016205, 0.0015057, 0.0013992, 0.0013004,
+              0.0012087, 0.0011236, 0.00104476, 0.00097156, 0.0009036,
+              0.00084048, 0.00078187, 0.00072745, 0.0006769, 0.00062996,
+              0.00058637, 0.00054587, 0.000508258, 0.0004733, 0.0004408,
+              0.00041058, 0.00038249, 0.00035638, 0.00033211, 0.00030955,
+              0.00028858, 0.00026909, 0.000250969, 0.00023413, 0.00021847,
+              0.00020391, 0.00019035, 0.00017773, 0.00016597, 0.00015502,
+              0.0001448, 0.00013528, 0.00012639, 0.0001181, 0.00011037,
+              0.00010315, 0.000096427, 0.000090151, 0.000084294, 0.00007883,
+              0.000073729, 0.000068969, 0.000064526, 0.000060376, 0.0000565,
+              0.00005288, 0.000049498, 0.000046339, 0.000043389, 0.000040634,
+              0.00003806, 0.000035657, 0.000033412, 0.000031315, 0.000029355,
+              0.000027524, 0.000025811, 0.000024209, 0.000022711, 0.000021308,
+              0.000019994, 0.000018764, 0.000017612, 0.000016532, 0.000015521,
+              0.000014574, 0.000013686, 0.000012855, 0.000012075, 0.000011345,
+              0.000010659, 0.000010017, 0.000009414, 0.000008848, 0.000008317,
+              0.000007819, 0.000007352, 0.000006913, 0.000006502, 0.000006115,
+              0.000005753, 0.000005413, 0.000005093, 0.000004794, 0.000004512,
+              0.000004248, 0.000004, 0.000003767, 0.000003548, 0.000003342,
+              0.000003148, 0.000002966, 0.000002795, 0.000002634, 0.000002483,
+              0.000002341, 0.000002208, 0.000002082, 0.000001964, 0.000001852,
+              0.000001746, 0.000001647, 0.000001553
+          },
+          // CIE 1964 10-degree Standard Observer (y-bar)
+          {
+              0.000000013, 0.00000002, 0.000000031, 0.000000046, 0.000000068,
+              0.000000101, 0.000000148, 0.000000216, 0.000000314, 0.000000454,
+              0.000000651, 0.000000929, 0.000001318, 0.000001857, 0.000002602,
+              0.000003625, 0.000005019, 0.000006907, 0.000009449, 0.000012848,
+              0.000017364, 0.000023327, 0.00003115, 0.00004135, 0.00005456,
+              0.00007156, 0.0000933, 0.00012087, 0.00015564, 0.0001992,
+              0.0002534, 0.0003202, 0.0004024, 0.0005023, 0.0006232, 0.0007685,
+              0.0009417, 0.0011478, 0.0013903, 0.001674, 0.0020044, 0.002386,
+              0.002822, 0.003319, 0.00388, 0.004509, 0.005209, 0.005985,
+              0.006833, 0.007757, 0.008756, 0.009816, 0.010918, 0.012058,
+              0.013237, 0.014456, 0.015717, 0.017025, 0.018399, 0.019848,
+              0.021391, 0.022992, 0.024598, 0.026213, 0.027841, 0.029497,
+              0.031195, 0.032927, 0.034738, 0.036654, 0.038676, 0.040792,
+              0.042946, 0.045114, 0.047333, 0.049602, 0.051934, 0.054337,
+              0.056822, 0.059399, 0.062077, 0.064737, 0.067285, 0.069764,
+              0.072218, 0.074704, 0.077272, 0.079979, 0.082874, 0.086, 0.089456,
+              0.092947, 0.096275, 0.099535, 0.102829, 0.106256, 0.109901,
+              0.113835, 0.118167, 0.122932, 0.128201, 0.133457, 0.138323,
+              0.143042, 0.147787, 0.152761, 0.158102, 0.163941, 0.170362,
+              0.177425, 0.18519, 0.193025, 0.200313, 0.207156, 0.213644,
+              0.21994, 0.22617, 0.232467, 0.239025, 0.245997, 0.253589,
+              0.261876, 0.270643, 0.279645, 0.288694, 0.297665, 0.306469,
+              0.315035, 0.323335, 0.331366, 0.339133, 0.34786, 0.358326,
+              0.370001, 0.382464, 0.395379, 0.408482, 0.421588, 0.434619,
+              0.447601, 0.460777, 0.47434, 0.4882, 0.50234, 0.51674, 0.53136,
+              0.54619, 0.56118, 0.57629, 0.5915, 0.606741, 0.62215, 0.63783,
+              0.65371, 0.66968, 0.68566, 0.70155, 0.71723, 0.73257, 0.74746,
+              0.761757, 0.77534, 0.78822, 0.80046, 0.81214, 0.82333, 0.83412,
+              0.8446, 0.85487, 0.86504, 0.875211, 0.88537, 0.89537, 0.90515,
+              0.91465, 0.92381, 0.93255, 0.94081, 0.94852, 0.9556, 0.961988,
+              0.96754, 0.97223, 0.97617, 0.97946, 0.9822, 0.98452, 0.98652,
+              0.98832, 0.99002, 0.991761, 0.99353, 0.99523, 0.99677, 0.99809,
+              0.99911, 0.99977, 1, 0.99971, 0.99885, 0.99734, 0.99526, 0.99274,
+              0.98975, 0.9863, 0.98238, 0.97798, 0.97311, 0.96774, 0.96189,
+              0.955552, 0.948601, 0.940981, 0.932798, 0.924158, 0.915175,
+              0.905954, 0.896608, 0.887249, 0.877986, 0.868934, 0.860164,
+              0.851519, 0.842963, 0.834393, 0.825623, 0.816764, 0.807544,
+              0.797947, 0.787893, 0.777405, 0.76649, 0.755309, 0.743845,
+              0.73219, 0.720353, 0.708281, 0.696055, 0.683621, 0.671048,
+              0.658341, 0.645545, 0.632718, 0.619815, 0.606887, 0.593878,
+              0.580781, 0.567653, 0.55449, 0.541228, 0.527963, 0.514634,
+              0.501363, 0.488124, 0.474935, 0.461834, 0.448823, 0.435917,
+              0.423153, 0.410526, 0.398057, 0.385835, 0.373951, 0.362311,
+              0.350863, 0.339554, 0.328309, 0.317118, 0.305936, 0.294737,
+              0.283493, 0.272222, 0.26099, 0.249877, 0.238946, 0.228254,
+              0.217853, 0.20778, 0.198072, 0.188748, 0.179828, 0.171285,
+              0.163059, 0.155151, 0.147535, 0.140211, 0.13317, 0.1264, 0.119892,
+              0.11364, 0.107633, 0.10187, 0.096347, 0.091063, 0.08601, 0.081187,
+              0.076583, 0.072198, 0.068024, 0.064052, 0.060281, 0.056697,
+              0.053292, 0.050059, 0.046998, 0.044096, 0.041345, 0.0387507,
+              0.0362978, 0.0339832, 0.0318004, 0.0297395, 0.0277918, 0.0259551,
+              0.0242263, 0.0226017, 0.0210779, 0.0196505, 0.0183153, 0.0170686,
+              0.0159051, 0.0148183, 0.0138008, 0.0128495, 0.0119607, 0.0111303,
+              0.0103555, 0.0096332, 0.0089599, 0.0083324, 0.0077488, 0.0072046,
+              0.0066975, 0.0062251, 0.005785, 0.0053751, 0.0049941, 0.0046392,
+              0.0043093, 0.0040028, 0.00371774, 0.00345262, 0.00320583,
+              0.00297623, 0.00276281, 0.00256456, 0.00238048, 0.00220971,
+              0.00205132, 0.00190449, 0.00176847, 0.00164236, 0.00152535,
+              0.00141672, 0.00131595, 0.00122239, 0.00113555, 0.00105494,
+              0.00098014, 0.00091066, 0.00084619, 0.00078629, 0.00073068,
+              0.00067899, 0.00063101, 0.00058644, 0.00054511, 0.00050672,
+              0.00047111, 0.00043805, 0.00040741, 0.000378962, 0.000352543,
+              0.000328001, 0.000305208, 0.000284041, 0.000264375, 0.000246109,
+              0.000229143, 0.000213376, 0.00019873, 0.000185115, 0.000172454,
+              0.000160678, 0.00014973, 0.00013955, 0.000130086, 0.00012129,
+              0.000113106, 0.000105501, 0.000098428, 0.000091853, 0.000085738,
+              0.000080048, 0.000074751, 0.000069819, 0.000065222, 0.000060939,
+              0.000056942, 0.000053217, 0.000049737, 0.000046491, 0.000043464,
+              0.000040635, 0.000038, 0.00003554, 0.000033245, 0.000031101,
+              0.000029099, 0.000027231, 0.000025486, 0.000023856, 0.000022333,
+              0.00002091, 0.000019581, 0.000018338, 0.000017178, 0.000016093,
+              0.00001508, 0.000014134, 0.000013249, 0.000012423, 0.00001165,
+              0.000010928, 0.000010252, 0.00000962, 0.000009028, 0.000008474,
+              0.000007955, 0.000007469, 0.000007013, 0.000006586, 0.000006186,
+              0.000005811, 0.000005459, 0.00000513, 0.000004821, 0.000004531,
+              0.000004259, 0.000004004, 0.000003765, 0.00000354, 0.000003329,
+              0.000003131, 0.000002945, 0.000002771, 0.000002607, 0.000002453,
+              0.000002309, 0.000002173, 0.000002046, 0.000001927, 0.000001814,
+              0.000001709, 0.00000161, 0.000001517, 0.000001429, 0.000001347,
+              0.000001269, 0.000001197, 0.000001128, 0.000001064, 0.000001003,
+              0.000000946, 0.000000893, 0.000000842, 0.000000795, 0.00000075,
+              0.000000707, 0.000000667, 0.00000063
+          },
+          // CIE 1964 10-degree Standard Observer (z-bar)
+          {
+              0.000000535, 0.000000811, 0.000001221, 0.000001829, 0.000002722,
+              0.000004028, 0.000005926, 0.000008665, 0.000012596, 0.000018201,
+              0.000026144, 0.00003733, 0.000052987, 0.000074764, 0.00010487,
+              0.00014622, 0.00020266, 0.00027923, 0.00038245, 0.00052072,
+              0.000704776, 0.00094823, 0.0012682, 0.0016861, 0.0022285,
+              0.0029278, 0.0038237, 0.0049642, 0.0064067, 0.0082193, 0.0104822,
+              0.013289, 0.016747, 0.02098, 0.026127, 0.032344, 0.039802,
+              0.048691, 0.05921, 0.071576, 0.0860109, 0.10274, 0.122, 0.14402,
+              0.16899, 0.19712, 0.22857, 0.26347, 0.3019, 0.34387, 0.389366,
+              0.43797, 0.48922, 0.5429, 0.59881, 0.65676, 0.71658, 0.77812,
+              0.84131, 0.90611, 0.972542, 1.039, 1.103, 1.165, 1.225, 1.282,
+              1.338, 1.393, 1.446, 1.499, 1.553, 1.607, 1.659, 1.708, 1.755,
+              1.798, 1.839, 1.877, 1.91, 1.941, 1.967, 1.989, 2.006, 2.017,
+              2.024, 2.027, 2.026, 2.022, 2.015, 2.006, 1.995, 1.981, 1.965,
+              1.946, 1.925, 1.901, 1.874, 1.845, 1.814, 1.781, 1.745, 1.709,
+              1.672, 1.635, 1.596, 1.555, 1.512, 1.467, 1.42, 1.37, 1.318,
+              1.262, 1.205, 1.147, 1.088, 1.03, 0.97383, 0.91943, 0.86746,
+              0.81828, 0.772125, 0.72829, 0.68604, 0.64553, 0.60685, 0.57006,
+              0.53522, 0.50234, 0.4714, 0.44239, 0.415254, 0.390024, 0.366399,
+              0.344015, 0.322689, 0.302356, 0.283036, 0.264816, 0.247848,
+              0.232318, 0.218502, 0.205851, 0.193596, 0.181736, 0.170281,
+              0.159249, 0.148673, 0.138609, 0.129096, 0.120215, 0.112044,
+              0.10471, 0.098196, 0.092361, 0.087088, 0.082248, 0.077744,
+              0.073456, 0.069268, 0.06506, 0.060709, 0.056457, 0.052609,
+              0.049122, 0.045954, 0.04305, 0.040368, 0.037839, 0.035384,
+              0.032949, 0.030451, 0.028029, 0.025862, 0.02392, 0.022174,
+              0.020584, 0.019127, 0.01774, 0.016403, 0.015064, 0.013676,
+              0.012308, 0.011056, 0.009915, 0.008872, 0.007918, 0.00703,
+              0.006223, 0.005453, 0.004714, 0.003988, 0.003289, 0.002646,
+              0.002063, 0.001533, 0.001091, 0.000711, 0.000407, 0.000184,
+              0.000047, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+              0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+          }
+      }
+  };
 };
-}
+}  // namespace color
@@ -8,4 +8,7 @@
 #pragma once
 
 #include "imgs/color/cie/CIE.h"
+#include "imgs/color/hyperspectral/HyperspectralRenderer.h"
+#include "imgs/color/spectrum/SpectralIntegrator.h"
+#include "imgs/color/spectrum/SpectralLibrary.h"
 #include "imgs/color/spectrum/Spectrum.h"
\ No newline at end of file
@@ -0,0 +1,258 @@
+/** Implementation file for hyperspectral cube to sRGB rendering
+ *
+ * \file imgs/color/hyperspectral/HyperspectralRenderer.cpp
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "imgs/color/hyperspectral/HyperspectralRenderer.h"
+
+#include "imgs/color/spectrum/SpectralIntegrator.h"
+
+using namespace std;
+
+namespace color {
+
+namespace {
+
+// Intervals of the encoding table for each destination depth, enough that
+// interpolating it stays within 0.005 (8-bit) and 0.04 (16-bit) counts of
+// the exact transfer function
+const int kEncodeSize8U = 4096;
+const int kEncodeSize16U = 65536;
+
+using TileMatrix = Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
+// Pixels x bands views of a slab of samples (pixel rows adjacent for band
+// interleaved by pixel, band columns adjacent otherwise)
+using PixelMajorMap =
+    Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>,
+               0, Eigen::OuterStride<>>;
+using BandMajorMap =
+    Eigen::Map<const Eigen::MatrixXf, 0, Eigen::OuterStride<>>;
+
+size_t SampleSize(int depth) {
+  switch (depth) {
+    case CV_8U:
+      return 1;
+    case CV_16U:
+    case CV_16S:
+      return 2;
+    case CV_32F:
+      return 4;
+    case CV_64F:
+      return 8;
+    default:
+      throw runtime_error(
+          "Cube samples must be of type CV_8U, CV_16U, CV_16S, CV_32F, or "
+          "CV_64F");
+  }
+}
+
+template <typename T>
+void ConvertSamples(const uint8_t* src, size_t n, float* dst) {
+  const T* p = reinterpret_cast<const T*>(src);
+  for (size_t idx = 0; idx < n; idx++) {
+    dst[idx] = static_cast<float>(p[idx]);
+  }
+}
+
+void Convert(const uint8_t* src, int depth, size_t n, float* dst) {
+  switch (depth) {
+    case CV_8U:
+      ConvertSamples<uint8_t>(src, n, dst);
+      break;
+    case CV_16U:
+      ConvertSamples<uint16_t>(src, n, dst);
+      break;
+    case CV_16S:
+      ConvertSamples<int16_t>(src, n, dst);
+      break;
+    case CV_32F:
+      ConvertSamples<float>(src, n, dst);
+      break;
+    default:
+      ConvertSamples<double>(src, n, dst);
+      break;
+  }
+}
+
+/* Encode the linear RGB of a slab into BGR destination pixels
+ */
+template <typename T>
+void EncodeSlab(const TileMatrix& rgb, const vector<float>& encode, T* dst) {
+  const float* table = encode.data();
+  int intervals = static_cast<int>(encode.size()) - 1;
+  for (Eigen::Index p = 0; p < rgb.rows(); p++) {
+    for (int k = 0; k < 3; k++) {
+      float v = min(max(rgb(p, k), 0.0f), 1.0f) * intervals;
+      int idx = min(static_cast<int>(v), intervals - 1);
+      float value = table[idx] + (v - idx) * (table[idx + 1] - table[idx]);
+      dst[3 * p + 2 - k] = static_cast<T>(value + 0.5f);
+    }
+  }
+}
+
+}  // namespace
+
+Interleave ParseInterleave(const string& name) {
+  string lower = name;
+  transform(lower.begin(), lower.end(), lower.begin(),
+            [](unsigned char c) { return tolower(c); });
+  if (lower == "bip") {
+    return Interleave::bip;
+  } else if (lower == "bil") {
+    return Interleave::bil;
+  } else if (lower == "bsq") {
+    return Interleave::bsq;
+  }
+  throw runtime_error("Invalid interleave provided: " + name);
+}
+
+HyperspectralRenderer::HyperspectralRenderer(
+    const Eigen::VectorXd& wavelengths, int illuminant, int observer,
+    double scale, int depth, int tile_rows)
+    : depth_(depth), tile_rows_(tile_rows) {
+  if ((depth != CV_8U) && (depth != CV_16U)) {
+    throw runtime_error("Rendered image depth must be CV_8U or CV_16U");
+  }
+  if (tile_rows < 1) {
+    throw runtime_error("Rows per tile must be positive");
+  }
+
+  // XYZ to linear sRGB (as in Spectrum::srgb)
+  Eigen::Matrix3d transform;
+  transform << 3.2404542, -1.5371385, -0.4985314, -0.9692660, 1.8760108,
+      0.0415560, 0.0556434, -0.2040259, 1.0572252;
+
+  auto integrator = SpectralIntegrator::Get(wavelengths, illuminant, observer);
+  weights_ =
+      (scale * transform * integrator->weights()).transpose().cast<float>();
+
+  double max_value = (depth == CV_8U) ? 255 : 65535;
+  int intervals = (depth == CV_8U) ? kEncodeSize8U : kEncodeSize16U;
+  encode_.resize(intervals + 1);
+  for (int idx = 0; idx <= intervals; idx++) {
+    double v = static_cast<double>(idx) / intervals;
+    v = (v <= 0.0031308) ? 12.92 * v : 1.055 * std::pow(v, 1 / 2.4) - 0.055;
+    encode_[idx] = static_cast<float>(v * max_value);
+  }
+}
+
+cv::Mat HyperspectralRenderer::Render(const void* data,
+                                      const CubeLayout& layout) const {
+  if ((layout.rows <= 0) || (layout.cols <= 0) || (layout.bands <= 0)) {
+    throw runtime_error("Cube dimensions must be positive");
+  }
+  if (layout.bands != bands()) {
+    throw runtime_error(
+        "Cube band count must match the renderer's wavelength count");
+  }
+  size_t sample_size = SampleSize(layout.depth);
+  if (reinterpret_cast<uintptr_t>(data) % sample_size != 0) {
+    throw runtime_error("Cube samples must be aligned to their size");
+  }
+
+  const uint8_t* cube = static_cast<const uint8_t*>(data);
+  const int rows = layout.rows;
+  const int cols = layout.cols;
+  const int bands = layout.bands;
+  const Interleave interleave = layout.interleave;
+
+  cv::Mat dst(rows, cols, CV_MAKETYPE(depth_, 3));
+
+  int tiles = (rows + tile_rows_ - 1) / tile_rows_;
+  cv::parallel_for_(cv::Range(0, tiles), [&](const cv::Range& range) {
+    vector<float> buffer;
+    TileMatrix rgb;
+    for (int tile = range.start; tile < range.end; tile++) {
+      int r0 = tile * tile_rows_;
+      int r1 = min(r0 + tile_rows_, rows);
+
+      // A band interleaved by line tile is a stack of per-row slabs, the
+      // other interleaves are a single slab of pixels
+      int slab_rows = (interleave == Interleave::bil) ? 1 : r1 - r0;
+      for (int r = r0; r < r1; r += slab_rows) {
+        size_t p0 = static_cast<size_t>(r) * cols;
+        Eigen::Index pixels = static_cast<Eigen::Index>(slab_rows) * cols;
+
+        // First sample of the slab and the sample distance between bands
+        size_t first;
+        size_t band_stride;
+        switch (interleave) {
+          case Interleave::bip:
+            first = p0 * bands;
+            band_stride = 1;
+            break;
+          case Interleave::bil:
+            first = p0 * bands;
+            band_stride = cols;
+            break;
+          default:
+            first = p0;
+            band_stride = static_cast<size_t>(rows) * cols;
+            break;
+        }
+        const uint8_t* src = cube + first * sample_size;
+
+        if (interleave == Interleave::bip) {
+          const float* samples = reinterpret_cast<const float*>(src);
+          if (layout.depth != CV_32F) {
+            buffer.resize(pixels * bands);
+            Convert(src, layout.depth, buffer.size(), buffer.data());
+            samples = buffer.data();
+          }
+          rgb.noalias() = PixelMajorMap(samples, pixels, bands,
+                                        Eigen::OuterStride<>(bands)) *
+                          weights_;
+        } else {
+          const float* samples = reinterpret_cast<const float*>(src);
+          Eigen::Index outer = band_stride;
+          if (layout.depth != CV_32F) {
+            buffer.resize(pixels * bands);
+            for (int b = 0; b < bands; b++) {
+              Convert(src + b * band_stride * sample_size, layout.depth,
+                      pixels, buffer.data() + b * pixels);
+            }
+            samples = buffer.data();
+            outer = pixels;
+          }
+          rgb.noalias() = BandMajorMap(samples, pixels, bands,
+                                       Eigen::OuterStride<>(outer)) *
+                          weights_;
+        }
+
+        if (depth_ == CV_8U) {
+          EncodeSlab(rgb, encode_, dst.ptr<uint8_t>(r));
+        } else {
+          EncodeSlab(rgb, encode_, dst.ptr<uint16_t>(r));
+        }
+      }
+    }
+  });
+
+  return dst;
+}
+
+cv::Mat HyperspectralRenderer::Render(const string& filename,
+                                      const CubeLayout& layout) const {
+  boost::iostreams::mapped_file_source file(filename);
+  if (!file.is_open()) {
+    throw runtime_error("Unable to map cube file: " + filename);
+  }
+  size_t samples = static_cast<size_t>(layout.rows) * layout.cols *
+                   layout.bands;
+  if (file.size() < layout.offset + samples * SampleSize(layout.depth)) {
+    throw runtime_error("Cube file " + filename +
+                        " is too small for the provided layout");
+  }
+  return Render(file.data() + layout.offset, layout);
+}
+}  // namespace color
@@ -0,0 +1,124 @@
+/** Interface file for hyperspectral cube to sRGB rendering
+ *
+ * \file imgs/color/hyperspectral/HyperspectralRenderer.h
+ *
+ * \description
+ *   Renders a rows x cols x bands cube of reflectance spectra to an 8- or
+ *   16-bit BGR image.  The cube is streamed in tiles of whole rows that are
+ *   processed in parallel: each tile is viewed (or, for non-float samples,
+ *   converted) as a pixels x bands matrix and projected to linear sRGB with
+ *   one matrix product against a bands x 3 weighting matrix.  That matrix
+ *   folds the CIE illuminant, the color matching functions, the XYZ
+ *   normalization, the sample scale, and the XYZ to linear sRGB matrix of
+ *   Spectrum::srgb together.  The piecewise sRGB encoding (with clipping to
+ *   [0, 1]) is an interpolated table.
+ *
+ *   Beyond the destination image, memory use is bounded by one tile per
+ *   thread, and cubes in files are memory mapped rather than read.
+ *
+ *   Supported interleaves
+ *     bip   band interleaved by pixel (all bands of a pixel are adjacent)
+ *     bil   band interleaved by line (each row holds one line per band)
+ *     bsq   band sequential (one complete image per band)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
+#include <opencv2/core.hpp>
+
+#include "imgs/color/cie/CIE.h"
+
+namespace color {
+
+/** Sample interleave of a hyperspectral cube
+ */
+enum class Interleave { bip, bil, bsq };
+
+/** Parse an interleave name
+ *
+ * \param[in] name   one of 'bip', 'bil', or 'bsq' (case insensitive)
+ *
+ * \return           the interleave
+ */
+Interleave ParseInterleave(const std::string& name);
+
+/** Storage of a hyperspectral cube (samples are in native byte order and
+ *  aligned to their size)
+ */
+struct CubeLayout {
+  int rows = 0;
+  int cols = 0;
+  int bands = 0;
+  Interleave interleave = Interleave::bip;
+
+  /* Sample type: CV_8U, CV_16U, CV_16S, CV_32F, or CV_64F */
+  int depth = CV_32F;
+
+  /* Bytes preceding the first sample (files only) */
+  size_t offset = 0;
+};
+
+class HyperspectralRenderer {
+ public:
+  /* Constructor
+   *
+   * \param[in] wavelengths   center wavelength of each band [nm], within
+   *                          the CIE data range [360, 830]
+   * \param[in] illuminant    CIE reference illuminant [default is D65]
+   * \param[in] observer      CIE standard observer [default is 10 degree]
+   * \param[in] scale         multiplier taking samples to unit reflectance
+   *                          (e.g. 0.01 for percent) [default is 1]
+   * \param[in] depth         destination depth, CV_8U or CV_16U [default is
+   *                          CV_8U]
+   * \param[in] tile_rows     rows per tile [default is 16]
+   */
+  HyperspectralRenderer(const Eigen::VectorXd& wavelengths,
+                        int illuminant = CIE::ReferenceIlluminant::d65,
+                        int observer = CIE::StandardObserver::ten_deg,
+                        double scale = 1.0, int depth = CV_8U,
+                        int tile_rows = 16);
+
+  // Getters
+  int bands() const { return static_cast<int>(weights_.rows()); }
+  int depth() const { return depth_; }
+  int tile_rows() const { return tile_rows_; }
+
+  /* Bands x 3 weights taking a spectrum to linear sRGB (R, G, B columns)
+   */
+  const Eigen::Matrix<float, Eigen::Dynamic, 3>& weights() const {
+    return weights_;
+  }
+
+  /* Render a cube held in memory
+   *
+   * \param[in] data     first sample of the cube
+   * \param[in] layout   cube storage (the offset is ignored)
+   *
+   * \return             rendered BGR image of the destination depth
+   */
+  cv::Mat Render(const void* data, const CubeLayout& layout) const;
+
+  /* Render a headerless cube file (memory mapped)
+   *
+   * \param[in] filename   cube filename
+   * \param[in] layout     cube storage
+   *
+   * \return               rendered BGR image of the destination depth
+   */
+  cv::Mat Render(const std::string& filename, const CubeLayout& layout) const;
+
+ private:
+  Eigen::Matrix<float, Eigen::Dynamic, 3> weights_;
+
+  // Encoded destination value at uniformly spaced linear values in [0, 1]
+  std::vector<float> encode_;
+
+  int depth_;
+  int tile_rows_;
+};
+}  // namespace color
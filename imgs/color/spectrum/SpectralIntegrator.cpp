@@ -0,0 +1,89 @@
+/** Implementation file for batched spectrum to CIE XYZ integration
+ *
+ * \file imgs/color/spectrum/SpectralIntegrator.cpp
+ */
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "imgs/color/spectrum/SpectralIntegrator.h"
+
+#include "imgs/numerical/interpolation/interpolation.h"
+
+using namespace std;
+
+namespace color {
+
+SpectralIntegrator::SpectralIntegrator(const Eigen::VectorXd& wavelengths,
+                                       int illuminant, int observer)
+    : wavelengths_(wavelengths) {
+  if (wavelengths.size() == 0) {
+    throw runtime_error("Spectral integration requires wavelengths");
+  }
+
+  // Illuminant and color matching functions on the provided grid (the CIE
+  // tables are used directly when the grid is one of their sampling
+  // intervals)
+  Eigen::VectorXd ill;
+  Eigen::MatrixXd cmf;
+  double step = (wavelengths.size() > 1) ? wavelengths(1) - wavelengths(0) : 1;
+  int interval = static_cast<int>(step);
+  if ((interval >= 1) && (interval == step) &&
+      (wavelengths.size() == CIE::samples(interval)) &&
+      (wavelengths.array() == CIE::wavelengths(interval).array()).all()) {
+    ill = CIE::reference_illuminant(illuminant, interval);
+    cmf = CIE::standard_observer(observer, interval);
+  } else {
+    // The intervals are located once for all four functions
+    numerical::Interp1Plan plan(wavelengths, CIE::wavelengths());
+    ill = plan.Apply(CIE::reference_illuminant(illuminant));
+    cmf = plan.ApplyColumns(CIE::standard_observer(observer));
+  }
+
+  // Fold the illuminant and the normalizing factor into the weights
+  double n = ill.dot(cmf.col(1));
+  weights_ = (cmf.array().colwise() * ill.array()).matrix().transpose() / n;
+}
+
+shared_ptr<const SpectralIntegrator> SpectralIntegrator::Get(
+    const Eigen::VectorXd& wavelengths, int illuminant, int observer) {
+  using Key = tuple<int, int, vector<double>>;
+  static map<Key, shared_ptr<const SpectralIntegrator>> cache;
+  static mutex cache_mutex;
+
+  Key key(illuminant, observer,
+          vector<double>(wavelengths.data(),
+                         wavelengths.data() + wavelengths.size()));
+
+  lock_guard<mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    auto integrator = make_shared<const SpectralIntegrator>(
+        wavelengths, illuminant, observer);
+    it = cache.emplace(move(key), integrator).first;
+  }
+  return it->second;
+}
+
+Eigen::Vector3d SpectralIntegrator::xyz(
+    const Eigen::VectorXd& spectrum) const {
+  if (spectrum.size() != wavelengths_.size()) {
+    throw runtime_error(
+        "Spectrum and integrator wavelength counts must match");
+  }
+  return weights_ * spectrum;
+}
+
+Eigen::Matrix3Xd SpectralIntegrator::batch_xyz(
+    const Eigen::MatrixXd& spectra) const {
+  if (spectra.rows() != wavelengths_.size()) {
+    throw runtime_error(
+        "Spectra rows and integrator wavelength counts must match");
+  }
+  return weights_ * spectra;
+}
+}  // namespace color
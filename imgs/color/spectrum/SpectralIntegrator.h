@@ -0,0 +1,62 @@
+/** Interface file for batched spectrum to CIE XYZ integration
+ *
+ * \file imgs/color/spectrum/SpectralIntegrator.h
+ *
+ * \description
+ *   The tristimulus integrals of a spectrum sampled on a fixed wavelength
+ *   grid are a linear map, so the illuminant, the color matching functions,
+ *   and the normalization (the sum of illuminant times y-bar) are folded
+ *   once into a 3 x N weighting matrix W.  A single spectrum is then one
+ *   matrix-vector product and M spectra (the columns of an N x M matrix) are
+ *   one matrix product W * S.
+ *
+ *   Weighting matrices are cached per (wavelength grid, illuminant,
+ *   observer).
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <eigen3/Eigen/Dense>
+
+#include "imgs/color/cie/CIE.h"
+
+namespace color {
+
+class SpectralIntegrator {
+ public:
+  /* Constructor (grids matching a CIE sampling interval use the tables
+   * directly, otherwise the CIE data are linearly interpolated to the
+   * provided wavelengths, which must lie within [360, 830] nm)
+   */
+  SpectralIntegrator(const Eigen::VectorXd& wavelengths,
+                     int illuminant = CIE::ReferenceIlluminant::d65,
+                     int observer = CIE::StandardObserver::ten_deg);
+
+  /* Cached integrator for the provided wavelength grid, illuminant, and
+   * observer (thread safe)
+   */
+  static std::shared_ptr<const SpectralIntegrator> Get(
+      const Eigen::VectorXd& wavelengths,
+      int illuminant = CIE::ReferenceIlluminant::d65,
+      int observer = CIE::StandardObserver::ten_deg);
+
+  // Getters
+  const Eigen::VectorXd& wavelengths() const { return wavelengths_; }
+  const Eigen::Matrix3Xd& weights() const { return weights_; }
+
+  /* XYZ of a single spectrum sampled on the integrator's wavelengths
+   */
+  Eigen::Vector3d xyz(const Eigen::VectorXd& spectrum) const;
+
+  /* XYZ (3 x M) of the M spectra held in the columns of an N x M matrix
+   * (for spectra held in rows, spectra * weights().transpose() gives M x 3)
+   */
+  Eigen::Matrix3Xd batch_xyz(const Eigen::MatrixXd& spectra) const;
+
+ private:
+  Eigen::VectorXd wavelengths_;
+  Eigen::Matrix3Xd weights_;
+};
+}  // namespace color
@@ -0,0 +1,194 @@
+/** Implementation file for binary spectral libraries
+ *
+ * \file imgs/color/spectrum/SpectralLibrary.cpp
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "imgs/color/spectrum/SpectralLibrary.h"
+
+#include "imgs/utils/file/csvfile/CsvTable.h"
+
+using namespace std;
+
+namespace color {
+
+namespace {
+
+const char kMagic[8] = {'R', 'I', 'T', 'S', 'P', 'L', 'I', 'B'};
+const uint32_t kVersion = 1;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t type;
+  uint64_t bands;
+  uint64_t count;
+  uint64_t names_size;
+  char reserved[24];
+};
+static_assert(sizeof(Header) == 64, "Spectral library header is 64 bytes");
+
+}  // namespace
+
+SpectralLibrary::SpectralLibrary(const string& filename) {
+  if (!IsLibrary(filename)) {
+    throw runtime_error("Specified file is not a spectral library: " +
+                        filename);
+  }
+
+  file_.open(filename);
+  Header header;
+  memcpy(&header, file_.data(), sizeof(header));
+  if (header.version != kVersion) {
+    throw runtime_error("Unsupported spectral library version");
+  }
+  if ((header.type != static_cast<uint32_t>(Type::float32)) &&
+      (header.type != static_cast<uint32_t>(Type::float64))) {
+    throw runtime_error("Unsupported spectral library value type");
+  }
+
+  // Each section is checked against the bytes left (by division, so that a
+  // corrupt header cannot overflow the offsets) before any offset is formed
+  uint64_t remaining = file_.size() - sizeof(Header);
+  if (header.bands > remaining / sizeof(double)) {
+    throw runtime_error("Spectral library size does not match its header");
+  }
+  remaining -= header.bands * sizeof(double);
+  if ((header.bands > 0) &&
+      (header.count > remaining / (header.bands * header.type))) {
+    throw runtime_error("Spectral library size does not match its header");
+  }
+  remaining -= header.count * header.bands * header.type;
+  if (header.names_size != remaining) {
+    throw runtime_error("Spectral library size does not match its header");
+  }
+
+  type_ = static_cast<Type>(header.type);
+  bands_ = static_cast<Eigen::Index>(header.bands);
+  count_ = header.count;
+  uint64_t values_offset = sizeof(Header) + header.bands * sizeof(double);
+  uint64_t names_offset = values_offset + header.count * header.bands *
+                                              header.type;
+
+  wavelengths_ = reinterpret_cast<const double*>(file_.data() + sizeof(Header));
+  values_ = file_.data() + values_offset;
+
+  const char* p = file_.data() + names_offset;
+  const char* end = p + header.names_size;
+  while (p < end) {
+    const char* eol = find(p, end, '\n');
+    names_.emplace_back(p, eol);
+    p = eol + (eol < end);
+  }
+  if (!names_.empty() && (names_.size() != count_)) {
+    throw runtime_error(
+        "Spectral library name count does not match its header");
+  }
+}
+
+bool SpectralLibrary::IsLibrary(const string& filename) {
+  if (!filesystem::exists(filename) ||
+      (filesystem::file_size(filename) < sizeof(Header))) {
+    return false;
+  }
+  char magic[sizeof(kMagic)];
+  ifstream f(filename, ios::binary);
+  f.read(magic, sizeof(magic));
+  return f && (memcmp(magic, kMagic, sizeof(kMagic)) == 0);
+}
+
+void SpectralLibrary::Write(const string& filename,
+                            const Eigen::VectorXd& wavelengths,
+                            const Eigen::MatrixXd& spectra,
+                            const vector<string>& names, Type type) {
+  if (spectra.rows() != wavelengths.size()) {
+    throw runtime_error("Spectra and wavelength grid sizes differ");
+  }
+  if (!names.empty() && (names.size() != static_cast<size_t>(spectra.cols()))) {
+    throw runtime_error("Spectrum name and spectrum counts differ");
+  }
+
+  string joined;
+  for (const auto& name : names) {
+    if (name.find('\n') != string::npos) {
+      throw runtime_error("Spectrum names may not contain newlines");
+    }
+    joined += name + '\n';
+  }
+
+  Header header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.type = static_cast<uint32_t>(type);
+  header.bands = wavelengths.size();
+  header.count = spectra.cols();
+  header.names_size = joined.size();
+
+  ofstream f(filename, ios::binary);
+  if (!f) {
+    throw runtime_error("Unable to open spectral library for writing: " +
+                        filename);
+  }
+  f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  f.write(reinterpret_cast<const char*>(wavelengths.data()),
+          wavelengths.size() * sizeof(double));
+  if (type == Type::float64) {
+    f.write(reinterpret_cast<const char*>(spectra.data()),
+            spectra.size() * sizeof(double));
+  } else {
+    Eigen::MatrixXf values = spectra.cast<float>();
+    f.write(reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(float));
+  }
+  f.write(joined.data(), joined.size());
+  if (!f) {
+    throw runtime_error("Unable to write spectral library: " + filename);
+  }
+}
+
+void SpectralLibrary::FromCsv(const string& csv_filename,
+                              const string& filename, size_t header_lines,
+                              size_t label_line, Type type) {
+  utils::CsvTable table(csv_filename, header_lines, label_line);
+  if (table.cols() < 2) {
+    throw runtime_error(
+        "CSV file needs a wavelength column and at least one spectrum");
+  }
+
+  vector<string> names;
+  if (label_line > 0) {
+    for (size_t c = 2; c <= table.cols(); c++) {
+      names.push_back(table.label(c));
+    }
+  }
+  Write(filename, table.column(1),
+        table.matrix().rightCols(table.cols() - 1), names, type);
+}
+
+Eigen::VectorXd SpectralLibrary::values(size_t index) const {
+  if (type_ == Type::float32) {
+    return spectrum<float>(index).cast<double>();
+  }
+  return spectrum<double>(index);
+}
+
+size_t SpectralLibrary::Find(const string& name) const {
+  auto it = find(names_.begin(), names_.end(), name);
+  if (it == names_.end()) {
+    throw runtime_error("Spectrum not found in the library: " + name);
+  }
+  return it - names_.begin();
+}
+
+size_t SpectralLibrary::Index(size_t index) const {
+  if (index >= count_) {
+    throw runtime_error("Requested spectrum is out of range");
+  }
+  return index;
+}
+
+}  // namespace color
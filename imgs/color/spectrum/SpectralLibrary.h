@@ -0,0 +1,143 @@
+/** Interface file for binary spectral libraries
+ *
+ * \file imgs/color/spectrum/SpectralLibrary.h
+ *
+ * \description
+ *   A compact binary format for a set of spectra sampled on one wavelength
+ *   grid, read by memory mapping the file so that the wavelengths and every
+ *   spectrum are Eigen::Map views of the file without any parsing or
+ *   copying.  The layout (native, little-endian byte order) is
+ *
+ *     offset 0   header (64 bytes)
+ *                  char[8]  magic "RITSPLIB"
+ *                  uint32   version (1)
+ *                  uint32   bytes per spectral value (4 float32, 8 float64)
+ *                  uint64   bands (wavelengths per spectrum)
+ *                  uint64   count (number of spectra)
+ *                  uint64   bytes of names
+ *                  (zero padding to 64 bytes)
+ *     offset 64  wavelengths, bands float64
+ *                spectra, count x bands values, one spectrum after another
+ *                names, one per spectrum, each terminated by '\n'
+ *
+ *   Libraries are converted from CSV files whose first column holds the
+ *   wavelengths and whose remaining columns each hold one spectrum (the
+ *   column labels become the spectrum names).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <eigen3/Eigen/Dense>
+
+namespace color {
+
+class SpectralLibrary {
+ public:
+  enum class Type : uint32_t { float32 = 4, float64 = 8 };
+
+  /* Constructor, maps the library file
+   *
+   * \param[in] filename  spectral library filename
+   */
+  explicit SpectralLibrary(const std::string& filename);
+
+  /* True if the file starts with the spectral library magic
+   */
+  static bool IsLibrary(const std::string& filename);
+
+  /* Write a spectral library
+   *
+   * \param[in] filename     spectral library filename
+   * \param[in] wavelengths  wavelength grid (bands)
+   * \param[in] spectra      one spectrum per column (bands x count)
+   * \param[in] names        spectrum names (count, or empty)
+   * \param[in] type         stored value type [default is float64]
+   */
+  static void Write(const std::string& filename,
+                    const Eigen::VectorXd& wavelengths,
+                    const Eigen::MatrixXd& spectra,
+                    const std::vector<std::string>& names = {},
+                    Type type = Type::float64);
+
+  /* Convert a CSV file (wavelengths in the first column, one spectrum in
+   * each remaining column) to a spectral library
+   *
+   * \param[in] csv_filename  source CSV filename
+   * \param[in] filename      destination spectral library filename
+   * \param[in] header_lines  number of CSV header lines [default is 1]
+   * \param[in] label_line    CSV line holding the spectrum names [default
+   *                          is 1, 0 for unnamed spectra]
+   * \param[in] type          stored value type [default is float64]
+   */
+  static void FromCsv(const std::string& csv_filename,
+                      const std::string& filename, size_t header_lines = 1,
+                      size_t label_line = 1, Type type = Type::float64);
+
+  // Getters
+  size_t size() const { return count_; }
+  Eigen::Index bands() const { return bands_; }
+  Type type() const { return type_; }
+  const std::vector<std::string>& names() const { return names_; }
+
+  Eigen::Map<const Eigen::VectorXd> wavelengths() const {
+    return Eigen::Map<const Eigen::VectorXd>(wavelengths_, bands_);
+  }
+
+  /* Every spectrum as a view of the file (bands x count), T must be the
+   * stored type
+   */
+  template <typename T>
+  Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>> spectra()
+      const {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>(
+        Values<T>(), bands_, count_);
+  }
+
+  /* One spectrum as a view of the file, T must be the stored type
+   */
+  template <typename T>
+  Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>> spectrum(
+      size_t index) const {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(
+        Values<T>() + Index(index) * bands_, bands_);
+  }
+
+  /* One spectrum in double precision, whatever the stored type
+   */
+  Eigen::VectorXd values(size_t index) const;
+
+  /* Index of the spectrum with the given name
+   */
+  size_t Find(const std::string& name) const;
+
+ private:
+  template <typename T>
+  const T* Values() const {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "Spectral library values are float or double");
+    if (sizeof(T) != static_cast<size_t>(type_)) {
+      throw std::runtime_error(
+          "Requested type does not match the stored spectral library type");
+    }
+    return reinterpret_cast<const T*>(values_);
+  }
+
+  size_t Index(size_t index) const;
+
+  boost::iostreams::mapped_file_source file_;
+  Eigen::Index bands_ = 0;
+  size_t count_ = 0;
+  Type type_ = Type::float64;
+  const double* wavelengths_ = nullptr;
+  const char* values_ = nullptr;
+  std::vector<std::string> names_;
+};
+
+}  // namespace color
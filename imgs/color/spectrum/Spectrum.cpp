@@ -14,66 +14,11 @@ using namespace std;
 namespace color {
 
 Eigen::Vector3d Spectrum::xyz(int RI, int SO) {
-  double x, y, z;
-
-  // Getting some vectors from the CIE class
-  Eigen::VectorXd wavelengths = cie.wavelengths();
-  Eigen::VectorXd illuminant = cie.reference_illuminant(RI);
-  Eigen::VectorXd xbar = cie.xbar(SO);
-  Eigen::VectorXd ybar = cie.ybar(SO);
-  Eigen::VectorXd zbar = cie.zbar(SO);
-
-  // We interpolate if there aren't the same number of wavelength values,
-  // although this might not catch differing wavelength spans in some cases
-  if (wavelengths_.size() != wavelengths.size()) {
-    // Making interpolated versions based off of our wavelength vector
-    Eigen::VectorXd ill_interp =
-        numerical::Interp1(wavelengths_, wavelengths, illuminant);
-    Eigen::VectorXd xbar_interp =
-        numerical::Interp1(wavelengths_, wavelengths, xbar);
-    Eigen::VectorXd ybar_interp =
-        numerical::Interp1(wavelengths_, wavelengths, ybar);
-    Eigen::VectorXd zbar_interp =
-        numerical::Interp1(wavelengths_, wavelengths, zbar);
-
-    // Calculating the normalizing factor
-    Eigen::ArrayXd norm = ill_interp.array() * ybar_interp.array();
-    double n = norm.sum();
-
-    // Multiplying vectors before taking their summation
-    Eigen::ArrayXd x_unsummed =
-        ill_interp.array() * reflectance_.array() * xbar_interp.array();
-    Eigen::ArrayXd y_unsummed =
-        ill_interp.array() * reflectance_.array() * ybar_interp.array();
-    Eigen::ArrayXd z_unsummed =
-        ill_interp.array() * reflectance_.array() * zbar_interp.array();
-
-    // Taking summation and calculating final values for XYZ
-    x = x_unsummed.sum() / n;
-    y = y_unsummed.sum() / n;
-    z = z_unsummed.sum() / n;
-  } else {
-    // Calculating the normalizing factor
-    Eigen::ArrayXd norm = illuminant.array() * ybar.array();
-    double n = norm.sum();
-
-    // Multiplying vectors before taking their summation
-    Eigen::ArrayXd x_unsummed =
-        illuminant.array() * reflectance_.array() * xbar.array();
-    Eigen::ArrayXd y_unsummed =
-        illuminant.array() * reflectance_.array() * ybar.array();
-    Eigen::ArrayXd z_unsummed =
-        illuminant.array() * reflectance_.array() * zbar.array();
-
-    // Taking summation and calculating final values for XYZ
-    x = x_unsummed.sum() / n;
-    y = y_unsummed.sum() / n;
-    z = z_unsummed.sum() / n;
-  }
-
-  // Putting them in a vector
-  Eigen::Vector3d xyz;
-  xyz << x, y, z;
+  // The illuminant, color matching functions, and normalizing factor are
+  // folded into a weighting matrix that is cached per wavelength grid, so
+  // nothing is re-interpolated here
+  auto integrator = SpectralIntegrator::Get(wavelengths_, RI, SO);
+  Eigen::Vector3d xyz = integrator->xyz(reflectance_);
 
   // Saving to the private section
   xyz_ = xyz;
@@ -6,6 +6,8 @@
  * \note I'm pretty sure I don't even need at least a quarter of those includes
  */
 
+#pragma once
+
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -16,6 +18,8 @@
 #include <cmath>
 
 #include "imgs/color/color.h"
+#include "imgs/color/spectrum/SpectralIntegrator.h"
+#include "imgs/color/spectrum/SpectralLibrary.h"
 #include "imgs/utils/utils.h"
 #include "imgs/numerical/interpolation/interpolation.h"
 #include <eigen3/Eigen/Dense>
@@ -27,26 +31,29 @@ namespace color {
 class Spectrum {
  public:
   Spectrum() {
-    wavelengths_ = cie.wavelengths();
+    wavelengths_ = CIE::wavelengths();
 
     reflectance_ = Eigen::VectorXd::Ones(wavelengths_.size());
   }
 
   Spectrum(std::string filename, size_t header_lines, size_t label_line) {
-    utils::CsvFile f;
-    f.set_filename(filename);
-    f.set_header_lines(header_lines);
-    f.set_label_line(label_line);
-
-    auto wav_vect = f.get_column<double>(1);
-    Eigen::Map<Eigen::VectorXd> wavelengths(wav_vect.data(), wav_vect.size());
-
-    wavelengths_ = wavelengths;
-
-    auto ref_vect = f.get_column<double>(2);
-    Eigen::Map<Eigen::VectorXd> reflectance(ref_vect.data(), ref_vect.size());
+    // Binary spectral libraries are read directly (their first spectrum),
+    // no header lines to skip
+    if (SpectralLibrary::IsLibrary(filename)) {
+      *this = Spectrum(SpectralLibrary(filename), 0);
+      return;
+    }
+
+    // Both columns come from a single pass over the file
+    utils::CsvTable table(filename, header_lines, label_line);
+
+    wavelengths_ = table.column(1);
+    reflectance_ = table.column(2);
+  }
 
-    reflectance_ = reflectance;
+  Spectrum(const SpectralLibrary& library, size_t index) {
+    wavelengths_ = library.wavelengths();
+    reflectance_ = library.values(index);
   }
 
   // Getters
@@ -60,9 +67,6 @@ class Spectrum {
   void patch();
 
  private:
-  // lol I'm probably not supposed to do this
-  color::CIE cie;
-
   Eigen::VectorXd wavelengths_ = Eigen::VectorXd();
   Eigen::VectorXd reflectance_ = Eigen::VectorXd();
   Eigen::Vector3d xyz_ = Eigen::Vector3d();
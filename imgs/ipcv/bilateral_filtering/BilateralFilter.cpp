@@ -9,6 +9,8 @@
 
 #include <iostream>
 
+#include "imgs/ipcv/color_conversion/ColorConversion.h"
+
 using namespace std;
 
 namespace ipcv {
@@ -39,7 +41,7 @@ bool BilateralFilter(const cv::Mat& src, cv::Mat& dst,
 
   // oh god uhh lab conversion
   cv::Mat src_lab;
-  cv::cvtColor(src, src_lab, cv::COLOR_BGR2Lab);
+  ipcv::BgrToLab8(src, src_lab);
 
   // make it all black
   dst = 0;
@@ -81,7 +83,7 @@ bool BilateralFilter(const cv::Mat& src, cv::Mat& dst,
   }
 
   // convert back to rgb!!
-  cv::cvtColor(dst, dst, cv::COLOR_Lab2BGR);
+  ipcv::Lab8ToBgr(dst, dst);
 
   return true;
 }
@@ -0,0 +1,316 @@
+/** Implementation file for sRGB / CIE L*a*b* color conversion
+ *
+ *  \file ipcv/color_conversion/ColorConversion.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "ColorConversion.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+// Rows per parallel work item for the image functions
+const int kBandRows = 32;
+
+// Intervals of the linear to sRGB encoding table
+const int kEncodeSize = 4096;
+
+// sRGB (D65) primaries to CIE XYZ divided by the white point, columns in
+// BGR order
+const float kBgrToXyz[3][3] = {
+    {0.180423f / 0.950456f, 0.357580f / 0.950456f, 0.412453f / 0.950456f},
+    {0.072169f, 0.715160f, 0.212671f},
+    {0.950227f / 1.088754f, 0.119193f / 1.088754f, 0.019334f / 1.088754f}};
+
+// White point scaled CIE XYZ to sRGB (D65) primaries, rows in BGR order
+const float kXyzToBgr[3][3] = {
+    {0.055648f * 0.950456f, -0.204043f, 1.057311f * 1.088754f},
+    {-0.969256f * 0.950456f, 1.875991f, 0.041556f * 1.088754f},
+    {3.240479f * 0.950456f, -1.537150f, -0.498535f * 1.088754f}};
+
+/* L*a*b* companding function and its inverse
+ */
+inline float LabF(float t) {
+  return (t > 0.008856f) ? FastCbrt(t) : 7.787f * t + 16.0f / 116.0f;
+}
+
+inline float LabFInverse(float f) {
+  return (f > 6.0f / 29.0f) ? f * f * f : (f - 16.0f / 116.0f) / 7.787f;
+}
+
+/* Linear to sRGB encoding table, one extra entry so that interpolation
+ * never reads past the end
+ */
+const vector<float>& EncodeTable() {
+  static const vector<float> table = [] {
+    vector<float> t(kEncodeSize + 2);
+    for (int idx = 0; idx <= kEncodeSize + 1; idx++) {
+      double v = min(static_cast<double>(idx) / kEncodeSize, 1.0);
+      t[idx] = static_cast<float>((v <= 0.0031308)
+                                      ? 12.92 * v
+                                      : 1.055 * pow(v, 1 / 2.4) - 0.055);
+    }
+    return t;
+  }();
+  return table;
+}
+
+/* Linear BGR pixel to L*a*b*
+ */
+inline void LinearToLab(float b, float g, float r, float* lab) {
+  float fx = LabF(kBgrToXyz[0][0] * b + kBgrToXyz[0][1] * g +
+                  kBgrToXyz[0][2] * r);
+  float fy = LabF(kBgrToXyz[1][0] * b + kBgrToXyz[1][1] * g +
+                  kBgrToXyz[1][2] * r);
+  float fz = LabF(kBgrToXyz[2][0] * b + kBgrToXyz[2][1] * g +
+                  kBgrToXyz[2][2] * r);
+  lab[0] = 116.0f * fy - 16.0f;
+  lab[1] = 500.0f * (fx - fy);
+  lab[2] = 200.0f * (fy - fz);
+}
+
+template <typename T>
+void LutBgrToLabRow(const T* bgr, int cols, const vector<float>& lut,
+                    float* lab) {
+  for (int c = 0; c < cols; c++) {
+    LinearToLab(lut[bgr[3 * c]], lut[bgr[3 * c + 1]], lut[bgr[3 * c + 2]],
+                lab + 3 * c);
+  }
+}
+
+/* Encoded BGR row (in [0, 1]) to the destination depth
+ */
+template <typename T>
+void StoreRow(const float* bgr, int cols, float max_value, T* dst) {
+  for (int idx = 0; idx < 3 * cols; idx++) {
+    dst[idx] = cv::saturate_cast<T>(bgr[idx] * max_value);
+  }
+}
+
+}  // namespace
+
+float SrgbToLinear(float v) {
+  v = min(max(v, 0.0f), 1.0f);
+  return (v <= 0.04045f) ? v / 12.92f : pow((v + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSrgb(float v) {
+  const float* table = EncodeTable().data();
+  float x = min(max(v, 0.0f), 1.0f) * kEncodeSize;
+  int idx = static_cast<int>(x);
+  float t = x - idx;
+  return table[idx] + t * (table[idx + 1] - table[idx]);
+}
+
+vector<float> LinearizationLut(int depth, double max_value) {
+  vector<float> lut;
+  if (depth == CV_8U) {
+    lut.resize(256);
+  } else if (depth == CV_16U) {
+    lut.resize(65536);
+  } else {
+    cerr << "Linearization tables are only available for CV_8U or CV_16U"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  for (size_t idx = 0; idx < lut.size(); idx++) {
+    lut[idx] = SrgbToLinear(static_cast<float>(idx / max_value));
+  }
+  return lut;
+}
+
+void Transform3x3Row(const float* src, int cols, const cv::Matx33f& m,
+                     float* dst) {
+  for (int c = 0; c < cols; c++) {
+    float x = src[3 * c];
+    float y = src[3 * c + 1];
+    float z = src[3 * c + 2];
+    dst[3 * c] = m(0, 0) * x + m(0, 1) * y + m(0, 2) * z;
+    dst[3 * c + 1] = m(1, 0) * x + m(1, 1) * y + m(1, 2) * z;
+    dst[3 * c + 2] = m(2, 0) * x + m(2, 1) * y + m(2, 2) * z;
+  }
+}
+
+void LinearBgrToLabRow(const float* bgr, int cols, float* lab) {
+  for (int c = 0; c < cols; c++) {
+    LinearToLab(bgr[3 * c], bgr[3 * c + 1], bgr[3 * c + 2], lab + 3 * c);
+  }
+}
+
+void BgrToLabRow(const uint8_t* bgr, int cols, const vector<float>& lut,
+                 float* lab) {
+  LutBgrToLabRow(bgr, cols, lut, lab);
+}
+
+void BgrToLabRow(const uint16_t* bgr, int cols, const vector<float>& lut,
+                 float* lab) {
+  LutBgrToLabRow(bgr, cols, lut, lab);
+}
+
+void BgrToLabRow(const float* bgr, int cols, float scale, float* lab) {
+  for (int c = 0; c < cols; c++) {
+    LinearToLab(SrgbToLinear(bgr[3 * c] * scale),
+                SrgbToLinear(bgr[3 * c + 1] * scale),
+                SrgbToLinear(bgr[3 * c + 2] * scale), lab + 3 * c);
+  }
+}
+
+void LabToLinearBgrRow(const float* lab, int cols, float* bgr) {
+  for (int c = 0; c < cols; c++) {
+    float L = lab[3 * c];
+    float fy = (L + 16.0f) / 116.0f;
+    float fx = fy + lab[3 * c + 1] / 500.0f;
+    float fz = fy - lab[3 * c + 2] / 200.0f;
+    float x = LabFInverse(fx);
+    float y = (L > 8.0f) ? fy * fy * fy : L / 903.3f;
+    float z = LabFInverse(fz);
+    for (int k = 0; k < 3; k++) {
+      bgr[3 * c + k] =
+          kXyzToBgr[k][0] * x + kXyzToBgr[k][1] * y + kXyzToBgr[k][2] * z;
+    }
+  }
+}
+
+void LabToBgrRow(const float* lab, int cols, float* bgr) {
+  LabToLinearBgrRow(lab, cols, bgr);
+  for (int idx = 0; idx < 3 * cols; idx++) {
+    bgr[idx] = LinearToSrgb(bgr[idx]);
+  }
+}
+
+void BgrToLab(const cv::Mat& src, cv::Mat& dst, double max_value) {
+  int depth = src.depth();
+  if ((src.channels() != 3) ||
+      ((depth != CV_8U) && (depth != CV_16U) && (depth != CV_32F))) {
+    cerr << "Source image must be of type CV_8UC3, CV_16UC3, or CV_32FC3"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (max_value < 0) {
+    max_value = (depth == CV_8U) ? 255 : (depth == CV_16U) ? 65535 : 1;
+  }
+
+  // Keep a reference to the source in case dst is the same cv::Mat
+  cv::Mat source = src;
+  dst.create(source.size(), CV_32FC3);
+
+  vector<float> lut;
+  if (depth != CV_32F) {
+    lut = LinearizationLut(depth, max_value);
+  }
+  float scale = static_cast<float>(1 / max_value);
+
+  int bands = (source.rows + kBandRows - 1) / kBandRows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    int end = min(range.end * kBandRows, source.rows);
+    for (int r = range.start * kBandRows; r < end; r++) {
+      float* lab = dst.ptr<float>(r);
+      if (depth == CV_8U) {
+        BgrToLabRow(source.ptr<uint8_t>(r), source.cols, lut, lab);
+      } else if (depth == CV_16U) {
+        BgrToLabRow(source.ptr<uint16_t>(r), source.cols, lut, lab);
+      } else {
+        BgrToLabRow(source.ptr<float>(r), source.cols, scale, lab);
+      }
+    }
+  });
+}
+
+void LabToBgr(const cv::Mat& src, cv::Mat& dst, int depth, double max_value) {
+  if (src.type() != CV_32FC3) {
+    cerr << "Source image must be of type CV_32FC3" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((depth != CV_8U) && (depth != CV_16U) && (depth != CV_32F)) {
+    cerr << "Destination depth must be CV_8U, CV_16U, or CV_32F" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (max_value < 0) {
+    max_value = (depth == CV_8U) ? 255 : (depth == CV_16U) ? 65535 : 1;
+  }
+
+  cv::Mat source = src;
+  dst.create(source.size(), CV_MAKETYPE(depth, 3));
+
+  int bands = (source.rows + kBandRows - 1) / kBandRows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> buffer(3 * source.cols);
+    int end = min(range.end * kBandRows, source.rows);
+    for (int r = range.start * kBandRows; r < end; r++) {
+      if ((depth == CV_32F) && (max_value == 1)) {
+        LabToBgrRow(source.ptr<float>(r), source.cols, dst.ptr<float>(r));
+        continue;
+      }
+      LabToBgrRow(source.ptr<float>(r), source.cols, buffer.data());
+      if (depth == CV_8U) {
+        StoreRow(buffer.data(), source.cols, max_value, dst.ptr<uint8_t>(r));
+      } else if (depth == CV_16U) {
+        StoreRow(buffer.data(), source.cols, max_value, dst.ptr<uint16_t>(r));
+      } else {
+        StoreRow(buffer.data(), source.cols, max_value, dst.ptr<float>(r));
+      }
+    }
+  });
+}
+
+void BgrToLab8(const cv::Mat& src, cv::Mat& dst) {
+  if (src.type() != CV_8UC3) {
+    cerr << "Source image must be of type CV_8UC3" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cv::Mat source = src;
+  dst.create(source.size(), CV_8UC3);
+  vector<float> lut = LinearizationLut(CV_8U, 255);
+
+  int bands = (source.rows + kBandRows - 1) / kBandRows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> lab(3 * source.cols);
+    int end = min(range.end * kBandRows, source.rows);
+    for (int r = range.start * kBandRows; r < end; r++) {
+      BgrToLabRow(source.ptr<uint8_t>(r), source.cols, lut, lab.data());
+      uint8_t* p = dst.ptr<uint8_t>(r);
+      for (int c = 0; c < source.cols; c++) {
+        p[3 * c] = cv::saturate_cast<uint8_t>(lab[3 * c] * 255.0f / 100.0f);
+        p[3 * c + 1] = cv::saturate_cast<uint8_t>(lab[3 * c + 1] + 128.0f);
+        p[3 * c + 2] = cv::saturate_cast<uint8_t>(lab[3 * c + 2] + 128.0f);
+      }
+    }
+  });
+}
+
+void Lab8ToBgr(const cv::Mat& src, cv::Mat& dst) {
+  if (src.type() != CV_8UC3) {
+    cerr << "Source image must be of type CV_8UC3" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cv::Mat source = src;
+  dst.create(source.size(), CV_8UC3);
+
+  int bands = (source.rows + kBandRows - 1) / kBandRows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> buffer(3 * source.cols);
+    int end = min(range.end * kBandRows, source.rows);
+    for (int r = range.start * kBandRows; r < end; r++) {
+      const uint8_t* p = source.ptr<uint8_t>(r);
+      for (int c = 0; c < source.cols; c++) {
+        buffer[3 * c] = p[3 * c] * 100.0f / 255.0f;
+        buffer[3 * c + 1] = p[3 * c + 1] - 128.0f;
+        buffer[3 * c + 2] = p[3 * c + 2] - 128.0f;
+      }
+      LabToBgrRow(buffer.data(), source.cols, buffer.data());
+      StoreRow(buffer.data(), source.cols, 255.0f, dst.ptr<uint8_t>(r));
+    }
+  });
+}
+}
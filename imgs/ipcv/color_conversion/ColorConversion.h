@@ -0,0 +1,191 @@
+/** Interface file for sRGB / CIE L*a*b* color conversion
+ *
+ *  \file ipcv/color_conversion/ColorConversion.h
+ *
+ *  \description
+ *    Conversion between sRGB encoded BGR (D65) and CIE L*a*b*, following
+ *    the OpenCV COLOR_BGR2Lab / COLOR_Lab2BGR definitions.  The row
+ *    functions work on interleaved 3-channel rows (BGR or L*a*b*), may be
+ *    called in place where noted, and allocate nothing, so callers can fuse
+ *    conversion into their own row loops; the image functions run them over
+ *    row bands in parallel.
+ *
+ *    8- and 16-bit sources are linearized through a table indexed by the
+ *    raw value, the linear to sRGB encoding uses an interpolated table, and
+ *    the L*a*b* cube root is a polynomial estimate refined by one Newton
+ *    step (relative error below 2e-7).
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Cube root of a float
+ *
+ *  \param[in] x   value
+ *
+ *  \return        cube root of x (relative error below 2e-7)
+ */
+inline float FastCbrt(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  int exponent = static_cast<int>((bits >> 23) & 0xff);
+
+  // Zero, subnormal, infinite, and NaN values are rare enough to defer
+  if ((exponent == 0) || (exponent == 0xff)) {
+    return std::cbrt(x);
+  }
+
+  // x = +/- m 2^e with m in [1, 2) and e = 3q + r, r in {0, 1, 2}
+  int e = exponent - 127;
+  int q = (e >= 0) ? e / 3 : (e - 2) / 3;
+  int r = e - 3 * q;
+  uint32_t mantissa_bits = (bits & 0x007fffff) | 0x3f800000;
+  float m;
+  std::memcpy(&m, &mantissa_bits, sizeof(m));
+
+  // Cubic fit of cbrt(m) on [1, 2) (relative error below 1e-4)
+  static const float kCbrt2[3] = {1.0f, 1.25992105f, 1.58740105f};
+  float y = ((0.0224717456f * m - 0.160126947f) * m + 0.582979100f) * m +
+            0.554768032f;
+  y *= kCbrt2[r];
+
+  uint32_t scale_bits = static_cast<uint32_t>(q + 127) << 23;
+  float scale;
+  std::memcpy(&scale, &scale_bits, sizeof(scale));
+  y *= scale;
+
+  // One Newton step squares the relative error
+  float ax = (bits >> 31) ? -x : x;
+  y = (2.0f * y + ax / (y * y)) * (1.0f / 3.0f);
+  return (bits >> 31) ? -y : y;
+}
+
+/** sRGB encoded value to linear
+ *
+ *  \param[in] v   sRGB encoded value (clamped to [0, 1])
+ *
+ *  \return        linear value in [0, 1]
+ */
+float SrgbToLinear(float v);
+
+/** Linear value to sRGB encoded, using an interpolated table
+ *
+ *  \param[in] v   linear value (clamped to [0, 1])
+ *
+ *  \return        sRGB encoded value in [0, 1] (absolute error below 2e-5)
+ */
+float LinearToSrgb(float v);
+
+/** Linearization table for an 8- or 16-bit unsigned source
+ *
+ *  \param[in] depth       CV_8U or CV_16U
+ *  \param[in] max_value   raw value that maps to an encoded value of 1
+ *
+ *  \return                256 or 65536 entry table of linear values
+ */
+std::vector<float> LinearizationLut(int depth, double max_value);
+
+/** Apply a 3x3 matrix to each pixel of an interleaved 3-channel row
+ *  (src and dst may be the same row)
+ *
+ *  \param[in] src    interleaved source row
+ *  \param[in] cols   number of pixels
+ *  \param[in] m      matrix applied to each pixel column vector
+ *  \param[out] dst   interleaved destination row
+ */
+void Transform3x3Row(const float* src, int cols, const cv::Matx33f& m,
+                     float* dst);
+
+/** Linear BGR row to L*a*b* (bgr and lab may be the same row)
+ *
+ *  \param[in] bgr    interleaved linear BGR row in [0, 1]
+ *  \param[in] cols   number of pixels
+ *  \param[out] lab   interleaved L*a*b* row
+ */
+void LinearBgrToLabRow(const float* bgr, int cols, float* lab);
+
+/** sRGB encoded BGR row to L*a*b*
+ *
+ *  The integer versions linearize through a table from LinearizationLut,
+ *  the floating point version scales each value by scale (bgr and lab may
+ *  be the same row).
+ *
+ *  \param[in] bgr     interleaved sRGB encoded BGR row
+ *  \param[in] cols    number of pixels
+ *  \param[in] lut     linearization table for the source depth
+ *  \param[in] scale   multiplier taking source values to [0, 1]
+ *  \param[out] lab    interleaved L*a*b* row
+ */
+void BgrToLabRow(const uint8_t* bgr, int cols, const std::vector<float>& lut,
+                 float* lab);
+
+void BgrToLabRow(const uint16_t* bgr, int cols, const std::vector<float>& lut,
+                 float* lab);
+
+void BgrToLabRow(const float* bgr, int cols, float scale, float* lab);
+
+/** L*a*b* row to linear BGR (lab and bgr may be the same row)
+ *
+ *  \param[in] lab    interleaved L*a*b* row
+ *  \param[in] cols   number of pixels
+ *  \param[out] bgr   interleaved linear BGR row (out of gamut values are
+ *                    not clamped)
+ */
+void LabToLinearBgrRow(const float* lab, int cols, float* bgr);
+
+/** L*a*b* row to sRGB encoded BGR (lab and bgr may be the same row)
+ *
+ *  \param[in] lab    interleaved L*a*b* row
+ *  \param[in] cols   number of pixels
+ *  \param[out] bgr   interleaved sRGB encoded BGR row in [0, 1]
+ */
+void LabToBgrRow(const float* lab, int cols, float* bgr);
+
+/** Convert an sRGB encoded BGR image to L*a*b*
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC3, CV_16UC3, or CV_32FC3
+ *  \param[out] dst        destination cv::Mat of CV_32FC3 (may be src if
+ *                         src is CV_32FC3)
+ *  \param[in] max_value   source value that maps to an encoded value of 1
+ *                         [default (-1) is 255, 65535, or 1 by source depth]
+ */
+void BgrToLab(const cv::Mat& src, cv::Mat& dst, double max_value = -1);
+
+/** Convert an L*a*b* image to sRGB encoded BGR
+ *
+ *  \param[in] src         source cv::Mat of CV_32FC3
+ *  \param[out] dst        destination cv::Mat of CV_8UC3, CV_16UC3, or
+ *                         CV_32FC3 (may be src for CV_32F)
+ *  \param[in] depth       destination depth CV_8U, CV_16U, or CV_32F
+ *                         [default is CV_32F]
+ *  \param[in] max_value   destination value for an encoded value of 1
+ *                         [default (-1) is 255, 65535, or 1 by depth]
+ */
+void LabToBgr(const cv::Mat& src, cv::Mat& dst, int depth = CV_32F,
+              double max_value = -1);
+
+/** Convert an 8-bit sRGB encoded BGR image to 8-bit L*a*b*
+ *
+ *  The OpenCV 8-bit encoding is used: L* is scaled by 255 / 100 and 128 is
+ *  added to a* and b*.
+ *
+ *  \param[in] src    source cv::Mat of CV_8UC3
+ *  \param[out] dst   destination cv::Mat of CV_8UC3
+ */
+void BgrToLab8(const cv::Mat& src, cv::Mat& dst);
+
+/** Convert an 8-bit L*a*b* image (OpenCV encoding) to 8-bit sRGB BGR
+ *
+ *  \param[in] src    source cv::Mat of CV_8UC3
+ *  \param[out] dst   destination cv::Mat of CV_8UC3 (may be src)
+ */
+void Lab8ToBgr(const cv::Mat& src, cv::Mat& dst);
+}
@@ -7,136 +7,70 @@
 
 #include <iostream>
 
-#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
 
 #include "Bilinear.h"
+#include "Cfa.h"
 
 using namespace std;
 
 namespace ipcv {
 
 cv::Mat Bilinear(const cv::Mat& src, string pattern) {
-  // Create blue (B) and red (R) filter location masks
-  int b_row;
-  int b_col;
-  int r_row;
-  int r_col;
-  if (pattern == "GBRG") {
-    b_row = 0;
-    b_col = 1;
-    r_row = 1;
-    r_col = 0;
-  } else if (pattern == "GRBG") {
-    b_row = 1;
-    b_col = 0;
-    r_row = 0;
-    r_col = 1;
-  } else if (pattern == "BGGR") {
-    b_row = 0;
-    b_col = 0;
-    r_row = 1;
-    r_col = 1;
-  } else if (pattern == "RGGB") {
-    b_row = 1;
-    b_col = 1;
-    r_row = 0;
-    r_col = 0;
-  } else {
-    cerr << "Invalid CFA pattern provided: " << pattern << endl;
-    exit(EXIT_FAILURE);
-  }
-  cv::Mat b_mask = cv::Mat::zeros(src.size(), CV_16UC1);
-  for (int r = b_row; r < src.rows; r += 2) {
-    for (int c = b_col; c < src.cols; c += 2) {
-      b_mask.at<uint16_t>(r, c) = 1;
-    }
-  }
-  cv::Mat r_mask = cv::Mat::zeros(src.size(), CV_16UC1);
-  for (int r = r_row; r < src.rows; r += 2) {
-    for (int c = r_col; c < src.cols; c += 2) {
-      r_mask.at<uint16_t>(r, c) = 1;
-    }
-  }
-
-  // Create green (G) filter location mask
-  cv::Mat g_mask = cv::Mat::ones(src.size(), CV_16UC1);
-  cv::subtract(g_mask, b_mask, g_mask);
-  cv::subtract(g_mask, r_mask, g_mask);
-
-  // Initialize interpolated B, G, and R channels
-  cv::Mat B;
-  cv::multiply(src, b_mask, B);
-  cv::Mat G;
-  cv::multiply(src, g_mask, G);
-  cv::Mat R;
-  cv::multiply(src, r_mask, R);
+  cv::Mat dst;
+  Bilinear(src, dst, pattern);
+  return dst;
+}
 
+void Bilinear(const cv::Mat& src, cv::Mat& dst, string pattern,
+              double nstripes) {
   // Set bounds for the iterpolation domain
   int ul_row = 2;
   int ul_col = 2;
   int lr_row = src.rows - 2;
   int lr_col = src.cols - 2;
 
-  // Interpolate green (G) channel
-  for (int r = ul_row; r < lr_row; r++) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 0) {
-        G.at<uint16_t>(r, c) =
-            (G.at<uint16_t>(r - 1, c) + G.at<uint16_t>(r, c - 1) +
-             G.at<uint16_t>(r + 1, c) + G.at<uint16_t>(r, c + 1)) /
-            4;
-      }
-    }
-  }
-
-  // Interpolate missing red (R) values in red (R) rows (horizontal)
-  for (int r = r_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (r_mask.at<uint16_t>(r, c) == 0) {
-        R.at<uint16_t>(r, c) =
-            (R.at<uint16_t>(r, c - 1) + R.at<uint16_t>(r, c + 1)) / 2;
-      }
-    }
-  }
+  // Separate the B, G, and R filter sites into their own channels (the
+  // filter color at each location follows from the CFA phase)
+  Cfa cfa(pattern);
+  ExtractCfaPlanes(src, cfa, CV_16U, dst, nstripes);
 
-  // Interpolate values in missing red (R) rows (vertical)
-  for (int r = r_row + 1; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (r_mask.at<uint16_t>(r, c) == 0) {
-        R.at<uint16_t>(r, c) =
-            (R.at<uint16_t>(r - 1, c) + R.at<uint16_t>(r + 1, c)) / 2;
-      }
+  // Interpolate green (G) channel (every other column starting at the first
+  // non-green site in the row)
+  for (int r = ul_row; r < lr_row; r++) {
+    const cv::Vec3w* above = dst.ptr<cv::Vec3w>(r - 1);
+    cv::Vec3w* center = dst.ptr<cv::Vec3w>(r);
+    const cv::Vec3w* below = dst.ptr<cv::Vec3w>(r + 1);
+    int c0 = cfa.is_green(r, ul_col) ? ul_col + 1 : ul_col;
+    for (int c = c0; c < lr_col; c += 2) {
+      center[c][1] = (above[c][1] + center[c - 1][1] + below[c][1] +
+                      center[c + 1][1]) /
+                     4;
     }
   }
 
-  // Interpolate missing blue (B) values in blue (B) rows (horizontal)
-  for (int r = b_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (b_mask.at<uint16_t>(r, c) == 0) {
-        B.at<uint16_t>(r, c) =
-            (B.at<uint16_t>(r, c - 1) + B.at<uint16_t>(r, c + 1)) / 2;
+  // Interpolate the red (R, channel 2) and blue (B, channel 0) channels
+  const int rows[3] = {cfa.b_row(), 0, cfa.r_row()};
+  const int cols[3] = {cfa.b_col(), 0, cfa.r_col()};
+  for (int ch = 0; ch < 3; ch += 2) {
+    // Interpolate missing values in rows containing this color (horizontal)
+    int c0 = (cols[ch] == (ul_col & 1)) ? ul_col + 1 : ul_col;
+    for (int r = rows[ch]; r < lr_row; r += 2) {
+      cv::Vec3w* center = dst.ptr<cv::Vec3w>(r);
+      for (int c = c0; c < lr_col; c += 2) {
+        center[c][ch] = (center[c - 1][ch] + center[c + 1][ch]) / 2;
       }
     }
-  }
 
-  // Interpolate values in missing blue (B) rows (vertical)
-  for (int r = b_row + 1; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (b_mask.at<uint16_t>(r, c) == 0) {
-        B.at<uint16_t>(r, c) =
-            (B.at<uint16_t>(r - 1, c) + B.at<uint16_t>(r + 1, c)) / 2;
+    // Interpolate values in rows missing this color (vertical)
+    for (int r = rows[ch] + 1; r < lr_row; r += 2) {
+      const cv::Vec3w* above = dst.ptr<cv::Vec3w>(r - 1);
+      cv::Vec3w* center = dst.ptr<cv::Vec3w>(r);
+      const cv::Vec3w* below = dst.ptr<cv::Vec3w>(r + 1);
+      for (int c = ul_col; c < lr_col; c++) {
+        center[c][ch] = (above[c][ch] + below[c][ch]) / 2;
       }
     }
   }
-
-  // Merge the interpolated B, G, and R channels into a 3-channel cv::Mat
-  cv::Mat channels[3];
-  channels[0] = B;
-  channels[1] = G;
-  channels[2] = R;
-  cv::Mat dst;
-  cv::merge(channels, 3, dst);
-
-  return dst;
 }
 }
@@ -77,4 +77,16 @@ namespace ipcv {
  *                       3-channel (color) image
  */
 cv::Mat Bilinear(const cv::Mat& src, string pattern = "GBRG");
+
+/** Interpolate CFA using bilinear interpolation into a provided image
+ *
+ *  \param[in] src        source cv::Mat of CV_16UC1 containing CFA
+ *  \param[out] dst       destination cv::Mat of CV_16UC3 (reallocated only
+ *                        if its size or type differ)
+ *  \param[in] pattern    a string defining the CFA layout (see above)
+ *  \param[in] nstripes   parallel stripes as for cv::parallel_for_, 1 runs
+ *                        in the calling thread [default is automatic]
+ */
+void Bilinear(const cv::Mat& src, cv::Mat& dst, string pattern,
+              double nstripes = -1);
 }
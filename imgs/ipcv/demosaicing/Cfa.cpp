@@ -0,0 +1,140 @@
+/** Implementation file for color filter array (CFA) layout access
+ *
+ *  \file ipcv/demosaicing/Cfa.cpp
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include "Cfa.h"
+
+using namespace std;
+
+namespace ipcv {
+
+Cfa::Cfa(const string& pattern) {
+  if (pattern == "GBRG") {
+    r_row_ = 1;
+    r_col_ = 0;
+  } else if (pattern == "GRBG") {
+    r_row_ = 0;
+    r_col_ = 1;
+  } else if (pattern == "BGGR") {
+    r_row_ = 1;
+    r_col_ = 1;
+  } else if (pattern == "RGGB") {
+    r_row_ = 0;
+    r_col_ = 0;
+  } else {
+    cerr << "Invalid CFA pattern provided: " << pattern << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Green sites are the two tile locations off the red/blue diagonal
+  g_parity_ = (r_row_ + r_col_ + 1) & 1;
+  for (int r = 0; r < 2; r++) {
+    for (int c = 0; c < 2; c++) {
+      if (((r + c) & 1) == g_parity_) {
+        tile_[r][c] = green;
+      } else if (r == r_row_) {
+        tile_[r][c] = red;
+      } else {
+        tile_[r][c] = blue;
+      }
+    }
+  }
+}
+
+string Cfa::pattern() const {
+  const char names[3] = {'B', 'G', 'R'};
+  string pattern;
+  pattern += names[tile_[0][0]];
+  pattern += names[tile_[0][1]];
+  pattern += names[tile_[1][0]];
+  pattern += names[tile_[1][1]];
+  return pattern;
+}
+
+Cfa Cfa::Shifted(int rows, int cols) const {
+  Cfa shifted(*this);
+  for (int r = 0; r < 2; r++) {
+    for (int c = 0; c < 2; c++) {
+      shifted.tile_[r][c] = color(r + rows, c + cols);
+    }
+  }
+  shifted.r_row_ = (r_row_ + rows) & 1;
+  shifted.r_col_ = (r_col_ + cols) & 1;
+  shifted.g_parity_ = (g_parity_ + rows + cols) & 1;
+  return shifted;
+}
+
+namespace {
+
+template <typename Tin, typename Tout>
+void ExtractPlanes(const cv::Mat& src, const Cfa& cfa, cv::Mat& dst,
+                   double nstripes) {
+  cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      const Tin* in = src.ptr<Tin>(r);
+      Tout* out = dst.ptr<Tout>(r);
+      std::fill(out, out + 3 * src.cols, Tout(0));
+      int even = cfa.color(r, 0);
+      int odd = cfa.color(r, 1);
+      int c = 0;
+      for (; c + 1 < src.cols; c += 2) {
+        out[3 * c + even] = static_cast<Tout>(in[c]);
+        out[3 * (c + 1) + odd] = static_cast<Tout>(in[c + 1]);
+      }
+      if (c < src.cols) {
+        out[3 * c + even] = static_cast<Tout>(in[c]);
+      }
+    }
+  }, nstripes);
+}
+
+template <typename Tin>
+void ExtractPlanes(const cv::Mat& src, const Cfa& cfa, cv::Mat& dst,
+                   double nstripes) {
+  switch (dst.depth()) {
+    case CV_8U:
+      ExtractPlanes<Tin, uint8_t>(src, cfa, dst, nstripes);
+      break;
+    case CV_16U:
+      ExtractPlanes<Tin, uint16_t>(src, cfa, dst, nstripes);
+      break;
+    case CV_32F:
+      ExtractPlanes<Tin, float>(src, cfa, dst, nstripes);
+      break;
+  }
+}
+
+}  // namespace
+
+cv::Mat ExtractCfaPlanes(const cv::Mat& src, const Cfa& cfa, int depth) {
+  cv::Mat dst;
+  ExtractCfaPlanes(src, cfa, depth, dst);
+  return dst;
+}
+
+void ExtractCfaPlanes(const cv::Mat& src, const Cfa& cfa, int depth,
+                      cv::Mat& dst, double nstripes) {
+  if ((depth != CV_8U) && (depth != CV_16U) && (depth != CV_32F)) {
+    cerr << "Destination depth must be CV_8U, CV_16U, or CV_32F" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((src.type() != CV_8UC1) && (src.type() != CV_16UC1)) {
+    cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // The source header is held so that it stays valid should the
+  // destination be the same cv::Mat
+  cv::Mat in = src;
+  dst.create(in.size(), CV_MAKETYPE(depth, 3));
+  if (in.depth() == CV_8U) {
+    ExtractPlanes<uint8_t>(in, cfa, dst, nstripes);
+  } else {
+    ExtractPlanes<uint16_t>(in, cfa, dst, nstripes);
+  }
+}
+}  // namespace ipcv
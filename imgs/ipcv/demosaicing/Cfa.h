@@ -0,0 +1,98 @@
+/** Interface file for color filter array (CFA) layout access
+ *
+ *  \file ipcv/demosaicing/Cfa.h
+ *
+ *  \description
+ *    A Bayer CFA repeats a 2x2 tile, so the filter color at any location
+ *    follows from the parity of its row and column.  The Cfa class holds
+ *    that tile for a named pattern so that demosaicing kernels can index
+ *    the red, green, and blue sites arithmetically instead of through
+ *    full-size location masks.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+class Cfa {
+ public:
+  /* Filter color enumeration (values are the BGR channel indices)
+   */
+  enum Color { blue = 0, green = 1, red = 2 };
+
+  /* Constructor
+   *
+   * \param[in] pattern
+   *     a string defining the CFA layout:
+   *       'GBRG'  -  G B  Raspberry Pi (OmniVision OV5647)
+   *                  R G
+   *       'GRBG'  -  G R
+   *                  B G
+   *       'BGGR'  -  B G
+   *                  G R
+   *       'RGGB'  -  R G
+   *                  G B
+   */
+  explicit Cfa(const std::string& pattern = "GBRG");
+
+  /* Pattern getter
+   */
+  std::string pattern() const;
+
+  /* Filter color at the provided location (any integer location is valid,
+   * including those outside of the image)
+   */
+  int color(int row, int col) const { return tile_[row & 1][col & 1]; }
+
+  /* Is the provided location a green filter site
+   */
+  bool is_green(int row, int col) const { return ((row + col) & 1) == g_parity_; }
+
+  /* Row and column of the red and blue filter sites within the 2x2 tile
+   */
+  int r_row() const { return r_row_; }
+  int r_col() const { return r_col_; }
+  int b_row() const { return r_row_ ^ 1; }
+  int b_col() const { return r_col_ ^ 1; }
+
+  /* Layout of the sub-image that begins at the provided offset
+   */
+  Cfa Shifted(int rows, int cols) const;
+
+ private:
+  int tile_[2][2];
+  int r_row_;
+  int r_col_;
+  int g_parity_;
+};
+
+/** Separate the CFA samples into a 3-channel (BGR) image in a single pass
+ *
+ *  Each destination pixel holds the source value in the channel of its
+ *  filter color and zero in the other two channels.
+ *
+ *  \param[in] src     source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+ *  \param[in] cfa     the CFA layout of the source
+ *  \param[in] depth   destination depth CV_8U | CV_16U | CV_32F
+ *
+ *  \return            destination cv::Mat of 3 channels of the provided depth
+ */
+cv::Mat ExtractCfaPlanes(const cv::Mat& src, const Cfa& cfa, int depth);
+
+/** Separate the CFA samples into a provided 3-channel (BGR) image
+ *
+ *  \param[in] src        source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+ *  \param[in] cfa        the CFA layout of the source
+ *  \param[in] depth      destination depth CV_8U | CV_16U | CV_32F
+ *  \param[out] dst       destination cv::Mat of 3 channels of the provided
+ *                        depth (reallocated only if its size or type differ)
+ *  \param[in] nstripes   parallel stripes as for cv::parallel_for_, 1 runs
+ *                        in the calling thread [default is automatic]
+ */
+void ExtractCfaPlanes(const cv::Mat& src, const Cfa& cfa, int depth,
+                      cv::Mat& dst, double nstripes = -1);
+}
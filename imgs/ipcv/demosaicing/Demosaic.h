@@ -8,5 +8,7 @@
 #pragma once
 
 #include "imgs/ipcv/demosaicing/Bilinear.h"
+#include "imgs/ipcv/demosaicing/Cfa.h"
 #include "imgs/ipcv/demosaicing/GBTF.h"
 #include "imgs/ipcv/demosaicing/LarochePrescott.h"
+#include "imgs/ipcv/demosaicing/MalvarHeCutler.h"
@@ -8,10 +8,14 @@
  * https://drive.google.com/drive/folders/1nACYAHjI-DPuEi61Pr26Pu_ACZ88dOCn?usp=sharing
  */
 
+#include <climits>
+#include <cmath>
+#include <iostream>
 #include <vector>
-#include <opencv2/opencv.hpp>
+
 #include <opencv2/core.hpp>
-#include <opencv2/imgproc.hpp>
+
+#include "Cfa.h"
 #include "GBTF.h"
 
 using namespace std;
@@ -19,425 +23,382 @@ using namespace cv;
 
 namespace ipcv {
 
-void GBTF(const Mat& src, Mat& dst, string pattern) {
-  // Carl's bayer masking code but modified
-  // The mask is hardcoded to RGGB and the image is shifted around by 1 pixel to
-  // fit
-  Mat src_dupe = src.clone();
-  int b_row = 1;
-  int b_col = 1;
-  int r_row = 0;
-  int r_col = 0;
-  if (pattern == "GBRG") {
-    copyMakeBorder(src_dupe, src_dupe, 1, 1, 0, 0, cv::BORDER_REFLECT_101);
-  } else if (pattern == "GRBG") {
-    copyMakeBorder(src_dupe, src_dupe, 0, 0, 1, 1, cv::BORDER_REFLECT_101);
-  } else if (pattern == "BGGR") {
-    copyMakeBorder(src_dupe, src_dupe, 1, 1, 1, 1, cv::BORDER_REFLECT_101);
-  } else if (pattern == "RGGB") {
-    // Nothing to do here but it's a valid option
-  } else {
-    cerr << "Invalid CFA pattern provided: " << pattern << endl;
-    exit(EXIT_FAILURE);
-  }
-  Mat b_mask = Mat::zeros(src_dupe.size(), CV_16UC1);
-  for (int r = b_row; r < src_dupe.rows; r += 2) {
-    for (int c = b_col; c < src_dupe.cols; c += 2) {
-      b_mask.at<uint16_t>(r, c) = 1;
+namespace {
+
+// Columns of reflected padding kept on either side of every buffered row
+// (the directional 5-wide windows reach 4 columns to one side)
+const int kPad = 4;
+
+// Rows of the output processed per parallel band
+const int kBandRows = 64;
+
+// Smallest CFA extent for which a row window folded at the image boundary
+// stays inside the buffered rows of every stage
+const int kMinExtent = 16;
+
+/* Ring buffer of padded rows for one pipeline stage
+ *
+ * Each slot holds the planes of one image row; the row a slot currently
+ * holds is tagged so a stage is only computed once per row as long as the
+ * rows it is asked for advance through the image.
+ */
+class RowRing {
+ public:
+  RowRing(int slots, int planes, int cols)
+      : slots_(slots),
+        planes_(planes),
+        stride_(cols + 2 * kPad),
+        held_(slots, INT_MIN),
+        data_(static_cast<size_t>(slots) * planes * stride_, 0.0f) {}
+
+  /* Claim the slot for the provided row, returns false if the row is
+   * already held (and so need not be computed)
+   */
+  bool Claim(int row) {
+    int& held = held_[Slot(row)];
+    if (held == row) {
+      return false;
     }
+    held = row;
+    return true;
   }
-  Mat r_mask = Mat::zeros(src_dupe.size(), CV_16UC1);
-  for (int r = r_row; r < src_dupe.rows; r += 2) {
-    for (int c = r_col; c < src_dupe.cols; c += 2) {
-      r_mask.at<uint16_t>(r, c) = 1;
-    }
+
+  /* Pointer to column 0 of a plane of the provided row
+   */
+  float* Ptr(int row, int plane) {
+    return data_.data() +
+           (static_cast<size_t>(Slot(row)) * planes_ + plane) * stride_ + kPad;
   }
 
-  // Create green (G) filter location mask
-  Mat g_mask = Mat::ones(src_dupe.size(), CV_16UC1);
-  cv::subtract(g_mask, b_mask, g_mask);
-  cv::subtract(g_mask, r_mask, g_mask);
-
-  // Initialize interpolated B, G, and R channels
-  Mat B;
-  cv::multiply(src_dupe, b_mask, B);
-  Mat G;
-  cv::multiply(src_dupe, g_mask, G);
-  Mat R;
-  cv::multiply(src_dupe, r_mask, R);
-
-  Mat channels[3];
-  channels[0] = B;
-  channels[1] = G;
-  channels[2] = R;
-
-  // Merging to convert to 32F and then immediately splitting again so no seg
-  // faults. Efficient I know
-  cv::merge(channels, 3, src_dupe);
-  src_dupe.convertTo(src_dupe, CV_32F);
-  vector<Mat> OrigChannels(3), OutputChannels(3);
-  split(src_dupe, OrigChannels);
-  split(src_dupe, OutputChannels);
-
-  // Giving the frame a 2 pixel repeating border so interpolation can occur on
-  // the edges
-  copyMakeBorder(OrigChannels[0], OrigChannels[0], 2, 2, 2, 2,
-                 cv::BORDER_DEFAULT);
-  copyMakeBorder(OrigChannels[1], OrigChannels[1], 2, 2, 2, 2,
-                 cv::BORDER_DEFAULT);
-  copyMakeBorder(OrigChannels[2], OrigChannels[2], 2, 2, 2, 2,
-                 cv::BORDER_DEFAULT);
-
-  Mat Horiz_Map(src_dupe.size(), CV_32F, cv::Scalar(0));
-  Mat Vert_Map(src_dupe.size(), CV_32F, cv::Scalar(0));
-  float Horiz_R, Vert_R, Horiz_G, Vert_G, Horiz_B, Vert_B;
-
-  // Creating horizontal and vertical red/blue pixel estimations at green pixel
-  // locations Using Hamilton and Adams' formula
-  for (int row = 0; row < src_dupe.rows; row++) {
-    for (int col = 0; col < src_dupe.cols; col++) {
-      // i and j are the actual pixel locations because we added the 2 pixel
-      // border
-      int i = row + 2;
-      int j = col + 2;
-      // Red cases
-      if (row % 2 == 0 && col % 2 == 0) {
-        Horiz_G = (OrigChannels[1].at<float>(i, j - 1) +
-                   OrigChannels[1].at<float>(i, j + 1)) *
-                      0.5 +
-                  (2 * OrigChannels[2].at<float>(i, j) -
-                   OrigChannels[2].at<float>(i, j - 2) -
-                   OrigChannels[2].at<float>(i, j + 2)) *
-                      0.25;
-        Vert_G = (OrigChannels[1].at<float>(i - 1, j) +
-                  OrigChannels[1].at<float>(i + 1, j)) *
-                     0.5 +
-                 (2 * OrigChannels[2].at<float>(i, j) -
-                  OrigChannels[2].at<float>(i - 2, j) -
-                  OrigChannels[2].at<float>(i + 2, j)) *
-                     0.25;
-        Horiz_Map.at<float>(row, col) =
-            Horiz_G - OrigChannels[2].at<float>(i, j);
-        Vert_Map.at<float>(row, col) = Vert_G - OrigChannels[2].at<float>(i, j);
-        // Blue cases
-      } else if (row % 2 == 1 && col % 2 == 1) {
-        Horiz_G = (OrigChannels[1].at<float>(i, j - 1) +
-                   OrigChannels[1].at<float>(i, j + 1)) *
-                      0.5 +
-                  (2 * OrigChannels[0].at<float>(i, j) -
-                   OrigChannels[0].at<float>(i, j - 2) -
-                   OrigChannels[0].at<float>(i, j + 2)) *
-                      0.25;
-        Vert_G = (OrigChannels[1].at<float>(i - 1, j) +
-                  OrigChannels[1].at<float>(i + 1, j)) *
-                     0.5 +
-                 (2 * OrigChannels[0].at<float>(i, j) -
-                  OrigChannels[0].at<float>(i - 2, j) -
-                  OrigChannels[0].at<float>(i + 2, j)) *
-                     0.25;
-        Horiz_Map.at<float>(row, col) =
-            Horiz_G - OrigChannels[0].at<float>(i, j);
-        Vert_Map.at<float>(row, col) = Vert_G - OrigChannels[0].at<float>(i, j);
-        // Green cases where red is above/below
-      } else if (row % 2 == 1 && col % 2 == 0) {
-        Horiz_B = (OrigChannels[0].at<float>(i, j - 1) +
-                   OrigChannels[0].at<float>(i, j + 1)) *
-                      0.5 +
-                  (2 * OrigChannels[1].at<float>(i, j) -
-                   OrigChannels[1].at<float>(i, j - 2) -
-                   OrigChannels[1].at<float>(i, j + 2)) *
-                      0.25;
-        Vert_R = (OrigChannels[2].at<float>(i - 1, j) +
-                  OrigChannels[2].at<float>(i + 1, j)) *
-                     0.5 +
-                 (2 * OrigChannels[1].at<float>(i, j) -
-                  OrigChannels[1].at<float>(i - 2, j) -
-                  OrigChannels[1].at<float>(i + 2, j)) *
-                     0.25;
-        Horiz_Map.at<float>(row, col) =
-            OrigChannels[1].at<float>(i, j) - Horiz_B;
-        Vert_Map.at<float>(row, col) = OrigChannels[1].at<float>(i, j) - Vert_R;
-        // Green cases where blue is above/below
-      } else {
-        Horiz_R = (OrigChannels[2].at<float>(i, j - 1) +
-                   OrigChannels[2].at<float>(i, j + 1)) *
-                      0.5 +
-                  (2 * OrigChannels[1].at<float>(i, j) -
-                   OrigChannels[1].at<float>(i, j - 2) -
-                   OrigChannels[1].at<float>(i, j + 2)) *
-                      0.25;
-        Vert_B = (OrigChannels[0].at<float>(i - 1, j) +
-                  OrigChannels[0].at<float>(i + 1, j)) *
-                     0.5 +
-                 (2 * OrigChannels[1].at<float>(i, j) -
-                  OrigChannels[1].at<float>(i - 2, j) -
-                  OrigChannels[1].at<float>(i + 2, j)) *
-                     0.25;
-        Horiz_Map.at<float>(row, col) =
-            OrigChannels[1].at<float>(i, j) - Horiz_R;
-        Vert_Map.at<float>(row, col) = OrigChannels[1].at<float>(i, j) - Vert_B;
-      }
-    }
+ private:
+  int Slot(int row) const { return ((row % slots_) + slots_) % slots_; }
+
+  int slots_;
+  int planes_;
+  int stride_;
+  vector<int> held_;
+  vector<float> data_;
+};
+
+/* Fill the padding of a row by reflection about its first and last columns
+ * (BORDER_REFLECT_101, which preserves the CFA phase)
+ */
+void ReflectPad(float* row, int cols) {
+  for (int k = 1; k <= kPad; k++) {
+    row[-k] = row[k];
+    row[cols - 1 + k] = row[cols - 1 - k];
   }
+}
 
-  // 4 pixel border to prepare for future neighborhood interpolation
-  copyMakeBorder(Vert_Map, Vert_Map, 4, 4, 4, 4, cv::BORDER_DEFAULT);
-  copyMakeBorder(Horiz_Map, Horiz_Map, 4, 4, 4, 4, cv::BORDER_DEFAULT);
-
-  // Color difference gradients.
-  Mat Vert_Gradient;
-  Mat Horiz_Gradient;
-
-  // Creating quick kernels for subtracting sides from each other
-  float kernel[3] = {-1, 0, 1};
-  Mat Horiz_Kernel(1, 3, CV_32F, kernel);
-  Mat Vert_Kernel(3, 1, CV_32F, kernel);
-
-  // Essentially taking the difference of the pixels on either side of the
-  // target difference map pixel
-  cv::filter2D(Horiz_Map, Horiz_Gradient, -1, Horiz_Kernel);
-  cv::filter2D(Vert_Map, Vert_Gradient, -1, Vert_Kernel);
-
-  // Finally taking the absolute value
-  Horiz_Gradient = cv::abs(Horiz_Gradient);
-  Vert_Gradient = cv::abs(Vert_Gradient);
-
-  // Matrices that will store the difference values that inform red pixel values
-  // at green pixel locations and so on for blue
-  Mat Delta_GR(src_dupe.size(), CV_32F, cv::Scalar(0));
-  Mat Delta_GB(src_dupe.size(), CV_32F, cv::Scalar(0));
-
-  // Values go in order of N, S, W, E
-  float Weight[4];
-
-  // The little numbers on the weight summations in the paper
-  int ShiftAmount[4][2] = {{-4, -2}, {0, -2}, {-2, -4}, {-2, 0}};
-  int Shift_X, Shift_Y;
-  float Weight_Sum;
-
-  // Calculating weights and then forming a final green difference estimation
-  for (int row = 0; row < src_dupe.rows; row++) {
-    // Offset the column on every other row to match the green pixel locations
-    int col = 0;
-    if (row % 2 == 1) {
-      col = 1;
+/* Line-buffered GBTF pipeline
+ *
+ * Every stage produces whole rows into its own ring and pulls the rows it
+ * depends on from the previous stage on demand:
+ *
+ *   mosaic       CFA row as float
+ *   differences  Hamilton and Adams horizontal/vertical color differences
+ *                (green minus chroma at every site)
+ *   gradients    |d(+1) - d(-1)| of the horizontal/vertical differences
+ *   sums         5-row column sums of the vertical gradients and differences
+ *                ending at the row (the N window of a row, the S window of
+ *                the row 4 above)
+ *   green        gradient-weighted green difference at R/B sites and the
+ *                completed green row
+ *   color        R/B at B/R sites from the Paliy et al. 7x7 filter
+ *
+ * and R/B at green sites are formed as the final row is written.  All rows
+ * outside of the image are reflections (BORDER_REFLECT_101) of rows inside.
+ */
+class GbtfPipeline {
+ public:
+  GbtfPipeline(const Mat& src, const Cfa& cfa)
+      : src_(src),
+        cfa_(cfa),
+        rows_(src.rows),
+        cols_(src.cols),
+        mosaic_(16, 1, cols_),
+        differences_(8, 2, cols_),
+        gradients_(8, 2, cols_),
+        sums_(8, 2, cols_),
+        green_(8, 2, cols_),
+        color_(4, 3, cols_),
+        horizontal_(cols_ + 2 * kPad) {}
+
+  /* Demosaic the provided row into the destination row
+   */
+  void Row(int y, Vec3b* dst) {
+    const float* above[3];
+    const float* center[3];
+    const float* below[3];
+    int up = Color(y - 1);
+    int down = Color(y + 1);
+    int row = Color(y);
+    for (int ch = 0; ch < 3; ch++) {
+      above[ch] = color_.Ptr(up, ch);
+      center[ch] = color_.Ptr(row, ch);
+      below[ch] = color_.Ptr(down, ch);
     }
-    for (; col < src_dupe.cols; col += 2) {
-      Weight[0] = 0.0;  // N
-      Weight[1] = 0.0;  // S
-      Weight[2] = 0.0;  // W
-      Weight[3] = 0.0;  // E
-      Weight_Sum = 0.0;
-
-      for (int nswe = 0; nswe < 4; nswe++) {
-        Shift_X = ShiftAmount[nswe][0];
-        Shift_Y = ShiftAmount[nswe][1];
-
-        // 5 x 5 neighborhood
-        for (int i = 0; i < 5; i++) {
-          for (int j = 0; j < 5; j++) {
-            // Vertical cases
-            if (nswe < 2) {
-              Weight[nswe] += Vert_Gradient.at<float>(4 + row + Shift_X + i,
-                                                      4 + col + Shift_Y + j);
-              // Horizontal cases
-            } else {
-              Weight[nswe] += Horiz_Gradient.at<float>(4 + row + Shift_X + i,
-                                                       4 + col + Shift_Y + j);
-            }
-          }
-        }
 
-        // Square final value
-        Weight[nswe] *= Weight[nswe];
-        // Make reciprocal but only if it's not 0 bc div/0 is bad
-        if (Weight[nswe] != 0) {
-          Weight[nswe] = 1.0 / Weight[nswe];
-        } else {
-          Weight[nswe] = 0;
-        }
-        // Add on to sum
-        Weight_Sum += Weight[nswe];
+    for (int c = 0; c < cols_; c++) {
+      dst[c][0] = saturate_cast<uchar>(center[0][c]);
+      dst[c][1] = saturate_cast<uchar>(center[1][c]);
+      dst[c][2] = saturate_cast<uchar>(center[2][c]);
+    }
+
+    // R and B at green sites from the mean color difference of the four
+    // (R/B site) neighbors
+    const float* g = center[1];
+    for (int ch = 0; ch < 3; ch += 2) {
+      const float* x = center[ch];
+      for (int c = GreenStart(y); c < cols_; c += 2) {
+        float difference = (above[1][c] - above[ch][c]) +
+                           (below[1][c] - below[ch][c]) +
+                           (g[c - 1] - x[c - 1]) + (g[c + 1] - x[c + 1]);
+        dst[c][ch] = saturate_cast<uchar>(g[c] - 0.25f * difference);
       }
+    }
+  }
+
+ private:
+  int Reflect(int y) const {
+    return borderInterpolate(y, rows_, BORDER_REFLECT_101);
+  }
 
-      // Compensating for 4 pixel border
-      int i = row + 4;
-      int j = col + 4;
-      // Green pixels at red locations
-      if (row % 2 == 0) {
-        // Once again checking for div/0
-        if (Weight_Sum != 0) {
-          Delta_GR.at<float>(row, col) =
-              (Weight[0] * 0.2 *
-                   (Vert_Map.at<float>(i - 4, j) +
-                    Vert_Map.at<float>(i - 3, j) +
-                    Vert_Map.at<float>(i - 2, j) +
-                    Vert_Map.at<float>(i - 1, j) + Vert_Map.at<float>(i, j)) +
-               Weight[1] * 0.2 *
-                   (Vert_Map.at<float>(i, j) + Vert_Map.at<float>(i + 1, j) +
-                    Vert_Map.at<float>(i + 2, j) +
-                    Vert_Map.at<float>(i + 3, j) +
-                    Vert_Map.at<float>(i + 4, j)) +
-               Weight[2] * 0.2 *
-                   (Horiz_Map.at<float>(i, j - 4) +
-                    Horiz_Map.at<float>(i, j - 3) +
-                    Horiz_Map.at<float>(i, j - 2) +
-                    Horiz_Map.at<float>(i, j - 1) + Horiz_Map.at<float>(i, j)) +
-               Weight[3] * 0.2 *
-                   (Horiz_Map.at<float>(i, j) + Horiz_Map.at<float>(i, j + 1) +
-                    Horiz_Map.at<float>(i, j + 2) +
-                    Horiz_Map.at<float>(i, j + 3) +
-                    Horiz_Map.at<float>(i, j + 4))) /
-              Weight_Sum;
-        } else {
-          Delta_GR.at<float>(row, col) = 0;
+  int GreenStart(int y) const { return cfa_.is_green(y, 0) ? 0 : 1; }
+
+  int Mosaic(int y) {
+    y = Reflect(y);
+    if (mosaic_.Claim(y)) {
+      float* m = mosaic_.Ptr(y, 0);
+      if (src_.depth() == CV_8U) {
+        const uint8_t* s = src_.ptr<uint8_t>(y);
+        for (int c = 0; c < cols_; c++) {
+          m[c] = s[c];
         }
-        // Adding difference value on to known R pixel value to get final
-        // interpolated G value
-        OutputChannels[1].at<float>(row, col) =
-            OutputChannels[2].at<float>(row, col) +
-            Delta_GR.at<float>(row, col);  // R + Delta_GB
-        // Green pixels at red locations
       } else {
-        if (Weight_Sum != 0) {
-          Delta_GB.at<float>(row, col) =
-              (Weight[0] * 0.2 *
-                   (Vert_Map.at<float>(i - 4, j) +
-                    Vert_Map.at<float>(i - 3, j) +
-                    Vert_Map.at<float>(i - 2, j) +
-                    Vert_Map.at<float>(i - 1, j) + Vert_Map.at<float>(i, j)) +
-               Weight[1] * 0.2 *
-                   (Vert_Map.at<float>(i, j) + Vert_Map.at<float>(i + 1, j) +
-                    Vert_Map.at<float>(i + 2, j) +
-                    Vert_Map.at<float>(i + 3, j) +
-                    Vert_Map.at<float>(i + 4, j)) +
-               Weight[2] * 0.2 *
-                   (Horiz_Map.at<float>(i, j - 4) +
-                    Horiz_Map.at<float>(i, j - 3) +
-                    Horiz_Map.at<float>(i, j - 2) +
-                    Horiz_Map.at<float>(i, j - 1) + Horiz_Map.at<float>(i, j)) +
-               Weight[3] * 0.2 *
-                   (Horiz_Map.at<float>(i, j) + Horiz_Map.at<float>(i, j + 1) +
-                    Horiz_Map.at<float>(i, j + 2) +
-                    Horiz_Map.at<float>(i, j + 3) +
-                    Horiz_Map.at<float>(i, j + 4))) /
-              Weight_Sum;
-        } else {
-          Delta_GB.at<float>(row, col) = 0;
+        const uint16_t* s = src_.ptr<uint16_t>(y);
+        for (int c = 0; c < cols_; c++) {
+          m[c] = s[c];
         }
-        OutputChannels[1].at<float>(row, col) =
-            OutputChannels[0].at<float>(row, col) +
-            Delta_GB.at<float>(row, col);  // B + Delta_GB
       }
+      ReflectPad(m, cols_);
     }
+    return y;
   }
 
-  // Filter from Paliy et al. to determine red pixel values at blue locations
-  // and vice versa
-  float RB_Filter_Values[49] = {
-      0,        0, -0.03125, 0, -0.03125, 0, 0,        0, 0, 0, 0, 0, 0, 0,
-      -0.03125, 0, 0.3125,   0, 0.3125,   0, -0.03125, 0, 0, 0, 0, 0, 0, 0,
-      -0.03125, 0, 0.3125,   0, 0.3125,   0, -0.03125, 0, 0, 0, 0, 0, 0, 0,
-      0,        0, -0.03125, 0, -0.03125, 0, 0};
-  Mat Filter_RB(7, 7, CV_32FC1, RB_Filter_Values);
-
-  // 3 pixel border for more averaging purposes
-  copyMakeBorder(Delta_GR, Delta_GR, 3, 3, 3, 3, cv::BORDER_DEFAULT);
-  copyMakeBorder(Delta_GB, Delta_GB, 3, 3, 3, 3, cv::BORDER_DEFAULT);
-
-  for (int row = 0; row < src.rows; row++) {
-    // Similar trick as above
-    int col = 0;
-    if (row % 2 == 1) {
-      col = 1;
+  int Differences(int y) {
+    y = Reflect(y);
+    if (differences_.Claim(y)) {
+      const float* m[5];
+      for (int k = 0; k < 5; k++) {
+        m[k] = mosaic_.Ptr(Mosaic(y + k - 2), 0);
+      }
+      const float* mc = m[2];
+      float* dh = differences_.Ptr(y, 0);
+      float* dv = differences_.Ptr(y, 1);
+
+      // Hamilton and Adams estimate of the missing color minus the sample
+      for (int c = 0; c < cols_; c++) {
+        dh[c] = 0.5f * (mc[c - 1] + mc[c + 1]) +
+                0.25f * (2 * mc[c] - mc[c - 2] - mc[c + 2]) - mc[c];
+        dv[c] = 0.5f * (m[1][c] + m[3][c]) +
+                0.25f * (2 * mc[c] - m[0][c] - m[4][c]) - mc[c];
+      }
+
+      // At green sites the sample is green, so negate to keep green minus
+      // chroma everywhere
+      for (int c = GreenStart(y); c < cols_; c += 2) {
+        dh[c] = -dh[c];
+        dv[c] = -dv[c];
+      }
+      ReflectPad(dh, cols_);
+      ReflectPad(dv, cols_);
     }
-    for (; col < src.cols; col += 2) {
-      // Blue pixels at red locations
-      if (row % 2 == 0) {
-        OutputChannels[0].at<float>(row, col) =
-            OutputChannels[1].at<float>(row, col) -
-            cv::sum(Delta_GB(cv::Range(3 + row - 3, 3 + row + 3 + 1),
-                             cv::Range(3 + col - 3, 3 + col + 3 + 1))
-                        .mul(Filter_RB))[0];
-        // Red pixels at blue locations
-      } else {
-        OutputChannels[2].at<float>(row, col) =
-            OutputChannels[1].at<float>(row, col) -
-            cv::sum(Delta_GR(cv::Range(3 + row - 3, 3 + row + 3 + 1),
-                             cv::Range(3 + col - 3, 3 + col + 3 + 1))
-                        .mul(Filter_RB))[0];
+    return y;
+  }
+
+  int Gradients(int y) {
+    y = Reflect(y);
+    if (gradients_.Claim(y)) {
+      const float* above = differences_.Ptr(Differences(y - 1), 1);
+      const float* below = differences_.Ptr(Differences(y + 1), 1);
+      const float* dh = differences_.Ptr(Differences(y), 0);
+      float* gh = gradients_.Ptr(y, 0);
+      float* gv = gradients_.Ptr(y, 1);
+      for (int c = 0; c < cols_; c++) {
+        gh[c] = fabs(dh[c + 1] - dh[c - 1]);
+        gv[c] = fabs(below[c] - above[c]);
       }
+      ReflectPad(gh, cols_);
+      ReflectPad(gv, cols_);
     }
+    return y;
   }
 
-  // 1 pixel border for bilinear interpolation
-  copyMakeBorder(OutputChannels[0], OrigChannels[0], 1, 1, 1, 1,
-                 cv::BORDER_DEFAULT);
-  copyMakeBorder(OutputChannels[1], OrigChannels[1], 1, 1, 1, 1,
-                 cv::BORDER_DEFAULT);
-  copyMakeBorder(OutputChannels[2], OrigChannels[2], 1, 1, 1, 1,
-                 cv::BORDER_DEFAULT);
-
-  for (int row = 0; row < src_dupe.rows; row++) {
-    int col = 0;
-    if (row % 2 == 0) {
-      col = 1;
+  /* Column sums over rows y-4 through y (y may lie outside of the image
+   * since the S window of the last rows extends below it)
+   */
+  int Sums(int y) {
+    if (sums_.Claim(y)) {
+      const float* g[5];
+      const float* d[5];
+      for (int k = 0; k < 5; k++) {
+        g[k] = gradients_.Ptr(Gradients(y - 4 + k), 1);
+      }
+      for (int k = 0; k < 5; k++) {
+        d[k] = differences_.Ptr(Differences(y - 4 + k), 1);
+      }
+      float* gv = sums_.Ptr(y, 0);
+      float* dv = sums_.Ptr(y, 1);
+      for (int c = -kPad; c < cols_ + kPad; c++) {
+        gv[c] = g[0][c] + g[1][c] + g[2][c] + g[3][c] + g[4][c];
+        dv[c] = d[0][c] + d[1][c] + d[2][c] + d[3][c] + d[4][c];
+      }
     }
-    for (; col < src_dupe.cols; col += 2) {
-      int i = row + 1;
-      int j = col + 1;
-      // Red pixels at green locations
-      OutputChannels[2].at<float>(row, col) =
-          OutputChannels[1].at<float>(row, col) -
-          (OrigChannels[1].at<float>(i - 1, j) -
-           OrigChannels[2].at<float>(i - 1, j)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i + 1, j) -
-           OrigChannels[2].at<float>(i + 1, j)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i, j - 1) -
-           OrigChannels[2].at<float>(i, j - 1)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i, j + 1) -
-           OrigChannels[2].at<float>(i, j + 1)) /
-              4.0;
-      // Blue pixels at green locations
-      OutputChannels[0].at<float>(row, col) =
-          OutputChannels[1].at<float>(row, col) -
-          (OrigChannels[1].at<float>(i - 1, j) -
-           OrigChannels[0].at<float>(i - 1, j)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i + 1, j) -
-           OrigChannels[0].at<float>(i + 1, j)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i, j - 1) -
-           OrigChannels[0].at<float>(i, j - 1)) /
-              4.0 -
-          (OrigChannels[1].at<float>(i, j + 1) -
-           OrigChannels[0].at<float>(i, j + 1)) /
-              4.0;
+    return y;
+  }
+
+  int Green(int y) {
+    y = Reflect(y);
+    if (green_.Claim(y)) {
+      int north_row = Sums(y);
+      int south_row = Sums(y + 4);
+      const float* north_g = sums_.Ptr(north_row, 0);
+      const float* north_d = sums_.Ptr(north_row, 1);
+      const float* south_g = sums_.Ptr(south_row, 0);
+      const float* south_d = sums_.Ptr(south_row, 1);
+
+      // 5-row column sums of the horizontal gradients centered on the row
+      const float* gh[5];
+      for (int k = 0; k < 5; k++) {
+        gh[k] = gradients_.Ptr(Gradients(y - 2 + k), 0);
+      }
+      float* h = horizontal_.data() + kPad;
+      for (int c = -kPad; c < cols_ + kPad; c++) {
+        h[c] = gh[0][c] + gh[1][c] + gh[2][c] + gh[3][c] + gh[4][c];
+      }
+
+      const float* dh = differences_.Ptr(Differences(y), 0);
+      const float* m = mosaic_.Ptr(Mosaic(y), 0);
+      float* g = green_.Ptr(y, 0);
+      float* delta = green_.Ptr(y, 1);
+
+      // Directional weights are the inverse squared 5x5 gradient sums, the
+      // estimate is their weighted mean of the directional 5-sample means
+      for (int c = 0; c < cols_; c++) {
+        float s_n = north_g[c - 2] + north_g[c - 1] + north_g[c] +
+                    north_g[c + 1] + north_g[c + 2];
+        float s_s = south_g[c - 2] + south_g[c - 1] + south_g[c] +
+                    south_g[c + 1] + south_g[c + 2];
+        float s_w = h[c - 4] + h[c - 3] + h[c - 2] + h[c - 1] + h[c];
+        float s_e = h[c] + h[c + 1] + h[c + 2] + h[c + 3] + h[c + 4];
+        float w_n = (s_n != 0) ? 1.0f / (s_n * s_n) : 0.0f;
+        float w_s = (s_s != 0) ? 1.0f / (s_s * s_s) : 0.0f;
+        float w_w = (s_w != 0) ? 1.0f / (s_w * s_w) : 0.0f;
+        float w_e = (s_e != 0) ? 1.0f / (s_e * s_e) : 0.0f;
+        float w_sum = w_n + w_s + w_w + w_e;
+
+        float m_w = dh[c - 4] + dh[c - 3] + dh[c - 2] + dh[c - 1] + dh[c];
+        float m_e = dh[c] + dh[c + 1] + dh[c + 2] + dh[c + 3] + dh[c + 4];
+        float estimate = 0.2f * (w_n * north_d[c] + w_s * south_d[c] +
+                                 w_w * m_w + w_e * m_e);
+        delta[c] = (w_sum != 0) ? estimate / w_sum : 0.0f;
+        g[c] = m[c] + delta[c];
+      }
+
+      // Green sites keep their sample
+      for (int c = GreenStart(y); c < cols_; c += 2) {
+        delta[c] = 0.0f;
+        g[c] = m[c];
+      }
+      ReflectPad(g, cols_);
+      ReflectPad(delta, cols_);
     }
+    return y;
   }
 
-  // Combining channels for final output
-  merge(OutputChannels, dst);
-
-  // Shifting pixels back to their original location
-  if (pattern == "GBRG") {
-    dst = dst(Rect(0, 1, src_dupe.cols, src_dupe.rows - 2));
-  } else if (pattern == "GRBG") {
-    dst = dst(Rect(1, 0, src_dupe.cols - 2, src_dupe.rows));
-  } else if (pattern == "BGGR") {
-    dst = dst(Rect(1, 1, src_dupe.cols - 2, src_dupe.rows - 2));
-  } else if (pattern == "RGGB") {
-  } else {
-    cerr << "Invalid CFA pattern provided: " << pattern << endl;
-    exit(EXIT_FAILURE);
+  int Color(int y) {
+    y = Reflect(y);
+    if (color_.Claim(y)) {
+      const float* d[7];
+      for (int k = 0; k < 7; k++) {
+        d[k] = green_.Ptr(Green(y - 3 + k), 1);
+      }
+      const float* g = green_.Ptr(Green(y), 0);
+      const float* m = mosaic_.Ptr(Mosaic(y), 0);
+
+      float* planes[3];
+      for (int ch = 0; ch < 3; ch++) {
+        planes[ch] = color_.Ptr(y, ch);
+      }
+      std::copy(g, g + cols_, planes[1]);
+
+      // At R/B sites the sample is one chroma channel and the other is the
+      // green less the filtered differences at the diagonal neighbors (only
+      // sites of the other chroma color are read)
+      int c0 = 1 - GreenStart(y);
+      int own = cfa_.color(y, c0);
+      float* x = planes[own];
+      float* other = planes[2 - own];
+      std::fill(x, x + cols_, 0.0f);
+      std::fill(other, other + cols_, 0.0f);
+      for (int c = c0; c < cols_; c += 2) {
+        float filtered =
+            0.3125f * (d[2][c - 1] + d[2][c + 1] + d[4][c - 1] + d[4][c + 1]) -
+            0.03125f * (d[0][c - 1] + d[0][c + 1] + d[6][c - 1] + d[6][c + 1] +
+                        d[2][c - 3] + d[2][c + 3] + d[4][c - 3] + d[4][c + 3]);
+        x[c] = m[c];
+        other[c] = g[c] - filtered;
+      }
+      for (int ch = 0; ch < 3; ch++) {
+        ReflectPad(planes[ch], cols_);
+      }
+    }
+    return y;
   }
 
-  // Converting to 8U for display purposes
-  dst.convertTo(dst, CV_8U);
+  const Mat& src_;
+  Cfa cfa_;
+  int rows_;
+  int cols_;
+  RowRing mosaic_;
+  RowRing differences_;
+  RowRing gradients_;
+  RowRing sums_;
+  RowRing green_;
+  RowRing color_;
+  vector<float> horizontal_;
+};
+
+}  // namespace
+
+void GBTF(const Mat& src, Mat& dst, string pattern, double nstripes) {
+  Cfa cfa(pattern);
+
+  if ((src.type() != CV_8UC1) && (src.type() != CV_16UC1)) {
+    cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((src.rows < kMinExtent) || (src.cols < kMinExtent)) {
+    cerr << "Source CFA image must be at least " << kMinExtent << " x "
+         << kMinExtent << endl;
+    exit(EXIT_FAILURE);
+  }
 
-  return;
+  // The source header is held so that it stays valid should the
+  // destination be the same cv::Mat (output is 8-bit for display purposes)
+  Mat in = src;
+  dst.create(in.size(), CV_8UC3);
+
+  // Each band primes its own rings, so only the pipeline depth (about a
+  // dozen rows) is recomputed at the top of a band
+  int bands = (in.rows + kBandRows - 1) / kBandRows;
+  parallel_for_(Range(0, bands), [&](const Range& range) {
+    GbtfPipeline pipeline(in, cfa);
+    int y1 = min(range.end * kBandRows, in.rows);
+    for (int y = range.start * kBandRows; y < y1; y++) {
+      pipeline.Row(y, dst.ptr<Vec3b>(y));
+    }
+  }, nstripes);
 }
-}  // namespace ipcv
\ No newline at end of file
+}  // namespace ipcv
@@ -18,8 +18,15 @@ namespace ipcv {
 
 /** Interpolate CFA using GBTF interpolation
  *
- *  \param[in] src       source cv::Mat of CV_16UC1 containing CFA
+ *  The image is processed in parallel row bands, each streaming through a
+ *  line-buffered pipeline (Hamilton-Adams differences, gradients, weighted
+ *  green, then R/B) that holds a few dozen padded rows per stage rather
+ *  than full-size intermediate images.
+ *
+ *  \param[in] src       source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+ *                       (at least 16 x 16)
  *  \param[in] dst       destination cv::Mat of CV_8UC3 containing image
+ *                       (reallocated only if its size or type differ)
  *  \param[in] pattern   a string defining the CFA layout:
  *                         'GBRG'  -  G B  Raspberry Pi (OmniVision OV5647)
  *                                    R G
@@ -29,8 +36,11 @@ namespace ipcv {
  *                                    G R
  *                         'RGGB'  -  R G
  *                                    G B
+ *  \param[in] nstripes  parallel stripes as for cv::parallel_for_, 1 runs
+ *                       in the calling thread [default is automatic]
  *
  *  \return              none (void)
  */
-void GBTF(const cv::Mat &src, cv::Mat &dst, string pattern);
+void GBTF(const cv::Mat &src, cv::Mat &dst, string pattern,
+          double nstripes = -1);
 }
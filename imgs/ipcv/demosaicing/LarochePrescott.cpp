@@ -6,71 +6,80 @@
  *  \date 07 Jan 2019
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
 
-#include "Bilinear.h"
+#include "Cfa.h"
+#include "LarochePrescott.h"
 
 using namespace std;
 
 namespace ipcv {
 
-cv::Mat LarochePrescott(const cv::Mat& src, string pattern, int max_value) {
-  // Create blue (B) and red (R) filter location masks
-  int b_row;
-  int b_col;
-  int r_row;
-  int r_col;
-  if (pattern == "GBRG") {
-    b_row = 0;
-    b_col = 1;
-    r_row = 1;
-    r_col = 0;
-  } else if (pattern == "GRBG") {
-    b_row = 1;
-    b_col = 0;
-    r_row = 0;
-    r_col = 1;
-  } else if (pattern == "BGGR") {
-    b_row = 0;
-    b_col = 0;
-    r_row = 1;
-    r_col = 1;
-  } else if (pattern == "RGGB") {
-    b_row = 1;
-    b_col = 1;
-    r_row = 0;
-    r_col = 0;
-  } else {
-    cerr << "Invalid CFA pattern provided: " << pattern << endl;
-    exit(EXIT_FAILURE);
-  }
-  cv::Mat b_mask = cv::Mat::zeros(src.size(), CV_16UC1);
-  for (int r = b_row; r < src.rows; r += 2) {
-    for (int c = b_col; c < src.cols; c += 2) {
-      b_mask.at<uint16_t>(r, c) = 1;
-    }
-  }
-  cv::Mat r_mask = cv::Mat::zeros(src.size(), CV_16UC1);
-  for (int r = r_row; r < src.rows; r += 2) {
-    for (int c = r_col; c < src.cols; c += 2) {
-      r_mask.at<uint16_t>(r, c) = 1;
+namespace {
+
+/* Interpolate green (G) channel according to gradient rules using the
+ * horizontal (alpha) and vertical (beta) edge classifiers computed from
+ * the CFA at each non-green site (the neighbors read are all green sites,
+ * so rows are independent), T is the CFA sample type
+ */
+template <typename T>
+void InterpolateGreen(const cv::Mat& src, const Cfa& cfa, cv::Mat& bgr,
+                      int ul_row, int ul_col, int lr_row, int lr_col,
+                      double nstripes) {
+  cv::parallel_for_(cv::Range(ul_row, max(ul_row, lr_row)),
+                    [&](const cv::Range& range) {
+    float equality_tolerance = 8.0;
+    for (int r = range.start; r < range.end; r++) {
+      const T* cfa_above = src.ptr<T>(r - 2);
+      const T* cfa_center = src.ptr<T>(r);
+      const T* cfa_below = src.ptr<T>(r + 2);
+      const cv::Vec3f* above = bgr.ptr<cv::Vec3f>(r - 1);
+      cv::Vec3f* center = bgr.ptr<cv::Vec3f>(r);
+      const cv::Vec3f* below = bgr.ptr<cv::Vec3f>(r + 1);
+      int c0 = cfa.is_green(r, ul_col) ? ul_col + 1 : ul_col;
+      for (int c = c0; c < lr_col; c += 2) {
+        float value = static_cast<float>(cfa_center[c]);
+        float alpha = abs((static_cast<float>(cfa_center[c - 2]) +
+                           static_cast<float>(cfa_center[c + 2])) /
+                              2 -
+                          value);
+        float beta = abs((static_cast<float>(cfa_above[c]) +
+                          static_cast<float>(cfa_below[c])) /
+                             2 -
+                         value);
+        if (abs(alpha - beta) < equality_tolerance) {
+          center[c][1] = (above[c][1] + center[c - 1][1] + below[c][1] +
+                          center[c + 1][1]) /
+                         4;
+        } else if (alpha < beta) {
+          center[c][1] = (center[c - 1][1] + center[c + 1][1]) / 2;
+        } else if (alpha > beta) {
+          center[c][1] = (above[c][1] + below[c][1]) / 2;
+        }
+      }
     }
-  }
+  }, nstripes);
+}
+
+}  // namespace
 
-  // Create green (G) filter location mask
-  cv::Mat g_mask = cv::Mat::ones(src.size(), CV_16UC1);
-  cv::subtract(g_mask, b_mask, g_mask);
-  cv::subtract(g_mask, r_mask, g_mask);
+cv::Mat LarochePrescott(const cv::Mat& src, string pattern, int max_value) {
+  cv::Mat dst;
+  LarochePrescott(src, dst, pattern, max_value);
+  return dst;
+}
 
-  // Initialize interpolated B, G, and R channels
-  cv::Mat B;
-  cv::multiply(src, b_mask, B, 1, CV_32F);
-  cv::Mat G;
-  cv::multiply(src, g_mask, G, 1, CV_32F);
-  cv::Mat R;
-  cv::multiply(src, r_mask, R, 1, CV_32F);
+void LarochePrescott(const cv::Mat& src, cv::Mat& dst, string pattern,
+                     int max_value, double nstripes) {
+  // Separate the B, G, and R filter sites into their own channels (the
+  // filter color at each location follows from the CFA phase)
+  Cfa cfa(pattern);
+  cv::Mat bgr;
+  ExtractCfaPlanes(src, cfa, CV_32F, bgr, nstripes);
 
   // Set bounds for the iterpolation domain
   int ul_row = 2;
@@ -78,129 +87,79 @@ cv::Mat LarochePrescott(const cv::Mat& src, string pattern, int max_value) {
   int lr_row = src.rows - 2;
   int lr_col = src.cols - 2;
 
-  // Compute vertical (alpha) and horizontal (beta) edge classifiers
-  // (compute for all locations here and use appropriate ones later)
-  cv::Mat alpha = cv::Mat::zeros(src.size(), CV_32F);
-  cv::Mat beta = cv::Mat::zeros(src.size(), CV_32F);
-  for (int r = ul_row; r < lr_row; r++) {
-    for (int c = ul_col; c < lr_col; c++) {
-      alpha.at<float>(r, c) =
-          abs((static_cast<float>(src.at<uint16_t>(r, c - 2)) +
-               static_cast<float>(src.at<uint16_t>(r, c + 2))) /
-                  2 -
-              static_cast<float>(src.at<uint16_t>(r, c)));
-      beta.at<float>(r, c) =
-          abs((static_cast<float>(src.at<uint16_t>(r - 2, c)) +
-               static_cast<float>(src.at<uint16_t>(r - 2, c))) /
-                  2 -
-              static_cast<float>(src.at<uint16_t>(r, c)));
-    }
+  switch (src.type()) {
+    case CV_8UC1:
+      InterpolateGreen<uint8_t>(src, cfa, bgr, ul_row, ul_col, lr_row, lr_col,
+                                nstripes);
+      break;
+    case CV_16UC1:
+      InterpolateGreen<uint16_t>(src, cfa, bgr, ul_row, ul_col, lr_row,
+                                 lr_col, nstripes);
+      break;
+    default:
+      cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+      exit(EXIT_FAILURE);
   }
 
-  // Interpolate green (G) channel according to gradient rules
-  for (int r = ul_row; r < lr_row; r++) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 0) {
-        float equality_tolerance = 8.0;
-        if (abs(alpha.at<float>(r, c) - beta.at<float>(r, c)) <
-            equality_tolerance) {
-          G.at<float>(r, c) =
-              (G.at<float>(r - 1, c) + 
-               G.at<float>(r, c - 1) +
-               G.at<float>(r + 1, c) + 
-               G.at<float>(r, c + 1)) / 4;
-        } else if (alpha.at<float>(r, c) < beta.at<float>(r, c)) {
-          G.at<float>(r, c) =
-              (G.at<float>(r, c - 1) + G.at<float>(r, c + 1)) / 2;
-        } else if (alpha.at<float>(r, c) > beta.at<float>(r, c)) {
-          G.at<float>(r, c) =
-              (G.at<float>(r - 1, c) + G.at<float>(r + 1, c)) / 2;
+  // Interpolate the red (R, channel 2) and blue (B, channel 0) channels
+  // from the color differences with the completed green channel, clamp the
+  // values into the user-specified dynamic range and convert each row into
+  // the destination as it is finished (only R and B sites are read from
+  // neighboring rows, and those are never modified), the source is not
+  // read past this point, so the destination may be the same cv::Mat
+  int rows = src.rows;
+  int cols = src.cols;
+  dst.create(rows, cols, CV_16UC3);
+  float min_dc = 0.0;
+  float max_dc = static_cast<float>(max_value);
+  cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      cv::Vec3f* center = bgr.ptr<cv::Vec3f>(r);
+      if (r < lr_row) {
+        int c_green = cfa.is_green(r, ul_col) ? ul_col : ul_col + 1;
+        for (int ch = 0; ch < 3; ch += 2) {
+          int ch_row = (ch == 2) ? cfa.r_row() : cfa.b_row();
+          if ((r & 1) == ch_row) {
+            // Missing values in rows containing this color (horizontal)
+            for (int c = c_green; c < lr_col; c += 2) {
+              center[c][ch] = ((center[c - 1][ch] - center[c - 1][1]) +
+                               (center[c + 1][ch] - center[c + 1][1])) /
+                                  2 +
+                              center[c][1];
+            }
+          } else if (r > 0) {
+            // Missing values in rows of the other color (vertical at green
+            // sites, diagonal at the other color's sites)
+            const cv::Vec3f* above = bgr.ptr<cv::Vec3f>(r - 1);
+            const cv::Vec3f* below = bgr.ptr<cv::Vec3f>(r + 1);
+            for (int c = ul_col; c < lr_col; c++) {
+              if (cfa.is_green(r, c)) {
+                center[c][ch] = ((above[c][ch] - above[c][1]) +
+                                 (below[c][ch] - below[c][1])) /
+                                    2 +
+                                center[c][1];
+              } else {
+                center[c][ch] =
+                    ((above[c - 1][ch] - above[c - 1][1]) +
+                     (above[c + 1][ch] - above[c + 1][1]) +
+                     (below[c - 1][ch] - below[c - 1][1]) +
+                     (below[c + 1][ch] - below[c + 1][1])) /
+                        4 +
+                    center[c][1];
+              }
+            }
+          }
         }
       }
-    }
-  }
 
-  // Interpolate missing red (R) values in red (R) rows (horizontal)
-  for (int r = r_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 1) {
-        R.at<float>(r, c) =
-            ((R.at<float>(r, c - 1) - G.at<float>(r, c - 1)) +
-             (R.at<float>(r, c + 1) - G.at<float>(r, c + 1))) / 2 +
-            G.at<float>(r, c);
-      }
-    }
-  }
-
-  // Interpolate missing red (R) values in blue (B) rows (vertical)
-  for (int r = b_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 1) {
-        R.at<float>(r, c) =
-            ((R.at<float>(r - 1, c) - G.at<float>(r - 1, c)) +
-             (R.at<float>(r + 1, c) - G.at<float>(r + 1, c))) / 2 +
-            G.at<float>(r, c);
-      } else {
-        R.at<float>(r, c) =
-            ((R.at<float>(r - 1, c - 1) - G.at<float>(r - 1, c - 1)) +
-             (R.at<float>(r - 1, c + 1) - G.at<float>(r - 1, c + 1)) +
-             (R.at<float>(r + 1, c - 1) - G.at<float>(r + 1, c - 1)) +
-             (R.at<float>(r + 1, c + 1) - G.at<float>(r + 1, c + 1))) / 4 +
-            G.at<float>(r, c);
-      }
-    }
-  }
-
-  // Interpolate missing blue (B) values in blue (B) rows (horizontal)
-  for (int r = b_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 1) {
-        B.at<float>(r, c) =
-            ((B.at<float>(r, c - 1) - G.at<float>(r, c - 1)) +
-             (B.at<float>(r, c + 1) - G.at<float>(r, c + 1))) / 2 +
-            G.at<float>(r, c);
-      }
-    }
-  }
-
-  // Interpolate missing blue (B) values in red (R) rows (vertical)
-  for (int r = r_row; r < lr_row; r += 2) {
-    for (int c = ul_col; c < lr_col; c++) {
-      if (g_mask.at<uint16_t>(r, c) == 1) {
-        B.at<float>(r, c) =
-            ((B.at<float>(r - 1, c) - G.at<float>(r - 1, c)) +
-             (B.at<float>(r + 1, c) - G.at<float>(r + 1, c))) / 2 +
-            G.at<float>(r, c);
-      } else {
-        B.at<float>(r, c) =
-            ((B.at<float>(r - 1, c - 1) - G.at<float>(r - 1, c - 1)) +
-             (B.at<float>(r - 1, c + 1) - G.at<float>(r - 1, c + 1)) +
-             (B.at<float>(r + 1, c - 1) - G.at<float>(r + 1, c - 1)) +
-             (B.at<float>(r + 1, c + 1) - G.at<float>(r + 1, c + 1))) / 4 +
-            G.at<float>(r, c);
+      cv::Vec3w* out = dst.ptr<cv::Vec3w>(r);
+      for (int c = 0; c < cols; c++) {
+        for (int ch = 0; ch < 3; ch++) {
+          out[c][ch] =
+              cv::saturate_cast<uint16_t>(clamp(center[c][ch], min_dc, max_dc));
+        }
       }
     }
-  }
-
-  // Clamp values into the user-specified dynamic range
-  float min_dc = 0.0;
-  float max_dc = static_cast<float>(max_value);
-  for (int r = 0; r < src.rows; r++) {
-    for (int c = 0; c < src.cols; c++) {
-      B.at<float>(r, c) = clamp(B.at<float>(r, c), min_dc, max_dc);
-      G.at<float>(r, c) = clamp(G.at<float>(r, c), min_dc, max_dc);
-      R.at<float>(r, c) = clamp(R.at<float>(r, c), min_dc, max_dc);
-    }
-  }
-
-  // Merge the interpolated B, G, and R channels into a 3-channel cv::Mat
-  cv::Mat channels[3];
-  B.convertTo(channels[0], CV_16U);
-  G.convertTo(channels[1], CV_16U);
-  R.convertTo(channels[2], CV_16U);
-  cv::Mat dst;
-  cv::merge(channels, 3, dst);
-
-  return dst;
+  }, nstripes);
 }
 }
@@ -29,7 +29,7 @@ namespace ipcv {
 
 /** Interpolate CFA using Laroche and Prescott interpolation
  *
- *  \param[in] src         source cv::Mat of CV_16UC1 containing CFA
+ *  \param[in] src         source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
  *  \param[in] pattern     a string defining the CFA layout:
  *                           'GBRG'  -  G B  Raspberry Pi (OmniVision OV5647)
  *                                      R G
@@ -46,4 +46,18 @@ namespace ipcv {
  */
 cv::Mat LarochePrescott(const cv::Mat& src, string pattern = "GBRG",
                         int max_value = 65535);
+
+/** Interpolate CFA using Laroche and Prescott interpolation into a provided
+ *  image
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+ *  \param[out] dst        destination cv::Mat of CV_16UC3 (reallocated only
+ *                         if its size or type differ)
+ *  \param[in] pattern     a string defining the CFA layout (see above)
+ *  \param[in] max_value   the maximum value the image may take on
+ *  \param[in] nstripes    parallel stripes as for cv::parallel_for_, 1 runs
+ *                         in the calling thread [default is automatic]
+ */
+void LarochePrescott(const cv::Mat& src, cv::Mat& dst, string pattern,
+                     int max_value, double nstripes = -1);
 }
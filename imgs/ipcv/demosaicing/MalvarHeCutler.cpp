@@ -0,0 +1,179 @@
+/** Implementation file for CFA demosaic function using Malvar, He, and
+ *  Cutler gradient-corrected linear interpolation
+ *
+ *  \file ipcv/demosaicing/MalvarHeCutler.cpp
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "Cfa.h"
+#include "MalvarHeCutler.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+// Columns of reflected padding on either side of a buffered row (the
+// kernels are 5x5)
+const int kPad = 2;
+
+// Rows of the output processed per parallel band
+const int kBandRows = 64;
+
+/* The 5 source rows around the current row as padded integer rows
+ *
+ * Slots are indexed by source row, so at the image boundary the reflected
+ * rows are simply rows already held.
+ */
+template <typename T>
+class RowWindow {
+ public:
+  RowWindow(const cv::Mat& src)
+      : src_(src),
+        stride_(src.cols + 2 * kPad),
+        held_(5, -1),
+        data_(5 * stride_) {}
+
+  /* Padded row for the provided row (reflected into the image)
+   */
+  const int32_t* Row(int y) {
+    y = cv::borderInterpolate(y, src_.rows, cv::BORDER_REFLECT_101);
+    int slot = y % 5;
+    int32_t* row = data_.data() + slot * stride_ + kPad;
+    if (held_[slot] != y) {
+      const T* in = src_.ptr<T>(y);
+      for (int c = 0; c < src_.cols; c++) {
+        row[c] = in[c];
+      }
+      for (int k = 1; k <= kPad; k++) {
+        row[-k] = row[k];
+        row[src_.cols - 1 + k] = row[src_.cols - 1 - k];
+      }
+      held_[slot] = y;
+    }
+    return row;
+  }
+
+ private:
+  const cv::Mat& src_;
+  int stride_;
+  vector<int> held_;
+  vector<int32_t> data_;
+};
+
+template <typename T>
+void Interpolate(const cv::Mat& src, const Cfa& cfa, int max_value,
+                 cv::Mat& dst, double nstripes) {
+  int bands = (src.rows + kBandRows - 1) / kBandRows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    RowWindow<T> window(src);
+    int cols = src.cols;
+
+    // Kernel responses (x16) for every column of the current row, computed
+    // in contiguous passes and then scattered by CFA phase
+    vector<int32_t> cross(cols);
+    vector<int32_t> horizontal(cols);
+    vector<int32_t> vertical(cols);
+    vector<int32_t> diagonal(cols);
+
+    int y1 = min(range.end * kBandRows, src.rows);
+    for (int y = range.start * kBandRows; y < y1; y++) {
+      const int32_t* u2 = window.Row(y - 2);
+      const int32_t* u1 = window.Row(y - 1);
+      const int32_t* m0 = window.Row(y);
+      const int32_t* d1 = window.Row(y + 1);
+      const int32_t* d2 = window.Row(y + 2);
+
+      for (int c = 0; c < cols; c++) {
+        int32_t center = m0[c];
+        int32_t axial1 = u1[c] + d1[c] + m0[c - 1] + m0[c + 1];
+        int32_t axial2 = u2[c] + d2[c] + m0[c - 2] + m0[c + 2];
+        int32_t diag = u1[c - 1] + u1[c + 1] + d1[c - 1] + d1[c + 1];
+
+        // Green at red/blue sites
+        cross[c] = 8 * center + 4 * axial1 - 2 * axial2;
+
+        // Red/blue at green sites, sampled to the left and right
+        horizontal[c] = 10 * center + 8 * (m0[c - 1] + m0[c + 1]) -
+                        2 * (m0[c - 2] + m0[c + 2]) - 2 * diag +
+                        (u2[c] + d2[c]);
+
+        // Red/blue at green sites, sampled above and below
+        vertical[c] = 10 * center + 8 * (u1[c] + d1[c]) -
+                      2 * (u2[c] + d2[c]) - 2 * diag +
+                      (m0[c - 2] + m0[c + 2]);
+
+        // Red at blue sites and blue at red sites
+        diagonal[c] = 12 * center + 4 * diag - 3 * axial2;
+      }
+
+      T* out = dst.ptr<T>(y);
+      auto encode = [max_value](int32_t sum) {
+        return static_cast<T>(std::clamp((sum + 8) >> 4, 0, max_value));
+      };
+      for (int phase = 0; phase < 2; phase++) {
+        int site = cfa.color(y, phase);
+        if (site == Cfa::green) {
+          // The colors sampled to the left/right and above/below
+          int h = cfa.color(y, phase + 1);
+          int v = cfa.color(y + 1, phase);
+          for (int c = phase; c < cols; c += 2) {
+            out[3 * c + Cfa::green] = static_cast<T>(m0[c]);
+            out[3 * c + h] = encode(horizontal[c]);
+            out[3 * c + v] = encode(vertical[c]);
+          }
+        } else {
+          int other = 2 - site;
+          for (int c = phase; c < cols; c += 2) {
+            out[3 * c + site] = static_cast<T>(m0[c]);
+            out[3 * c + Cfa::green] = encode(cross[c]);
+            out[3 * c + other] = encode(diagonal[c]);
+          }
+        }
+      }
+    }
+  }, nstripes);
+}
+
+}  // namespace
+
+cv::Mat MalvarHeCutler(const cv::Mat& src, string pattern, int max_value) {
+  cv::Mat dst;
+  MalvarHeCutler(src, dst, pattern, max_value);
+  return dst;
+}
+
+void MalvarHeCutler(const cv::Mat& src, cv::Mat& dst, string pattern,
+                    int max_value, double nstripes) {
+  Cfa cfa(pattern);
+
+  if ((src.type() != CV_8UC1) && (src.type() != CV_16UC1)) {
+    cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((src.rows < 3) || (src.cols < 3)) {
+    cerr << "Source CFA image must be at least 3 x 3" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  int type_max = (src.depth() == CV_8U) ? 255 : 65535;
+  if (max_value < 0) {
+    max_value = type_max;
+  }
+  max_value = min(max_value, type_max);
+
+  // The source header is held so that it stays valid should the
+  // destination be the same cv::Mat
+  cv::Mat in = src;
+  dst.create(in.size(), CV_MAKETYPE(in.depth(), 3));
+  if (in.depth() == CV_8U) {
+    Interpolate<uint8_t>(in, cfa, max_value, dst, nstripes);
+  } else {
+    Interpolate<uint16_t>(in, cfa, max_value, dst, nstripes);
+  }
+}
+}  // namespace ipcv
@@ -0,0 +1,66 @@
+/** Interface file for CFA demosaic function using Malvar, He, and Cutler
+ *  gradient-corrected linear interpolation
+ *
+ *  \file ipcv/demosaicing/MalvarHeCutler.h
+ *
+ *  \description
+ *    This function will perform color filter array interpolation on a
+ *    generic document mode (Bayer) image.  Each missing color is a bilinear
+ *    estimate corrected by the Laplacian of the sampled color, which reduces
+ *    to one of four fixed 5x5 linear kernels selected by the CFA phase.  The
+ *    kernels are applied with integer arithmetic.  The technique is an
+ *    implementation of the following paper:
+ *
+ *      H.S. Malvar, L. He, and R. Cutler, "High-quality linear
+ *      interpolation for demosaicing of Bayer-patterned color images",
+ *      IEEE International Conference on Acoustics, Speech, and Signal
+ *      Processing (ICASSP), vol. 3, pp. 485-488 (2004)
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Interpolate CFA using Malvar, He, and Cutler interpolation
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC1 or CV_16UC1 containing
+ *                         CFA (8-, 10-, 12-, 14-, or 16-bit data)
+ *  \param[in] pattern     a string defining the CFA layout:
+ *                           'GBRG'  -  G B  Raspberry Pi (OmniVision OV5647)
+ *                                      R G
+ *                           'GRBG'  -  G R
+ *                                      B G
+ *                           'BGGR'  -  B G
+ *                                      G R
+ *                           'RGGB'  -  R G
+ *                                      G B
+ *  \param[in] max_value   the maximum value the image may take on [default
+ *                         (-1) is the maximum of the source data type]
+ *
+ *  \return                destination cv::Mat of CV_8UC3 or CV_16UC3 (the
+ *                         depth of the source) for interpolated image
+ */
+cv::Mat MalvarHeCutler(const cv::Mat& src, std::string pattern = "GBRG",
+                       int max_value = -1);
+
+/** Interpolate CFA using Malvar, He, and Cutler interpolation into a
+ *  provided image
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC1 or CV_16UC1 containing
+ *                         CFA
+ *  \param[out] dst        destination cv::Mat of the source depth with 3
+ *                         channels (reallocated only if its size or type
+ *                         differ)
+ *  \param[in] pattern     a string defining the CFA layout (see above)
+ *  \param[in] max_value   the maximum value the image may take on (-1 is
+ *                         the maximum of the source data type)
+ *  \param[in] nstripes    parallel stripes as for cv::parallel_for_, 1 runs
+ *                         in the calling thread [default is automatic]
+ */
+void MalvarHeCutler(const cv::Mat& src, cv::Mat& dst, std::string pattern,
+                    int max_value, double nstripes = -1);
+}
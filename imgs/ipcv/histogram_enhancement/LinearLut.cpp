@@ -12,6 +12,7 @@
 #include <iostream>
 
 #include "imgs/ipcv/utils/Utils.h"
+#include "imgs/numerical/sorting/Selection.h"
 
 using namespace std;
 
@@ -29,45 +30,46 @@ bool LinearLut(const cv::Mat& src, const int percentage, cv::Mat& lut) {
   // Histogram calculations based on the given src image
   cv::Mat_<int> src_hist;
   ipcv::Histogram(src, src_hist);
-  cv::Mat_<double> src_cdf;
-  ipcv::HistogramToCdf(src_hist, src_cdf);
 
   // Initializing the LUT
   lut = cv::Mat_<uint8_t>::zeros(3, 256);
 
-  for (int channel_idx = 0; channel_idx < src_cdf.rows; channel_idx++) {
-    // Finding the lowest brightness value in the image, accounting for the
-    int low;
-    for (int brightness = 0; brightness < src_cdf.cols; brightness++) {
-      if (src_cdf.at<double>(channel_idx, brightness) >= percentage / 200.0) {
-        low = brightness;
-        break;
-      }
-    }
+  // Half of the percentage comes off each tail
+  double tail = percentage / 200.0;
+
+  for (int channel_idx = 0; channel_idx < src_hist.rows; channel_idx++) {
+    // The cut points are percentiles read straight off the histogram, the
+    // lowest brightness with at least the tail below it and the lowest with
+    // at least all but the tail at or below it
+    const int* hist = src_hist.ptr<int>(channel_idx);
+    int low = static_cast<int>(
+        numerical::HistogramPercentile(hist, src_hist.cols, tail));
+    int high = static_cast<int>(
+        numerical::HistogramPercentile(hist, src_hist.cols, 1 - tail));
 
-    // Finding the highest brightness value in the image
-    int high;
-    for (int brightness = src_cdf.cols; brightness >= 0; brightness--) {
-      if (src_cdf.at<double>(channel_idx, brightness) <=
-          1 - percentage / 200.0) {
-        high = brightness;
-        break;
+    // A single brightness has nothing to stretch, it is left unchanged
+    // rather than mapped to black
+    if (high <= low) {
+      for (int brightness = 0; brightness < lut.cols; brightness++) {
+        lut.at<uint8_t>(channel_idx, brightness) = brightness;
       }
+      continue;
     }
 
     // Gonna be honest I barely remember how the slope fits into things but this
-    // is where we calculate it
-    auto slope = 255 / (high - low);
+    // is where we calculate it (in floating point, an integer slope of 255 /
+    // (high - low) truncates most stretches back to 1)
+    double slope = 255.0 / (high - low);
 
     // Deriving the y intercept based on the slope
-    auto intercept = -(slope * low);
+    double intercept = -(slope * low);
 
     // Calculating the LUT's current value and clamping it to avoid clipping
     // before writing to the LUT matrix
     for (int brightness = 0; brightness < lut.cols; brightness++) {
-      auto current_val = slope * brightness + intercept;
-      current_val = clamp(current_val, 0, 255);
-      lut.at<uint8_t>(channel_idx, brightness) = current_val;
+      double current_val = slope * brightness + intercept;
+      lut.at<uint8_t>(channel_idx, brightness) =
+          cv::saturate_cast<uint8_t>(current_val);
     }
   }
   return true;
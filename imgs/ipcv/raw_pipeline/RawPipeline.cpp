@@ -0,0 +1,271 @@
+/** Implementation file for the fused raw-to-display processing pipeline
+ *
+ *  \file ipcv/raw_pipeline/RawPipeline.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "RawPipeline.h"
+
+#include "imgs/ipcv/demosaicing/Demosaic.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+// Rows above and below a band that are demosaiced along with it so that the
+// band's own rows see their full neighborhood (the GBTF pipeline reaches
+// about a dozen rows)
+const int kHalo = 16;
+
+// Working set targeted per band (the band's CFA rows and its demosaiced
+// rows) when sizing bands automatically
+const size_t kBandBytes = 1 << 20;
+
+// Entries in the gamma table indexed by the normalized linear value
+const int kLutSize = 1 << 16;
+
+template <typename T>
+void SubtractBlack(const cv::Mat& src, int row0, cv::Mat& band, int black,
+                   double scale) {
+  for (int r = 0; r < band.rows; r++) {
+    const T* in = src.ptr<T>(row0 + r);
+    uint16_t* out = band.ptr<uint16_t>(r);
+    if (scale == 1.0) {
+      for (int c = 0; c < band.cols; c++) {
+        out[c] = static_cast<uint16_t>(max(static_cast<int>(in[c]) - black, 0));
+      }
+    } else {
+      for (int c = 0; c < band.cols; c++) {
+        out[c] = cv::saturate_cast<uint16_t>(
+            max(static_cast<int>(in[c]) - black, 0) * scale);
+      }
+    }
+  }
+}
+
+template <typename Tin, typename Tout>
+void Encode(const cv::Mat& rgb, int row0, int rows, const cv::Matx33f& m,
+            float scale, const vector<Tout>& lut, cv::Mat& dst,
+            int dst_row0) {
+  const float lut_max = static_cast<float>(kLutSize - 1);
+  for (int r = 0; r < rows; r++) {
+    const Tin* in = rgb.ptr<Tin>(row0 + r);
+    Tout* out = dst.ptr<Tout>(dst_row0 + r);
+    for (int c = 0; c < rgb.cols; c++, in += 3, out += 3) {
+      float x[3] = {scale * in[0], scale * in[1], scale * in[2]};
+      for (int ch = 0; ch < 3; ch++) {
+        // The combined matrix maps camera BGR to balanced, corrected BGR
+        float v = m(ch, 0) * x[0] + m(ch, 1) * x[1] + m(ch, 2) * x[2];
+        v = std::clamp(v, 0.0f, 1.0f);
+        out[ch] = lut[static_cast<int>(v * lut_max + 0.5f)];
+      }
+    }
+  }
+}
+
+template <typename Tout>
+void EncodeRows(const cv::Mat& rgb, int row0, int rows, const cv::Matx33f& m,
+            float scale, const vector<Tout>& lut, cv::Mat& dst,
+            int dst_row0) {
+  if (rgb.depth() == CV_8U) {
+    Encode<uint8_t, Tout>(rgb, row0, rows, m, scale, lut, dst, dst_row0);
+  } else {
+    Encode<uint16_t, Tout>(rgb, row0, rows, m, scale, lut, dst, dst_row0);
+  }
+}
+
+}  // namespace
+
+RawPipeline::RawPipeline(const string& pattern, Demosaicer demosaicer)
+    : demosaicer_(demosaicer) {
+  set_pattern(pattern);
+}
+
+void RawPipeline::set_pattern(const string& pattern) {
+  // Validates the pattern
+  Cfa cfa(pattern);
+  pattern_ = cfa.pattern();
+}
+
+cv::Vec3d RawPipeline::GrayworldGains(const cv::Mat& src) const {
+  if ((src.type() != CV_8UC1) && (src.type() != CV_16UC1)) {
+    cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  Cfa cfa(pattern_);
+
+  // Per-band site sums (in BGR order) reduced after the parallel pass
+  const int band = 64;
+  int bands = (src.rows + band - 1) / band;
+  vector<cv::Vec3d> sums(bands);
+  vector<cv::Vec3d> counts(bands);
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    for (int idx = range.start; idx < range.end; idx++) {
+      cv::Vec3d sum(0, 0, 0);
+      cv::Vec3d count(0, 0, 0);
+      for (int r = idx * band; r < min((idx + 1) * band, src.rows); r++) {
+        for (int c0 = 0; c0 < 2; c0++) {
+          int color = cfa.color(r, c0);
+          double row_sum = 0;
+          int n = 0;
+          for (int c = c0; c < src.cols; c += 2, n++) {
+            int value = (src.depth() == CV_8U)
+                            ? src.ptr<uint8_t>(r)[c]
+                            : src.ptr<uint16_t>(r)[c];
+            row_sum += max(value - black_level_, 0);
+          }
+          sum[color] += row_sum;
+          count[color] += n;
+        }
+      }
+      sums[idx] = sum;
+      counts[idx] = count;
+    }
+  });
+
+  cv::Vec3d mean(0, 0, 0);
+  cv::Vec3d count(0, 0, 0);
+  for (int idx = 0; idx < bands; idx++) {
+    mean += sums[idx];
+    count += counts[idx];
+  }
+  for (int ch = 0; ch < 3; ch++) {
+    mean[ch] = (count[ch] > 0) ? mean[ch] / count[ch] : 0;
+  }
+
+  cv::Vec3d gains(1, 1, 1);
+  if (mean[0] > 0) {
+    gains[0] = mean[1] / mean[0];
+  }
+  if (mean[2] > 0) {
+    gains[2] = mean[1] / mean[2];
+  }
+  return gains;
+}
+
+cv::Mat RawPipeline::Process(const cv::Mat& src) const {
+  if ((src.type() != CV_8UC1) && (src.type() != CV_16UC1)) {
+    cerr << "Source CFA image must be of type CV_8UC1 or CV_16UC1" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((max_value_ < 1) || (max_value_ > 65535)) {
+    cerr << "Maximum value must be in the range [1, 65535]" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  int white_level = white_level_;
+  if (white_level < 0) {
+    white_level = (src.depth() == CV_8U) ? 255 : 65535;
+  }
+  int dynamic_range = white_level - black_level_;
+  if (dynamic_range <= 0) {
+    cerr << "White level must exceed the black level" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // GBTF produces 8-bit output, so its input is scaled to [0, 255] and the
+  // other demosaicers work in the black level subtracted source units
+  double band_scale = 1.0;
+  float normalize = 1.0f / dynamic_range;
+  if (demosaicer_ == Demosaicer::gbtf) {
+    band_scale = 255.0 / dynamic_range;
+    normalize = 1.0f / 255;
+  }
+
+  // White balance gains and the color matrix fold into a single matrix on
+  // BGR vectors, with the normalization to [0, 1] applied before it
+  cv::Vec3d gains = gains_;
+  if ((gains[0] <= 0) || (gains[1] <= 0) || (gains[2] <= 0)) {
+    gains = GrayworldGains(src);
+  }
+  const cv::Matx33d& m = color_matrix_;
+  cv::Matx33f bgr;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      // Matrix rows/columns are in RGB order, BGR index k is RGB index 2-k
+      bgr(i, j) = static_cast<float>(m(2 - i, 2 - j) * gains[j]);
+    }
+  }
+
+  // Gamma table from the normalized linear value to the destination
+  int depth = (max_value_ <= 255) ? CV_8U : CV_16U;
+  vector<uint8_t> lut8;
+  vector<uint16_t> lut16;
+  for (int idx = 0; idx < kLutSize; idx++) {
+    double value = pow(idx / static_cast<double>(kLutSize - 1), 1 / gamma_) *
+                       max_value_ +
+                   0.5;
+    if (depth == CV_8U) {
+      lut8.push_back(static_cast<uint8_t>(value));
+    } else {
+      lut16.push_back(static_cast<uint16_t>(value));
+    }
+  }
+
+  int band_rows = band_rows_;
+  if (band_rows <= 0) {
+    size_t row_bytes = static_cast<size_t>(src.cols) * (2 + 3 * 2);
+    band_rows = static_cast<int>(kBandBytes / max<size_t>(row_bytes, 1));
+    band_rows = std::clamp(band_rows, 2 * kHalo, 256);
+  }
+
+  cv::Mat dst(src.size(), CV_MAKETYPE(depth, 3));
+  Cfa cfa(pattern_);
+  int bands = (src.rows + band_rows - 1) / band_rows;
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    // The band and demosaiced buffers are reused across the bands handled
+    // by this body
+    cv::Mat band;
+    cv::Mat rgb;
+    for (int idx = range.start; idx < range.end; idx++) {
+      int y0 = idx * band_rows;
+      int y1 = min(y0 + band_rows, src.rows);
+      int a = max(y0 - kHalo, 0);
+      int b = min(y1 + kHalo, src.rows);
+
+      band.create(b - a, src.cols, CV_16UC1);
+      if (src.depth() == CV_8U) {
+        SubtractBlack<uint8_t>(src, a, band, black_level_, band_scale);
+      } else {
+        SubtractBlack<uint16_t>(src, a, band, black_level_, band_scale);
+      }
+
+      // The band begins at row a, so its CFA phase is shifted accordingly,
+      // and it is demosaiced in this thread (a single stripe), the bands
+      // already being spread over the threads
+      string pattern = cfa.Shifted(a, 0).pattern();
+      switch (demosaicer_) {
+        case Demosaicer::bilinear:
+          Bilinear(band, rgb, pattern, 1);
+          break;
+        case Demosaicer::laroche_prescott:
+          LarochePrescott(band, rgb, pattern, dynamic_range, 1);
+          break;
+        case Demosaicer::malvar_he_cutler:
+          MalvarHeCutler(band, rgb, pattern, dynamic_range, 1);
+          break;
+        case Demosaicer::gbtf:
+          GBTF(band, rgb, pattern, 1);
+          break;
+      }
+
+      if (depth == CV_8U) {
+        EncodeRows<uint8_t>(rgb, y0 - a, y1 - y0, bgr, normalize, lut8, dst,
+                            y0);
+      } else {
+        EncodeRows<uint16_t>(rgb, y0 - a, y1 - y0, bgr, normalize, lut16, dst,
+                             y0);
+      }
+    }
+  });
+
+  return dst;
+}
+}  // namespace ipcv
@@ -0,0 +1,115 @@
+/** Interface file for the fused raw-to-display processing pipeline
+ *
+ *  \file ipcv/raw_pipeline/RawPipeline.h
+ *
+ *  \description
+ *    Renders a CFA frame with the stages
+ *
+ *      black level subtraction -> demosaic -> white balance gains ->
+ *      color matrix -> gamma correction
+ *
+ *    fused over horizontal bands of rows processed in parallel.  Each band
+ *    (plus a halo of rows for the demosaicer's neighborhood) is demosaiced
+ *    serially, by the thread that owns the band, into a band-sized buffer
+ *    that is reused, so the only full-frame images are the source and the
+ *    destination.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+class RawPipeline {
+ public:
+  /* Demosaic algorithm
+   */
+  enum class Demosaicer { bilinear, laroche_prescott, malvar_he_cutler, gbtf };
+
+  /* Constructor
+   *
+   * \param[in] pattern      CFA layout of the source ('GBRG', 'GRBG', 'BGGR',
+   *                         or 'RGGB')
+   * \param[in] demosaicer   demosaic algorithm
+   */
+  explicit RawPipeline(const std::string& pattern = "GBRG",
+                       Demosaicer demosaicer = Demosaicer::bilinear);
+
+  /* Getters and setters
+   */
+
+  /* CFA layout of the source */
+  std::string pattern() const { return pattern_; }
+  void set_pattern(const std::string& pattern);
+
+  /* Demosaic algorithm */
+  Demosaicer demosaicer() const { return demosaicer_; }
+  void set_demosaicer(Demosaicer demosaicer) { demosaicer_ = demosaicer; }
+
+  /* Source black level, subtracted from every sample [default is 0] */
+  int black_level() const { return black_level_; }
+  void set_black_level(int black_level) { black_level_ = black_level; }
+
+  /* Source white level [default (-1) is the largest value of the source
+   * data type] */
+  int white_level() const { return white_level_; }
+  void set_white_level(int white_level) { white_level_ = white_level; }
+
+  /* White balance gains in BGR order, a zero gain requests the gray world
+   * gains computed from the source [default is (0, 0, 0)] */
+  cv::Vec3d gains() const { return gains_; }
+  void set_gains(const cv::Vec3d& gains) { gains_ = gains; }
+
+  /* Color matrix, applied to white balanced (R, G, B) column vectors
+   * [default is the identity] */
+  cv::Matx33d color_matrix() const { return color_matrix_; }
+  void set_color_matrix(const cv::Matx33d& m) { color_matrix_ = m; }
+
+  /* Display gamma [default is 2.2] */
+  double gamma() const { return gamma_; }
+  void set_gamma(double gamma) { gamma_ = gamma; }
+
+  /* Maximum destination value, 255 produces CV_8UC3 and larger values
+   * produce CV_16UC3 [default is 255] */
+  int max_value() const { return max_value_; }
+  void set_max_value(int max_value) { max_value_ = max_value; }
+
+  /* Rows per band [default (0) sizes bands to stay in cache] */
+  int band_rows() const { return band_rows_; }
+  void set_band_rows(int band_rows) { band_rows_ = band_rows; }
+
+  /** Gray world white balance gains of a CFA frame
+   *
+   *  The means of the black level subtracted red, green, and blue filter
+   *  sites are equalized to the green mean.
+   *
+   *  \param[in] src   source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+   *
+   *  \return          gains in BGR order
+   */
+  cv::Vec3d GrayworldGains(const cv::Mat& src) const;
+
+  /** Render a CFA frame
+   *
+   *  \param[in] src   source cv::Mat of CV_8UC1 or CV_16UC1 containing CFA
+   *
+   *  \return          destination cv::Mat of CV_8UC3 or CV_16UC3 (see
+   *                   max_value)
+   */
+  cv::Mat Process(const cv::Mat& src) const;
+
+ private:
+  std::string pattern_;
+  Demosaicer demosaicer_;
+  int black_level_ = 0;
+  int white_level_ = -1;
+  cv::Vec3d gains_ = cv::Vec3d(0, 0, 0);
+  cv::Matx33d color_matrix_ = cv::Matx33d::eye();
+  double gamma_ = 2.2;
+  int max_value_ = 255;
+  int band_rows_ = 0;
+};
+}
@@ -0,0 +1,296 @@
+/** Implementation file for packed raw sensor file reader
+ *
+ *  \file ipcv/raw_reader/RawReader.cpp
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <opencv2/imgcodecs.hpp>
+
+#include "RawReader.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+/* Pixels and bytes per packed group
+ */
+void GroupSize(RawFormat format, int& pixels, int& bytes) {
+  switch (format) {
+    case RawFormat::raw10:
+      pixels = 4;
+      bytes = 5;
+      break;
+    case RawFormat::raw12:
+      pixels = 2;
+      bytes = 3;
+      break;
+    case RawFormat::raw14:
+      pixels = 4;
+      bytes = 7;
+      break;
+    case RawFormat::raw16:
+      pixels = 1;
+      bytes = 2;
+      break;
+  }
+}
+
+/* Unpack whole groups of a row, each group is expanded with fixed shifts and
+ * masks and no data-dependent branches so the loops vectorize
+ */
+void UnpackRaw10(const uint8_t* in, uint16_t* out, int groups) {
+  for (int g = 0; g < groups; g++, in += 5, out += 4) {
+    uint8_t lsb = in[4];
+    out[0] = static_cast<uint16_t>((in[0] << 2) | (lsb & 0x3));
+    out[1] = static_cast<uint16_t>((in[1] << 2) | ((lsb >> 2) & 0x3));
+    out[2] = static_cast<uint16_t>((in[2] << 2) | ((lsb >> 4) & 0x3));
+    out[3] = static_cast<uint16_t>((in[3] << 2) | (lsb >> 6));
+  }
+}
+
+void UnpackRaw12(const uint8_t* in, uint16_t* out, int groups) {
+  for (int g = 0; g < groups; g++, in += 3, out += 2) {
+    uint8_t lsb = in[2];
+    out[0] = static_cast<uint16_t>((in[0] << 4) | (lsb & 0xF));
+    out[1] = static_cast<uint16_t>((in[1] << 4) | (lsb >> 4));
+  }
+}
+
+void UnpackRaw14(const uint8_t* in, uint16_t* out, int groups) {
+  for (int g = 0; g < groups; g++, in += 7, out += 4) {
+    uint8_t l0 = in[4];
+    uint8_t l1 = in[5];
+    uint8_t l2 = in[6];
+    out[0] = static_cast<uint16_t>((in[0] << 6) | (l0 & 0x3F));
+    out[1] = static_cast<uint16_t>((in[1] << 6) | (l0 >> 6) |
+                                   ((l1 & 0xF) << 2));
+    out[2] = static_cast<uint16_t>((in[2] << 6) | (l1 >> 4) |
+                                   ((l2 & 0x3) << 4));
+    out[3] = static_cast<uint16_t>((in[3] << 6) | (l2 >> 2));
+  }
+}
+
+void UnpackRaw16(const uint8_t* in, uint16_t* out, int groups) {
+  for (int g = 0; g < groups; g++, in += 2, out++) {
+    *out = static_cast<uint16_t>(in[0] | (in[1] << 8));
+  }
+}
+
+void UnpackGroups(RawFormat format, const uint8_t* in, uint16_t* out,
+                  int groups) {
+  switch (format) {
+    case RawFormat::raw10:
+      UnpackRaw10(in, out, groups);
+      break;
+    case RawFormat::raw12:
+      UnpackRaw12(in, out, groups);
+      break;
+    case RawFormat::raw14:
+      UnpackRaw14(in, out, groups);
+      break;
+    case RawFormat::raw16:
+      UnpackRaw16(in, out, groups);
+      break;
+  }
+}
+
+}  // namespace
+
+RawFormat ParseRawFormat(const string& name) {
+  string lower(name);
+  transform(lower.begin(), lower.end(), lower.begin(),
+            [](unsigned char c) { return tolower(c); });
+  if (lower == "raw10") {
+    return RawFormat::raw10;
+  } else if (lower == "raw12") {
+    return RawFormat::raw12;
+  } else if (lower == "raw14") {
+    return RawFormat::raw14;
+  } else if (lower == "raw16") {
+    return RawFormat::raw16;
+  }
+  cerr << "Invalid raw format provided: " << name << endl;
+  exit(EXIT_FAILURE);
+}
+
+RawReader::RawReader(const string& filename, RawFormat format, int width,
+                     int height, size_t stride, size_t offset) {
+  Open(filename, format, width, height, stride, offset);
+}
+
+void RawReader::Open(const string& filename, RawFormat format, int width,
+                     int height, size_t stride, size_t offset) {
+  if ((width <= 0) || (height <= 0)) {
+    cerr << "Raw frame dimensions must be positive" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  int group_pixels;
+  int group_bytes;
+  GroupSize(format, group_pixels, group_bytes);
+  size_t row_bytes =
+      static_cast<size_t>((width + group_pixels - 1) / group_pixels) *
+      group_bytes;
+  if (stride == 0) {
+    stride = row_bytes;
+  } else if (stride < row_bytes) {
+    cerr << "Raw row stride must be at least " << row_bytes << " bytes"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (file_.is_open()) {
+    file_.close();
+  }
+  file_.open(filename);
+  if (!file_.is_open()) {
+    cerr << "Unable to map raw file: " << filename << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (file_.size() < offset + stride * (height - 1) + row_bytes) {
+    cerr << "Raw file " << filename << " is too small for a " << width
+         << " x " << height << " frame" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  format_ = format;
+  width_ = width;
+  height_ = height;
+  stride_ = stride;
+  offset_ = offset;
+}
+
+int RawReader::bits() const {
+  switch (format_) {
+    case RawFormat::raw10:
+      return 10;
+    case RawFormat::raw12:
+      return 12;
+    case RawFormat::raw14:
+      return 14;
+    case RawFormat::raw16:
+      return 16;
+  }
+  return 16;
+}
+
+const uint8_t* RawReader::Row(int row) const {
+  return reinterpret_cast<const uint8_t*>(file_.data()) + offset_ +
+         stride_ * row;
+}
+
+cv::Mat RawReader::View() const {
+  if (format_ != RawFormat::raw16) {
+    cerr << "Only raw16 data may be viewed without unpacking" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((offset_ % sizeof(uint16_t) != 0) || (stride_ % sizeof(uint16_t) != 0)) {
+    cerr << "Raw16 offset and stride must be even to be viewed" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return cv::Mat(height_, width_, CV_16UC1,
+                 const_cast<uint8_t*>(Row(0)), stride_);
+}
+
+cv::Mat RawReader::Read(int black_level, int white_level,
+                        int max_value) const {
+  int max_sample = (1 << bits()) - 1;
+  if (white_level < 0) {
+    white_level = max_sample;
+  }
+
+  // Nothing to unpack or normalize, hand back the mapped data
+  if ((format_ == RawFormat::raw16) && (black_level == 0) &&
+      (white_level == max_value) && (offset_ % sizeof(uint16_t) == 0) &&
+      (stride_ % sizeof(uint16_t) == 0)) {
+    return View();
+  }
+
+  cv::Mat dst;
+  Read(dst, black_level, white_level, max_value);
+  return dst;
+}
+
+void RawReader::Read(cv::Mat& dst, int black_level, int white_level,
+                     int max_value) const {
+  if (!file_.is_open()) {
+    cerr << "No raw file has been opened" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  int max_sample = (1 << bits()) - 1;
+  if (white_level < 0) {
+    white_level = max_sample;
+  }
+  if ((black_level < 0) || (white_level <= black_level) || (max_value < 1) ||
+      (max_value > 65535)) {
+    cerr << "Invalid raw normalization: black level " << black_level
+         << ", white level " << white_level << ", maximum value "
+         << max_value << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Normalization table over every value the packing can hold, so it costs
+  // a single lookup per pixel in the unpacking pass
+  bool identity = (black_level == 0) && (white_level == max_value);
+  vector<uint16_t> lut;
+  if (!identity) {
+    lut.resize(max_sample + 1);
+    double scale = static_cast<double>(max_value) / (white_level - black_level);
+    for (int v = 0; v <= max_sample; v++) {
+      double value = (v - black_level) * scale;
+      lut[v] = static_cast<uint16_t>(
+          std::round(std::clamp(value, 0.0, static_cast<double>(max_value))));
+    }
+  }
+
+  dst.create(height_, width_, CV_16UC1);
+
+  int group_pixels;
+  int group_bytes;
+  GroupSize(format_, group_pixels, group_bytes);
+  int groups = width_ / group_pixels;
+  int tail = width_ - groups * group_pixels;
+
+  cv::parallel_for_(cv::Range(0, height_), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      const uint8_t* in = Row(r);
+      uint16_t* out = dst.ptr<uint16_t>(r);
+      UnpackGroups(format_, in, out, groups);
+
+      // A partial final group is unpacked from a copy of its bytes
+      if (tail > 0) {
+        uint8_t bytes[8];
+        uint16_t pixels[4];
+        std::memcpy(bytes, in + static_cast<size_t>(groups) * group_bytes,
+                    group_bytes);
+        UnpackGroups(format_, bytes, pixels, 1);
+        std::copy(pixels, pixels + tail, out + groups * group_pixels);
+      }
+
+      if (!identity) {
+        for (int c = 0; c < width_; c++) {
+          out[c] = lut[out[c]];
+        }
+      }
+    }
+  });
+}
+
+cv::Mat LoadCfa(const string& filename, const RawOptions& options,
+                int max_value, RawReader& reader) {
+  if (options.format.empty()) {
+    return cv::imread(filename, cv::IMREAD_UNCHANGED);
+  }
+  reader.Open(filename, ParseRawFormat(options.format), options.width,
+              options.height, options.stride, options.offset);
+  return reader.Read(options.black_level, options.white_level, max_value);
+}
+}  // namespace ipcv
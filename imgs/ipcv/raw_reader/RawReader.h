@@ -0,0 +1,149 @@
+/** Interface file for packed raw sensor file reader
+ *
+ *  \file ipcv/raw_reader/RawReader.h
+ *
+ *  \description
+ *    Reads headerless raw CFA frames as written by camera sensors such as
+ *    those on the Raspberry Pi.  The file is memory mapped and unpacked
+ *    directly into a CV_16UC1 image, in parallel row bands, with the black
+ *    and white level normalization applied in the same pass.
+ *
+ *    Supported packings (all little-endian):
+ *      raw10   MIPI RAW10, 4 pixels in 5 bytes (the 8 MSBs of each pixel
+ *              followed by a byte holding the 2 LSBs of all 4)
+ *      raw12   MIPI RAW12, 2 pixels in 3 bytes (the 8 MSBs of each pixel
+ *              followed by a byte holding the 4 LSBs of both)
+ *      raw14   MIPI RAW14, 4 pixels in 7 bytes (the 8 MSBs of each pixel
+ *              followed by 3 bytes holding the 6 LSBs of all 4)
+ *      raw16   one pixel per 16-bit word
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Raw pixel packing
+ */
+enum class RawFormat { raw10, raw12, raw14, raw16 };
+
+/** Parse a raw pixel packing name
+ *
+ *  \param[in] name   one of 'raw10', 'raw12', 'raw14', or 'raw16' (case
+ *                    insensitive)
+ *
+ *  \return           the raw pixel packing
+ */
+RawFormat ParseRawFormat(const std::string& name);
+
+class RawReader {
+ public:
+  /* Constructors
+   */
+  RawReader() = default;
+
+  /*
+   * \param[in] filename   raw file to map
+   * \param[in] format     pixel packing
+   * \param[in] width      frame width [pixels]
+   * \param[in] height     frame height [pixels]
+   * \param[in] stride     bytes between the start of consecutive rows
+   *                       [default (0) is the packed row length]
+   * \param[in] offset     bytes preceding the first row [default is 0]
+   */
+  RawReader(const std::string& filename, RawFormat format, int width,
+            int height, size_t stride = 0, size_t offset = 0);
+
+  /* Map a raw file (the arguments are those of the constructor)
+   */
+  void Open(const std::string& filename, RawFormat format, int width,
+            int height, size_t stride = 0, size_t offset = 0);
+
+  /* Getters
+   */
+  RawFormat format() const { return format_; }
+  int width() const { return width_; }
+  int height() const { return height_; }
+  size_t stride() const { return stride_; }
+  size_t offset() const { return offset_; }
+
+  /* Significant bits per pixel of the packing
+   */
+  int bits() const;
+
+  /* Read the frame, the samples are linearly mapped so that the black level
+   * becomes 0 and the white level becomes max_value (clamping outside of
+   * that range)
+   *
+   * \param[in] black_level   black level [default is 0]
+   * \param[in] white_level   white level [default (-1) is the largest
+   *                          value the packing holds]
+   * \param[in] max_value     normalized white level [default is 65535]
+   *
+   * \return   cv::Mat of CV_16UC1; for raw16 data needing no normalization
+   *           this is a view of the mapped file (no copy is made), valid only
+   *           while this reader remains open
+   */
+  cv::Mat Read(int black_level = 0, int white_level = -1,
+               int max_value = 65535) const;
+
+  /* Read the frame into the provided destination (reusing its buffer when it
+   * is already of the correct size and type), normalizing as in Read above
+   */
+  void Read(cv::Mat& dst, int black_level = 0, int white_level = -1,
+            int max_value = 65535) const;
+
+  /* View of raw16 data in the mapped file, valid only while this reader
+   * remains open
+   */
+  cv::Mat View() const;
+
+ private:
+  const uint8_t* Row(int row) const;
+
+  boost::iostreams::mapped_file_source file_;
+  RawFormat format_ = RawFormat::raw16;
+  int width_ = 0;
+  int height_ = 0;
+  size_t stride_ = 0;
+  size_t offset_ = 0;
+};
+
+/** Raw frame description, as given on an application's command line
+ */
+struct RawOptions {
+  /* Pixel packing name, empty for an image file */
+  std::string format;
+
+  /* Frame geometry, as for RawReader::Open */
+  int width = 0;
+  int height = 0;
+  size_t stride = 0;
+  size_t offset = 0;
+
+  /* Levels, as for RawReader::Read */
+  int black_level = 0;
+  int white_level = -1;
+};
+
+/** Load a CFA source, either a headerless raw frame (when a packing is
+ *  provided) or an image file
+ *
+ *  \param[in] filename    source filename
+ *  \param[in] options     raw frame description, an empty format reads the
+ *                         file with cv::imread (IMREAD_UNCHANGED)
+ *  \param[in] max_value   normalized white level of a raw frame
+ *  \param[out] reader     reader mapping a raw frame, which must outlive the
+ *                         returned image (raw16 data is viewed in place)
+ *
+ *  \return                source cv::Mat
+ */
+cv::Mat LoadCfa(const std::string& filename, const RawOptions& options,
+                int max_value, RawReader& reader);
+}
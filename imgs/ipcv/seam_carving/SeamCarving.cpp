@@ -6,231 +6,282 @@
  *  \note So this is it huh
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include <opencv2/core.hpp>
-#include <opencv2/highgui.hpp>
-#include <opencv2/imgproc.hpp>
 
 #include "SeamCarving.h"
 
+#include "imgs/ipcv/utils/LocalEntropy.h"
+
 using namespace std;
 
 namespace ipcv {
 
-cv::Mat IndivSeam(const cv::Mat& src, char direction) {
-  cv::Mat kernel_x;
-  cv::Mat kernel_y;
-  kernel_x.create(3, 3, CV_32FC1);
-  kernel_x.at<float>(0, 0) = -1;
-  kernel_x.at<float>(0, 1) = -2;
-  kernel_x.at<float>(0, 2) = -1;
-  kernel_x.at<float>(2, 0) = 1;
-  kernel_x.at<float>(2, 1) = 2;
-  kernel_x.at<float>(2, 2) = 1;
-  cv::transpose(kernel_x, kernel_y);
-
-  kernel_x /= 9.0;
-  kernel_y /= 9.0;
-  cv::Point anchor;
-  anchor.x = 1;
-  anchor.y = 1;
-  cv::Mat filter_x = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-  cv::Mat filter_y = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-  int ddepth = CV_32FC1;
-
-  cv::filter2D(src, filter_x, ddepth, kernel_x, anchor);
-  cv::filter2D(src, filter_y, ddepth, kernel_y, anchor);
-  cv::Mat energy = cv::Mat::zeros(src.rows, src.cols, src.type());
-  cv::Mat point;
-  point.create(1, 256, CV_32FC1);
-  cv::Mat section;
-  section.create(9, 9, CV_32FC1);
-  float total_energy = 10000;
-  float current_energy = 10000;
-  cv::Mat dst;
-  cv::Mat src_dupe;
-
-  for (int row = 4; row < src.rows - 4; row++) {
-    for (int col = 4; col < src.cols - 4; col++) {
-      for (float row_2 = -4; row_2 < 5; row_2++) {
-        for (float col_2 = -4; col_2 < 5; col_2++) {
-          int idx = src.at<float>(row + row_2, col + col_2);
-          section.at<float>(row_2 + 4, col_2 + 4) =
-              src.at<float>(row + row_2, col + col_2);
-          point.at<float>(0, idx) = point.at<float>(0, idx) + 1;
-        }
-      }
-      point /= 81;
-      float energy_count = 0;
-      for (int row_2 = 0; row_2 < 256; row_2++) {
-        if (point.at<float>(0, row_2) != 0) {
-          energy_count = energy_count + (-1 * point.at<float>(0, row_2) *
-                                         log2(point.at<float>(0, row_2)));
-        }
+namespace {
+
+// Radius of the local entropy neighborhood (the 3x3 Sobel neighborhood is
+// always contained within it)
+const int kRadius = 4;
+
+/** Seam carving state for removing vertical seams
+ *
+ *  The image, energy and original-column index buffers keep their full
+ *  allocated width; only the leading width_ columns of each row are valid.
+ *  Removing a seam compacts each row in place, so no image is ever copied.
+ */
+class SeamCarver {
+ public:
+  explicit SeamCarver(const cv::Mat& src) {
+    src.convertTo(image_, CV_32F);
+    width_ = image_.cols;
+
+    energy_.create(image_.size(), CV_32FC1);
+    cumulative_.create(image_.size(), CV_32FC1);
+
+    index_.create(image_.size(), CV_32SC1);
+    for (int r = 0; r < index_.rows; r++) {
+      int* index = index_.ptr<int>(r);
+      for (int c = 0; c < index_.cols; c++) {
+        index[c] = c;
       }
-      energy.at<float>(row, col) = energy_count;
-      point = cv::Mat::zeros(1, 256, CV_32FC1);
     }
-  }
 
-  cv::Mat ent_component = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-  for (int row = 0; row < src.rows; row++) {
-    for (int col = 0; col < src.cols; col++) {
-      float x_component = filter_x.at<float>(row, col);
-      float y_component = filter_y.at<float>(row, col);
-      ent_component.at<float>(row, col) =
-          sqrt(x_component * x_component + y_component * y_component);
-    }
+    spans_.assign(image_.rows, cv::Range(0, width_));
+    ComputeEnergy();
   }
-  ent_component = abs(ent_component);
 
-  cv::Mat entropy = energy + ent_component;
+  int width() const { return width_; }
+
+  const cv::Mat& index() const { return index_; }
 
-  for (int row = 0; row < src.rows; row++) {
-    for (int col = 0; col < src.cols; col++) {
-      if ((row < 4 || row > src.rows - 5) || (col < 4 || col > src.cols - 5)) {
-        entropy.at<float>(row, col) = 10000;
+  cv::Mat image() const { return image_.colRange(0, width_).clone(); }
+
+  /* Find the minimum cumulative energy vertical seam, O(WH)
+   */
+  vector<int> FindSeam() {
+    int rows = image_.rows;
+    int w = width_;
+
+    std::copy(energy_.ptr<float>(0), energy_.ptr<float>(0) + w,
+              cumulative_.ptr<float>(0));
+    for (int r = 1; r < rows; r++) {
+      const float* e = energy_.ptr<float>(r);
+      const float* prev = cumulative_.ptr<float>(r - 1);
+      float* cur = cumulative_.ptr<float>(r);
+      if (w == 1) {
+        cur[0] = e[0] + prev[0];
+        continue;
       }
+      cur[0] = e[0] + min(prev[0], prev[1]);
+      for (int c = 1; c < w - 1; c++) {
+        cur[c] = e[c] + min(prev[c - 1], min(prev[c], prev[c + 1]));
+      }
+      cur[w - 1] = e[w - 1] + min(prev[w - 2], prev[w - 1]);
     }
-  }
-  if (direction == 'r') {
-    dst.create(src.rows - 1, src.cols, CV_32FC1);
-    float current_row = 0;
-    for (int row = 4; row < src.rows - 5; row++) {
-      if (total_energy < current_energy) {
-        current_energy = total_energy;
-        current_row = row - 1;
+
+    // Backtrack from the minimum of the last row
+    vector<int> seam(rows);
+    const float* last = cumulative_.ptr<float>(rows - 1);
+    seam[rows - 1] = static_cast<int>(min_element(last, last + w) - last);
+    for (int r = rows - 2; r >= 0; r--) {
+      const float* m = cumulative_.ptr<float>(r);
+      int c = seam[r + 1];
+      int best = c;
+      if (c > 0 && m[c - 1] < m[best]) {
+        best = c - 1;
       }
-      float current_val = row;
-      total_energy = 0;
-      for (int col = 4; col < src.cols - 5; col++) {
-        float w = entropy.at<float>(current_val - 1, col + 1);
-        float c = entropy.at<float>(current_val, col + 1);
-        float e = entropy.at<float>(current_val + 1, col + 1);
-        if (w < c && w < e) {
-          current_val = current_val - 1;
-        } else if (c < w && c < e) {
-          current_val = current_val;
-        } else if (e < c && e < w) {
-          current_val = current_val + 1;
-        }
-        total_energy = total_energy + entropy.at<float>(current_val, col + 1);
+      if (c < w - 1 && m[c + 1] < m[best]) {
+        best = c + 1;
       }
+      seam[r] = best;
     }
-    cout << "Current size: " << src.size() << endl;
-    cout << "Current row: " << current_row << endl;
-    cout << "Row energy: " << current_energy << endl;
-    cout << endl;
-
-    int current_val = current_row;
-    src.copyTo(src_dupe);
-    for (int col = 0; col < src.cols; col++) {
-      if (col <= 4) {
-        src_dupe.at<float>(current_row, col) = 10001;
-      } else if (col > 3 && col < src.cols - 5) {
-        float w = entropy.at<float>(current_val - 1, col + 1);
-        float c = entropy.at<float>(current_val, col + 1);
-        float e = entropy.at<float>(current_val + 1, col + 1);
-        if (w < c && w < e) {
-          current_val = current_val - 1;
-        } else if (c < w && c < e) {
-          current_val = current_val;
-        } else if (e < c && e < w) {
-          current_val = current_val + 1;
-        }
-        src_dupe.at<float>(current_val, col + 1) = 10000;
-      } else {
-        src_dupe.at<float>(current_val, col) = 10001;
+
+    return seam;
+  }
+
+  /* Remove the provided vertical seam and refresh the energy around it
+   */
+  void RemoveSeam(const vector<int>& seam) {
+    int rows = image_.rows;
+
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& range) {
+      for (int r = range.start; r < range.end; r++) {
+        int s = seam[r];
+        size_t n = width_ - s - 1;
+        float* image = image_.ptr<float>(r);
+        memmove(image + s, image + s + 1, n * sizeof(float));
+        float* energy = energy_.ptr<float>(r);
+        memmove(energy + s, energy + s + 1, n * sizeof(float));
+        int* index = index_.ptr<int>(r);
+        memmove(index + s, index + s + 1, n * sizeof(int));
       }
-    }
+    });
+    width_--;
 
-    for (int col = 0; col < src.cols; col++) {
-      int r_0 = 0;
-      for (int row = 0; row < src.rows - 1; row++) {
-        dst.at<float>(row, col) = src.at<float>(r_0, col);
-        if (src_dupe.at<float>(row + 1, col) == 10000) {
-          r_0 = r_0 + 2;
-        } else {
-          r_0 = r_0 + 1;
-        }
+    // A pixel's energy only changes if its neighborhood straddled the seam
+    // in one of the neighborhood's rows, everywhere else the (shifted)
+    // energy is still valid
+    for (int r = 0; r < rows; r++) {
+      int lo = seam[r];
+      int hi = seam[r];
+      for (int rr = max(0, r - kRadius); rr <= min(rows - 1, r + kRadius);
+           rr++) {
+        lo = min(lo, seam[rr]);
+        hi = max(hi, seam[rr]);
       }
+      spans_[r] = cv::Range(max(0, lo - kRadius), min(width_, hi + kRadius));
     }
-  } else if (direction == 'c') {
-    dst.create(src.rows, src.cols - 1, CV_32FC1);
-    float current_col = 0;
-    for (int col = 4; col < src.cols - 5; col++) {
-      if (total_energy < current_energy) {
-        current_energy = total_energy;
-        current_col = col - 1;
-      }
-      float current_val = col;
-      total_energy = 0;
-      for (int row = 4; row < src.rows - 5; row++) {
-        float w = entropy.at<float>(row + 1, current_val - 1);
-        float c = entropy.at<float>(row + 1, current_val);
-        float e = entropy.at<float>(row + 1, current_val + 1);
-        if (w < c && w < e) {
-          current_val = current_val - 1;
-        } else if (c < w && c < e) {
-          current_val = current_val;
-        } else if (e < c && e < w) {
-          current_val = current_val + 1;
+    ComputeEnergy();
+  }
+
+ private:
+  /* Energy (local entropy + Sobel gradient magnitude) over the column span
+   * of each row in spans_, neighborhoods are clamped at the image (and
+   * current width) boundaries.  The entropy of every span is computed in a
+   * single (parallel) call so its setup is shared by all rows.
+   */
+  void ComputeEnergy() {
+    cv::Mat image = image_.colRange(0, width_);
+    cv::Mat energy = energy_.colRange(0, width_);
+    ipcv::LocalEntropy(image, energy, kRadius, spans_);
+
+    cv::parallel_for_(cv::Range(0, image_.rows), [&](const cv::Range& range) {
+      for (int row = range.start; row < range.end; row++) {
+        const float* above = image_.ptr<float>(max(row - 1, 0));
+        const float* center = image_.ptr<float>(row);
+        const float* below = image_.ptr<float>(min(row + 1, image_.rows - 1));
+        float* e = energy_.ptr<float>(row);
+        for (int c = spans_[row].start; c < spans_[row].end; c++) {
+          int cl = max(c - 1, 0);
+          int cr = min(c + 1, width_ - 1);
+          float gx = (below[cl] + 2 * below[c] + below[cr] - above[cl] -
+                      2 * above[c] - above[cr]) /
+                     9.0f;
+          float gy = (above[cr] + 2 * center[cr] + below[cr] - above[cl] -
+                      2 * center[cl] - below[cl]) /
+                     9.0f;
+          e[c] += sqrt(gx * gx + gy * gy);
         }
-        total_energy = total_energy + entropy.at<float>(row + 1, current_val);
       }
-    }
-    cout << "Current size: " << src.size() << endl;
-    cout << "Current column: " << current_col << endl;
-    cout << "Column energy: " << current_energy << endl;
-    cout << endl;
-
-    int current_val = current_col;
-    src.copyTo(src_dupe);
-    for (int row = 0; row < src.rows; row++) {
-      if (row <= 4) {
-        src_dupe.at<float>(row, current_col) = 10001;
-      } else if (row > 3 && row < src.rows - 5) {
-        float w = entropy.at<float>(row + 1, current_val - 1);
-        float c = entropy.at<float>(row + 1, current_val);
-        float e = entropy.at<float>(row + 1, current_val + 1);
-        if (w < c && w < e) {
-          current_val = current_val - 1;
-        } else if (c < w && c < e) {
-          current_val = current_val;
-        } else if (e < c && e < w) {
-          current_val = current_val + 1;
-        }
-        src_dupe.at<float>(row + 1, current_val) = 10000;
-      } else {
-        src_dupe.at<float>(row, current_val) = 10001;
+    });
+  }
+
+  cv::Mat image_;
+  cv::Mat energy_;
+  cv::Mat cumulative_;
+  cv::Mat index_;
+  vector<cv::Range> spans_;  // columns of each row whose energy is stale
+  int width_;
+};
+
+/* Orient the source so that the requested seams are vertical
+ */
+cv::Mat Orient(const cv::Mat& src, char direction) {
+  if (src.channels() != 1) {
+    cerr << "Seam carving requires a single-channel source image" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cv::Mat oriented;
+  if (direction == 'r') {
+    cv::transpose(src, oriented);
+  } else if (direction == 'c') {
+    oriented = src;
+  } else {
+    cerr << "Invalid seam direction provided: " << direction << endl;
+    exit(EXIT_FAILURE);
+  }
+  return oriented;
+}
+
+/* Undo the orientation applied by Orient
+ */
+cv::Mat Unorient(const cv::Mat& src, char direction) {
+  cv::Mat dst;
+  if (direction == 'r') {
+    cv::transpose(src, dst);
+  } else {
+    dst = src;
+  }
+  return dst;
+}
+
+}  // namespace
+
+cv::Mat IndivSeam(const cv::Mat& src, char direction) {
+  return RemoveSeams(src, 1, direction);
+}
+
+cv::Mat RemoveSeams(const cv::Mat& src, int count, char direction) {
+  cv::Mat oriented = Orient(src, direction);
+  if (count < 0 || count >= oriented.cols) {
+    cerr << "Number of seams to remove must be less than the image extent"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  SeamCarver carver(oriented);
+  for (int idx = 0; idx < count; idx++) {
+    carver.RemoveSeam(carver.FindSeam());
+  }
+
+  return Unorient(carver.image(), direction);
+}
+
+cv::Mat InsertSeams(const cv::Mat& src, int count, char direction) {
+  cv::Mat oriented = Orient(src, direction);
+  if (count < 0 || count >= oriented.cols) {
+    cerr << "Number of seams to insert must be less than the image extent"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Find the seams to duplicate by removing them from a working copy, the
+  // original columns that do not survive are the seam pixels
+  SeamCarver carver(oriented);
+  for (int idx = 0; idx < count; idx++) {
+    carver.RemoveSeam(carver.FindSeam());
+  }
+
+  cv::Mat image;
+  oriented.convertTo(image, CV_32F);
+  int cols = image.cols;
+
+  cv::Mat dst(image.rows, cols + count, CV_32FC1);
+  cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& range) {
+    vector<uint8_t> seam(cols);
+    for (int r = range.start; r < range.end; r++) {
+      std::fill(seam.begin(), seam.end(), 1);
+      const int* index = carver.index().ptr<int>(r);
+      for (int c = 0; c < carver.width(); c++) {
+        seam[index[c]] = 0;
       }
-    }
 
-    for (int row = 0; row < src.rows; row++) {
-      int col_2 = 0;
-      for (int col = 0; col < src.cols - 1; col++) {
-        dst.at<float>(row, col) = src.at<float>(row, col_2);
-        if (src_dupe.at<float>(row, col + 1) == 10000) {
-          col_2 = col_2 + 2;
-        } else {
-          col_2 = col_2 + 1;
+      const float* in = image.ptr<float>(r);
+      float* out = dst.ptr<float>(r);
+      for (int c = 0; c < cols; c++) {
+        *out++ = in[c];
+        if (seam[c]) {
+          // Neighbors are clamped (replicated) at the image boundary
+          int left = max(c - 1, 0);
+          int right = min(c + 1, cols - 1);
+          *out++ = (in[left] + in[right]) / 2;
         }
       }
     }
-  }
+  });
 
-  return dst;
+  return Unorient(dst, direction);
 }
 
 cv::Mat SeamCarving(const cv::Mat& src, int rows, int cols) {
-  cv::Mat dst = src;
-  for (int idx = 0; idx < rows; idx++) {
-    dst = ipcv::IndivSeam(dst, 'r');
-  }
-  for (int idx = 0; idx < cols; idx++) {
-    dst = ipcv::IndivSeam(dst, 'c');
-  }
+  cv::Mat dst = ipcv::RemoveSeams(src, rows, 'r');
+  dst = ipcv::RemoveSeams(dst, cols, 'c');
   return dst;
 }
 
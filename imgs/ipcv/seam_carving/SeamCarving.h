@@ -1,14 +1,75 @@
-// \imgs\ipcv\seam_carving\SeamCarve.h
+/** Interface file for seam carving
+ *
+ *  \file ipcv/seam_carving/SeamCarving.h
+ *  \author Josh Carstens, Looking for a Hot Date (jc@mail.rit.edu)
+ *  \date 30 Apr 2021
+ *
+ *  \description
+ *    Content-aware resizing after Avidan and Shamir.  The energy of each
+ *    pixel is the sum of its local (9x9) entropy and its Sobel gradient
+ *    magnitude.  The minimum-energy seam is found with a cumulative-energy
+ *    dynamic program, and after each removal the energy is only recomputed
+ *    in the band of columns whose neighborhood touched the removed seam.
+ *
+ *    A direction of 'c' removes (or inserts) vertical seams, changing the
+ *    number of columns; a direction of 'r' removes (or inserts) horizontal
+ *    seams, changing the number of rows.
+ */
 
 #pragma once
 
-#include <string>
-
 #include <opencv2/core.hpp>
 
-using namespace std;
-
 namespace ipcv {
+
+/** Remove a single seam from the source image
+ *
+ *  \param[in] src         source cv::Mat of any single-channel type
+ *                         (values are expected in the range [0, 255])
+ *  \param[in] direction   'r' to remove a row seam, 'c' to remove a
+ *                         column seam
+ *
+ *  \return                destination cv::Mat of CV_32FC1
+ */
 cv::Mat IndivSeam(const cv::Mat& src, char direction);
-cv::Mat SeamCarving(const cv::Mat &src, int rows, int cols);
+
+/** Remove multiple seams from the source image
+ *
+ *  \param[in] src         source cv::Mat of any single-channel type
+ *                         (values are expected in the range [0, 255])
+ *  \param[in] count       number of seams to remove
+ *  \param[in] direction   'r' to remove row seams, 'c' to remove column
+ *                         seams
+ *
+ *  \return                destination cv::Mat of CV_32FC1
+ */
+cv::Mat RemoveSeams(const cv::Mat& src, int count, char direction);
+
+/** Enlarge the source image by inserting seams
+ *
+ *  The count lowest-energy seams are found on a working copy of the image
+ *  and each is then duplicated in the source, the inserted pixel being the
+ *  average of the seam pixel's left and right neighbors.
+ *
+ *  \param[in] src         source cv::Mat of any single-channel type
+ *                         (values are expected in the range [0, 255])
+ *  \param[in] count       number of seams to insert (must be less than the
+ *                         extent of the image in the carved direction)
+ *  \param[in] direction   'r' to insert row seams, 'c' to insert column
+ *                         seams
+ *
+ *  \return                destination cv::Mat of CV_32FC1
+ */
+cv::Mat InsertSeams(const cv::Mat& src, int count, char direction);
+
+/** Seam carve the source image
+ *
+ *  \param[in] src    source cv::Mat of any single-channel type
+ *                    (values are expected in the range [0, 255])
+ *  \param[in] rows   number of row seams to remove
+ *  \param[in] cols   number of column seams to remove
+ *
+ *  \return           destination cv::Mat of CV_32FC1
+ */
+cv::Mat SeamCarving(const cv::Mat& src, int rows, int cols);
 }
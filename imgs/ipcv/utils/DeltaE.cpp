@@ -5,288 +5,333 @@
  *  \date 04 Jan 2019
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
+#include <vector>
 
-#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
 
 #include "DeltaE.h"
 
+#include "imgs/ipcv/color_conversion/ColorConversion.h"
+
 using namespace std;
 
 namespace ipcv {
 
-double DeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
-              const cv::Mat& weights, cv::Mat& dE, int standard,
-              std::string application) {
-  if ((src1.rows != src2.rows) || (src1.cols != src2.cols) ||
-      (src1.channels() != src2.channels())) {
-    cerr << "Image dimensions must match exactly for PSNR computation" << endl;
-    exit(EXIT_FAILURE);
-  }
+namespace {
 
-  if (src1.channels() != 3) {
-    cerr << "Images must be 3-channel for delta E computation" << endl;
-    exit(EXIT_FAILURE);
-  }
+// Rows per parallel work item (partial sums are kept per band so the
+// result does not depend on the thread count)
+const int kBandRows = 32;
 
-  cv::Mat src1_normalized;
-  src1.convertTo(src1_normalized, CV_32F, 1.0 / static_cast<float>(max_value));
-  cv::Mat src2_normalized;
-  src2.convertTo(src2_normalized, CV_32F, 1.0 / static_cast<float>(max_value));
+const float kPi = 3.14159265358979f;
 
-  cv::Mat lab1;
-  cv::cvtColor(src1_normalized, lab1, cv::COLOR_BGR2Lab);
-  cv::Mat lab2;
-  cv::cvtColor(src2_normalized, lab2, cv::COLOR_BGR2Lab);
+// 25^7, the chroma scale of the CIEDE2000 a* correction and rotation term
+const float k25To7 = 6103515625.0f;
 
-  double deltae;
+/* Convert one BGR source row to interleaved L*a*b*, 8- and 16-bit sources
+ * are linearized through a table and other depths are staged as float
+ */
+template <typename T>
+void ToLab(const cv::Mat& src, int row, float scale, float* buffer,
+           float* lab) {
+  const T* p = src.ptr<T>(row);
+  for (int idx = 0; idx < 3 * src.cols; idx++) {
+    buffer[idx] = static_cast<float>(p[idx]);
+  }
+  BgrToLabRow(buffer, src.cols, scale, lab);
+}
 
-  switch (standard) {
-    case 1976: {
-      // Compute squared differences between L*a*b* for the two source images
-      cv::Mat se;
-      cv::subtract(lab1, lab2, se);
-      cv::multiply(se, se, se);
+void ToLab(const cv::Mat& src, int row, const vector<float>& lut, float scale,
+           float* buffer, float* lab) {
+  switch (src.depth()) {
+    case CV_8U:
+      BgrToLabRow(src.ptr<uint8_t>(row), src.cols, lut, lab);
+      break;
+    case CV_16U:
+      BgrToLabRow(src.ptr<uint16_t>(row), src.cols, lut, lab);
+      break;
+    case CV_32F:
+      BgrToLabRow(src.ptr<float>(row), src.cols, scale, lab);
+      break;
+    case CV_16S:
+      ToLab<int16_t>(src, row, scale, buffer, lab);
+      break;
+    case CV_32S:
+      ToLab<int32_t>(src, row, scale, buffer, lab);
+      break;
+    default:
+      ToLab<double>(src, row, scale, buffer, lab);
+      break;
+  }
+}
 
-      // Split into separate L*, a*, and b* squared difference channels
-      cv::Mat channels_se[3];
-      cv::split(se, channels_se);
+/* Linearization table for an 8- or 16-bit unsigned source (empty otherwise)
+ */
+vector<float> LinearLut(int depth, int max_value) {
+  if ((depth == CV_8U) || (depth == CV_16U)) {
+    return LinearizationLut(depth, max_value);
+  }
+  return vector<float>();
+}
 
-      // Compute delta E
-      dE = channels_se[0] + channels_se[1] + channels_se[2];
-      cv::sqrt(dE, dE);
-      break;
+void DeltaE1976(const float* lab1, const float* lab2, int cols, float* dE) {
+  for (int c = 0; c < cols; c++) {
+    float dL = lab1[3 * c] - lab2[3 * c];
+    float da = lab1[3 * c + 1] - lab2[3 * c + 1];
+    float db = lab1[3 * c + 2] - lab2[3 * c + 2];
+    dE[c] = sqrt(dL * dL + da * da + db * db);
+  }
+}
+
+/* CIE94 with src1 as the reference (its chroma sets the weighting)
+ */
+void DeltaE1994(const float* lab1, const float* lab2, int cols, float kL,
+                float K1, float K2, float* dE) {
+  for (int c = 0; c < cols; c++) {
+    float dL = (lab1[3 * c] - lab2[3 * c]) / kL;
+    float a1 = lab1[3 * c + 1];
+    float b1 = lab1[3 * c + 2];
+    float a2 = lab2[3 * c + 1];
+    float b2 = lab2[3 * c + 2];
+    float C1 = sqrt(a1 * a1 + b1 * b1);
+    float C2 = sqrt(a2 * a2 + b2 * b2);
+    float dC = C1 - C2;
+    float da = a1 - a2;
+    float db = b1 - b2;
+    // Squared hue difference (clamped, rounding can make it negative)
+    float dH2 = max(da * da + db * db - dC * dC, 0.0f);
+    float SC = 1 + K1 * C1;
+    float SH = 1 + K2 * C1;
+    dE[c] = sqrt(dL * dL + dC * dC / (SC * SC) + dH2 / (SH * SH));
+  }
+}
+
+/* CIEDE2000 (kL = kC = kH = 1), hue angles in radians
+ */
+void DeltaE2000(const float* lab1, const float* lab2, int cols, float* dE) {
+  const float tolerance = 1.0e-15f;
+  const float deg = kPi / 180;
+
+  for (int c = 0; c < cols; c++) {
+    float L1 = lab1[3 * c];
+    float L2 = lab2[3 * c];
+    float b1 = lab1[3 * c + 2];
+    float b2 = lab2[3 * c + 2];
+
+    float Cstar1 = sqrt(lab1[3 * c + 1] * lab1[3 * c + 1] + b1 * b1);
+    float Cstar2 = sqrt(lab2[3 * c + 1] * lab2[3 * c + 1] + b2 * b2);
+    float Cbar7 = pow((Cstar1 + Cstar2) / 2, 7.0f);
+    float G = 0.5f * (1 - sqrt(Cbar7 / (Cbar7 + k25To7)));
+    float a1 = lab1[3 * c + 1] * (1 + G);
+    float a2 = lab2[3 * c + 1] * (1 + G);
+
+    float C1 = sqrt(a1 * a1 + b1 * b1);
+    float C2 = sqrt(a2 * a2 + b2 * b2);
+
+    float h1 = 0;
+    if ((abs(b1) >= tolerance) || (abs(a1) >= tolerance)) {
+      h1 = atan2(b1, a1);
+      h1 += (h1 < 0) ? 2 * kPi : 0;
+    }
+    float h2 = 0;
+    if ((abs(b2) >= tolerance) || (abs(a2) >= tolerance)) {
+      h2 = atan2(b2, a2);
+      h2 += (h2 < 0) ? 2 * kPi : 0;
     }
 
-    case 1994: {
-      dE.create(src1.rows, src1.cols, CV_32F);
-
-      double kL;
-      double K1;
-      double K2;
-      if (application == "graphic_arts") {
-        kL = 1.0;
-        K1 = 0.045;
-        K2 = 0.015;
-      } else if (application == "textiles") {
-        kL = 2.0;
-        K1 = 0.048;
-        K2 = 0.014;
+    float dh = 0;
+    float Hbar = h1 + h2;
+    if ((C1 * C2) != 0) {
+      dh = h2 - h1;
+      if (dh > kPi) {
+        dh -= 2 * kPi;
+      } else if (dh < -kPi) {
+        dh += 2 * kPi;
+      }
+      if (abs(h1 - h2) <= kPi) {
+        Hbar = (h1 + h2) / 2;
+      } else if ((h1 + h2) < 2 * kPi) {
+        Hbar = (h1 + h2 + 2 * kPi) / 2;
       } else {
-        cerr << "Specified application for delta E 1994 not supported: "
-             << application << endl;
-        exit(EXIT_FAILURE);
+        Hbar = (h1 + h2 - 2 * kPi) / 2;
       }
-      double kC = 1.0;
-      double kH = 1.0;
-
-      for (int r = 0; r < dE.rows; r++) {
-        for (int c = 0; c < dE.cols; c++) {
-          const auto& lab1_value = lab1.at<cv::Vec3f>(r, c);
-          const auto& lab2_value = lab2.at<cv::Vec3f>(r, c);
-          auto& dE_value = dE.at<float>(r, c);
+    }
 
-          double Lstar1 = lab1_value[0];
-          double astar1 = lab1_value[1];
-          double bstar1 = lab1_value[2];
+    float dL = L2 - L1;
+    float dC = C2 - C1;
+    float dH = 2 * sqrt(C1 * C2) * sin(dh / 2);
+
+    float T = 1 - 0.17f * cos(Hbar - 30 * deg) + 0.24f * cos(2 * Hbar) +
+              0.32f * cos(3 * Hbar + 6 * deg) -
+              0.20f * cos(4 * Hbar - 63 * deg);
+
+    float Lbar50 = (L1 + L2) / 2 - 50;
+    float SL = 1 + 0.015f * Lbar50 * Lbar50 / sqrt(20 + Lbar50 * Lbar50);
+    float Cbarprimed = (C1 + C2) / 2;
+    float SC = 1 + 0.045f * Cbarprimed;
+    float SH = 1 + 0.015f * Cbarprimed * T;
+
+    float Cbarprimed7 = pow(Cbarprimed, 7.0f);
+    float theta = (Hbar / deg - 275) / 25;
+    float RT = -2 * sqrt(Cbarprimed7 / (Cbarprimed7 + k25To7)) *
+               sin(60 * deg * exp(-theta * theta));
+
+    float tL = dL / SL;
+    float tC = dC / SC;
+    float tH = dH / SH;
+    dE[c] = sqrt(max(tL * tL + tC * tC + tH * tH + RT * tC * tH, 0.0f));
+  }
+}
 
-          double Lstar2 = lab2_value[0];
-          double astar2 = lab2_value[1];
-          double bstar2 = lab2_value[2];
+/* Single pass delta E, the map is only written if dE is provided and the
+ * weights are optional
+ */
+double MeanDeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
+                  const cv::Mat* weights, cv::Mat* dE, int standard,
+                  const std::string& application) {
+  if ((src1.rows != src2.rows) || (src1.cols != src2.cols) ||
+      (src1.channels() != src2.channels())) {
+    cerr << "Image dimensions must match exactly for delta E computation"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
 
-          double deltaLstar = Lstar1 - Lstar2;
+  if (src1.channels() != 3) {
+    cerr << "Images must be 3-channel for delta E computation" << endl;
+    exit(EXIT_FAILURE);
+  }
 
-          double Cstar1 = sqrt(pow(astar1, 2.0) + pow(bstar1, 2.0));
-          double Cstar2 = sqrt(pow(astar2, 2.0) + pow(bstar2, 2.0));
-          double deltaCstarab = Cstar1 - Cstar2;
+  if ((standard != 1976) && (standard != 1994) && (standard != 2000)) {
+    cerr << "Specified delta E standard not implemented: " << standard
+         << endl;
+    exit(EXIT_FAILURE);
+  }
 
-          double deltaastar = astar1 - astar2;
-          double deltabstar = bstar1 - bstar2;
+  float kL = 1.0f;
+  float K1 = 0.045f;
+  float K2 = 0.015f;
+  if (standard == 1994) {
+    if (application == "textiles") {
+      kL = 2.0f;
+      K1 = 0.048f;
+      K2 = 0.014f;
+    } else if (application != "graphic_arts") {
+      cerr << "Specified application for delta E 1994 not supported: "
+           << application << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
 
-          double deltaHstarab =
-              sqrt(pow(deltaastar, 2.0) + pow(deltabstar, 2.0) -
-                   pow(deltaCstarab, 2.0));
+  cv::Mat weight_map;
+  if (weights) {
+    if ((weights->rows != src1.rows) || (weights->cols != src1.cols) ||
+        (weights->channels() > 1)) {
+      cerr << "Weight map must be single channel with the area of the source "
+              "images for delta E computation"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    weights->convertTo(weight_map, CV_32F);
+  }
 
-          double SL = 1.0;
-          double SC = 1.0 + K1 * Cstar1;
-          double SH = 1.0 + K2 * Cstar1;
+  if (dE) {
+    dE->create(src1.rows, src1.cols, CV_32F);
+  }
 
-          dE_value = sqrt(pow(deltaLstar / kL / SL, 2.0) +
-                          pow(deltaCstarab / kC / SC, 2.0) +
-                          pow(deltaHstarab / kH / SH, 2.0));
+  float scale = 1.0f / static_cast<float>(max_value);
+  vector<float> lut1 = LinearLut(src1.depth(), max_value);
+  vector<float> lut2 = LinearLut(src2.depth(), max_value);
+
+  int bands = (src1.rows + kBandRows - 1) / kBandRows;
+  vector<double> weighted_sum(bands, 0);
+  vector<double> weight_sum(bands, 0);
+
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> lab1(3 * src1.cols);
+    vector<float> lab2(3 * src1.cols);
+    vector<float> staging(3 * src1.cols);
+    vector<float> buffer(src1.cols);
+
+    for (int band = range.start; band < range.end; band++) {
+      int end = min((band + 1) * kBandRows, src1.rows);
+      for (int r = band * kBandRows; r < end; r++) {
+        ToLab(src1, r, lut1, scale, staging.data(), lab1.data());
+        ToLab(src2, r, lut2, scale, staging.data(), lab2.data());
+
+        float* row_dE = dE ? dE->ptr<float>(r) : buffer.data();
+        switch (standard) {
+          case 1976:
+            DeltaE1976(lab1.data(), lab2.data(), src1.cols, row_dE);
+            break;
+          case 1994:
+            DeltaE1994(lab1.data(), lab2.data(), src1.cols, kL, K1, K2,
+                       row_dE);
+            break;
+          default:
+            DeltaE2000(lab1.data(), lab2.data(), src1.cols, row_dE);
+            break;
         }
-      }
-      break;
-    }
 
-    case 2000: {
-      dE.create(src1.rows, src1.cols, CV_32F);
-
-      double tolerance = 1.0e-15;
-      const double PI = 3.141592653589793238463;
-
-      double kL = 1.0;
-      double kC = 1.0;
-      double kH = 1.0;
-
-      for (int r = 0; r < dE.rows; r++) {
-        for (int c = 0; c < dE.cols; c++) {
-          const auto& lab1_value = lab1.at<cv::Vec3f>(r, c);
-          const auto& lab2_value = lab2.at<cv::Vec3f>(r, c);
-          auto& dE_value = dE.at<float>(r, c);
-
-          double Lstar1 = lab1_value[0];
-          double astar1 = lab1_value[1];
-          double bstar1 = lab1_value[2];
-
-          double Lstar2 = lab2_value[0];
-          double astar2 = lab2_value[1];
-          double bstar2 = lab2_value[2];
-
-          double deltaLprimed = Lstar2 - Lstar1;
-
-          double Lbar = (Lstar1 + Lstar2) / 2.0;
-
-          double Cstar1 = sqrt(pow(astar1, 2.0) + pow(bstar1, 2.0));
-          double Cstar2 = sqrt(pow(astar2, 2.0) + pow(bstar2, 2.0));
-          double Cbar = (Cstar1 + Cstar2) / 2.0;
-
-          double aprimed1 =
-              astar1 +
-              astar1 / 2.0 *
-                  (1 - sqrt(pow(Cbar, 7.0) / (pow(Cbar, 7.0) + 6103515625)));
-          double aprimed2 =
-              astar2 +
-              astar2 / 2.0 *
-                  (1 - sqrt(pow(Cbar, 7.0) / (pow(Cbar, 7.0) + 6103515625)));
-
-          double Cprimed1 = sqrt(aprimed1 * aprimed1 + bstar1 * bstar1);
-          double Cprimed2 = sqrt(aprimed2 * aprimed2 + bstar2 * bstar2);
-          double deltaCprimed = Cprimed2 - Cprimed1;
-          double Cbarprimed = (Cprimed1 + Cprimed2) / 2.0;
-
-          double hprimed1;
-          if ((abs(bstar1) < tolerance) && (abs(aprimed1) < tolerance)) {
-            hprimed1 = 0;
-          } else {
-            hprimed1 = atan2(bstar1, aprimed1) * 180 / PI;
-            if (hprimed1 < 0) {
-              hprimed1 += 360;
-            }
+        // The returned map is weighted (as the mean is)
+        double sum = 0;
+        if (weights) {
+          const float* w = weight_map.ptr<float>(r);
+          double w_sum = 0;
+          for (int c = 0; c < src1.cols; c++) {
+            row_dE[c] *= w[c];
+            sum += row_dE[c];
+            w_sum += w[c];
           }
-          double hprimed2;
-          if ((abs(bstar2) < tolerance) && (abs(aprimed2) < tolerance)) {
-            hprimed2 = 0;
-          } else {
-            hprimed2 = atan2(bstar2, aprimed2) * 180 / PI;
-            if (hprimed2 < 0) {
-              hprimed2 += 360;
-            }
+          weight_sum[band] += w_sum;
+        } else {
+          for (int c = 0; c < src1.cols; c++) {
+            sum += row_dE[c];
           }
-
-          double deltahprimed;
-          if ((abs(Cprimed1) < tolerance) || (abs(Cprimed2) < tolerance)) {
-            deltahprimed = 0;
-          } else {
-            double temp = abs(hprimed1 - hprimed2);
-            if (temp <= 180) {
-              deltahprimed = hprimed2 - hprimed1;
-            } else if ((temp > 180) && (hprimed2 <= hprimed1)) {
-              deltahprimed = hprimed2 - hprimed1 + 360;
-            } else if ((temp > 180) && (hprimed2 > hprimed1)) {
-              deltahprimed = hprimed2 - hprimed1 - 360;
-            }
-          }
-
-          double Hbarprimed;
-          if ((abs(Cprimed1) < tolerance) || (abs(Cprimed2) < tolerance)) {
-            Hbarprimed = hprimed1 + hprimed2;
-          } else {
-            double temp = abs(hprimed1 - hprimed2);
-            if (temp <= 180) {
-              Hbarprimed = (hprimed1 + hprimed2) / 2.0;
-            } else if ((temp > 180) && ((hprimed1 + hprimed2) < 360)) {
-              Hbarprimed = (hprimed1 + hprimed2 + 360) / 2.0;
-            } else if ((temp > 180) && ((hprimed1 + hprimed2) >= 360)) {
-              Hbarprimed = (hprimed1 + hprimed2 - 360) / 2.0;
-            }
-          }
-
-          double deltaHprimed = 2 * sqrt(Cprimed1 * Cprimed2) *
-                                sin((deltahprimed / 2) * PI / 180.0);
-
-          double T = 1 - 0.17 * cos((Hbarprimed - 30) * PI / 180.0) +
-                     0.24 * cos((2 * Hbarprimed) * PI / 180.0) +
-                     0.32 * cos((3 * Hbarprimed + 6) * PI / 180.0) -
-                     0.20 * cos((4 * Hbarprimed - 63) * PI / 180.0);
-
-          double SL = 1 + (0.015 * pow(Lbar - 50, 2.0) /
-                           sqrt(20 + pow(Lbar - 50, 2.0)));
-          double SC = 1 + 0.045 * Cbarprimed;
-          double SH = 1 + 0.015 * Cbarprimed * T;
-
-          double RT =
-              -2 *
-              sqrt(pow(Cbarprimed, 7.0) / (pow(Cbarprimed, 7.0) + 6103515625)) *
-              sin((60 * exp(-pow((Hbarprimed - 275) / 25, 2.0))) * PI / 180.0);
-
-          dE_value =
-              sqrt(pow(deltaLprimed / kL / SL, 2.0) +
-                   pow(deltaCprimed / kC / SC, 2.0) +
-                   pow(deltaHprimed / kH / SH, 2.0) +
-                   RT * (deltaCprimed / kC / SC) * (deltaHprimed / kH / SH));
+          weight_sum[band] += src1.cols;
         }
+        weighted_sum[band] += sum;
       }
-      break;
     }
+  });
 
-    default:
-      cerr << "Specified delta E standard not implemented: " << standard
-           << endl;
-      exit(EXIT_FAILURE);
+  double numerator = 0;
+  double denominator = 0;
+  for (int band = 0; band < bands; band++) {
+    numerator += weighted_sum[band];
+    denominator += weight_sum[band];
   }
 
-  // Weight the delta E map
-  cv::Mat weight_map;
-  weights.convertTo(weight_map, CV_32F);
-
-  cv::multiply(dE, weight_map, dE);
+  return numerator / denominator;
+}
 
-  // Compute the mean of the weighted delta E map
-  cv::Scalar temp = cv::sum(dE) / cv::sum(weight_map);
-  deltae = static_cast<double>(temp.val[0]);
+}  // namespace
 
-  return deltae;
+double DeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
+              const cv::Mat& weights, cv::Mat& dE, int standard,
+              std::string application) {
+  return MeanDeltaE(src1, src2, max_value, &weights, &dE, standard,
+                    application);
 }
 
 double DeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
               const cv::Mat& weights, int standard, std::string application) {
-  cv::Mat dE;
-
-  cv::Mat weight_map;
-  weights.convertTo(weight_map, CV_32F);
-
-  return DeltaE(src1, src2, max_value, weight_map, dE, standard, application);
+  return MeanDeltaE(src1, src2, max_value, &weights, nullptr, standard,
+                    application);
 }
 
 double DeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
               cv::Mat& dE, int standard, std::string application) {
-  cv::Mat weights;
-  weights.create(src1.rows, src1.cols, CV_32FC1);
-  weights.setTo(cv::Scalar(1));
-
-  return DeltaE(src1, src2, max_value, weights, dE, standard, application);
+  return MeanDeltaE(src1, src2, max_value, nullptr, &dE, standard,
+                    application);
 }
 
 double DeltaE(const cv::Mat& src1, const cv::Mat& src2, int max_value,
               int standard, std::string application) {
-  cv::Mat dE;
-
-  cv::Mat weights;
-  weights.create(src1.rows, src1.cols, CV_32FC1);
-  weights.setTo(cv::Scalar(1));
-
-  return DeltaE(src1, src2, max_value, weights, dE, standard, application);
+  return MeanDeltaE(src1, src2, max_value, nullptr, nullptr, standard,
+                    application);
 }
 }
@@ -16,14 +16,20 @@ namespace ipcv {
 
 /** Compute delta E between the provided source images
  *
- *  \param[in] src1         source cv::Mat of CV_8UC3
- *  \param[in] src2         source cv::Mat of CV_8UC3
+ *  Both sources are converted from (sRGB encoded) BGR to L*a*b* a row at a
+ *  time and the weighted mean accumulated in a single row-parallel pass;
+ *  the delta E map is only produced by the overloads that return it.
+ *
+ *  \param[in] src1         source cv::Mat of any 3-channel CV type
+ *  \param[in] src2         source cv::Mat of any 3-channel CV type
  *  \param[in] max_value    maximum possible value data sources may take on
  *  \param[in] weights      weight map cv::Mat of any single-channel CV type
  *                          Used to weight the metric by location (if not
  *                          provided, all location weights will be set to unity)
  *
  *  \param[out] dE          destination cv::Mat of CV_32FC1 for delta E
+ *                          (multiplied by the weight map when one is
+ *                          provided)
  *
  *  \param[in] standard     Standard to use 1976 | 1994 | 2000
  *                          [default is 1976]
@@ -5,16 +5,47 @@
  *  \date 04 Jan 2019
  */
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
-#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
 
 #include "GrayworldAwb.h"
 
+#include "imgs/ipcv/color_conversion/ColorConversion.h"
+
 using namespace std;
 
 namespace ipcv {
 
+namespace {
+
+// Rows per parallel work item
+const int kBandRows = 32;
+
+/* Convert one 8- or 16-bit BGR source row to L*a*b*
+ */
+void ToLab(const cv::Mat& src, int row, const vector<float>& lut,
+           float* lab) {
+  if (src.depth() == CV_8U) {
+    BgrToLabRow(src.ptr<uint8_t>(row), src.cols, lut, lab);
+  } else {
+    BgrToLabRow(src.ptr<uint16_t>(row), src.cols, lut, lab);
+  }
+}
+
+/* Scale an encoded BGR row in [0, 1] to [0, max_value]
+ */
+template <typename T>
+void Store(const float* bgr, int cols, int max_value, T* dst) {
+  for (int idx = 0; idx < 3 * cols; idx++) {
+    dst[idx] = cv::saturate_cast<T>(bgr[idx] * max_value);
+  }
+}
+
+}  // namespace
+
 cv::Mat GrayworldAwb(const cv::Mat& src, const double scale,
                      const int max_value) {  
   // Be certain that the source image is 3-channel
@@ -31,56 +62,60 @@ cv::Mat GrayworldAwb(const cv::Mat& src, const double scale,
     exit(EXIT_FAILURE);
   }
 
-  // Scale the input image to the range [0,1] and convert to a 32-bit
-  // floating point type to be compatible with the OpenCV color conversion
-  // routine
-  cv::Mat src_normalized;
-  src.convertTo(src_normalized, CV_32F, 1.0 / static_cast<float>(max_value));
-
-  // Convert the BGR image to L*a*b*
-  cv::Mat lab;
-  cv::cvtColor(src_normalized, lab, cv::COLOR_BGR2Lab);
-
-  // Split the L*a*b* channels
-  cv::Mat channels[3];
-  cv::split(lab, channels);
-
-  // Compute the average a* and b* values
-  cv::Scalar temp;
-  temp = mean(channels[1]);
-  float average_a = static_cast<float>(temp.val[0]);
-  temp = mean(channels[2]);
-  float average_b = static_cast<float>(temp.val[0]);
-
-  // Compute the luminance-scaled shift values to force the average
-  // a* and b* values to be 0 (neutral)
-  cv::Mat delta_a = average_a * (channels[0] / 100.0) * scale;
-  cv::Mat delta_b = average_b * (channels[0] / 100.0) * scale;
-
-  // Shift the a* and b* values to the neutral position
-  cv::Mat balanced_a = channels[1] - delta_a;
-  cv::Mat balanced_b = channels[2] - delta_b;
-
-  // Replace the original a* and b* values with their nuetral shifted
-  // equivalents
-  channels[1] = balanced_a;
-  channels[2] = balanced_b;
-
-  // Merge the modified L*a*b* channels
-  cv::merge(channels, 3, lab);
-
-  // Convert the balanced L*a*b* values back to BGR, this represents the
-  // automatically white balanced image
-  cv::Mat balanced;
-  cv::cvtColor(lab, balanced, cv::COLOR_Lab2BGR);
-
-  // Scale the balanced image back to the original dynamic range [0,max_value]
-  balanced *= max_value;
-
-  // Return the balanced image using the same data type as the original
-  // input image
-  cv::Mat dst;
-  balanced.convertTo(dst, src.type());
+  // Source values are linearized through a table indexed by the raw value
+  vector<float> lut = LinearizationLut(depth, max_value);
+
+  // Compute the average a* and b* values, converting a row at a time (the
+  // sums are kept per band so the result does not depend on the thread
+  // count)
+  int bands = (src.rows + kBandRows - 1) / kBandRows;
+  vector<double> sum_a(bands, 0);
+  vector<double> sum_b(bands, 0);
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> lab(3 * src.cols);
+    for (int band = range.start; band < range.end; band++) {
+      int end = min((band + 1) * kBandRows, src.rows);
+      for (int r = band * kBandRows; r < end; r++) {
+        ToLab(src, r, lut, lab.data());
+        for (int c = 0; c < src.cols; c++) {
+          sum_a[band] += lab[3 * c + 1];
+          sum_b[band] += lab[3 * c + 2];
+        }
+      }
+    }
+  });
+  double total_a = 0;
+  double total_b = 0;
+  for (int band = 0; band < bands; band++) {
+    total_a += sum_a[band];
+    total_b += sum_b[band];
+  }
+  float average_a = static_cast<float>(total_a / src.total());
+  float average_b = static_cast<float>(total_b / src.total());
+
+  // Shift the a* and b* values toward the neutral position by the
+  // luminance-scaled averages, then convert the balanced L*a*b* values back
+  // to BGR in the original dynamic range [0,max_value] and data type
+  float shift_a = static_cast<float>(average_a * scale / 100.0);
+  float shift_b = static_cast<float>(average_b * scale / 100.0);
+  cv::Mat dst(src.size(), src.type());
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    vector<float> lab(3 * src.cols);
+    int end = min(range.end * kBandRows, src.rows);
+    for (int r = range.start * kBandRows; r < end; r++) {
+      ToLab(src, r, lut, lab.data());
+      for (int c = 0; c < src.cols; c++) {
+        lab[3 * c + 1] -= shift_a * lab[3 * c];
+        lab[3 * c + 2] -= shift_b * lab[3 * c];
+      }
+      LabToBgrRow(lab.data(), src.cols, lab.data());
+      if (depth == CV_8U) {
+        Store(lab.data(), src.cols, max_value, dst.ptr<uint8_t>(r));
+      } else {
+        Store(lab.data(), src.cols, max_value, dst.ptr<uint16_t>(r));
+      }
+    }
+  });
 
   return dst;
 }
@@ -0,0 +1,339 @@
+/** Implementation file for computing image quality metrics between images
+ *
+ *  \file imgs/ipcv/utils/ImageMetrics.cpp
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "imgs/ipcv/utils/ImageMetrics.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+// Rows per parallel work item (sums are kept per band so the result does
+// not depend on the thread count)
+const int kBandRows = 32;
+
+// SSIM window extent [pixels]
+const int kSsimWindow = 7;
+
+/* Accumulators of one band for one candidate
+ */
+struct BandSums {
+  double sse[4] = {0, 0, 0, 0};
+  double ssim[4] = {0, 0, 0, 0};
+};
+
+/* Squared errors of 8- and 16-bit data are summed exactly in 64-bit
+ * integers, everything else in double precision
+ */
+template <typename T>
+using Accumulator =
+    typename conditional<is_integral<T>::value && (sizeof(T) <= 2), int64_t,
+                         double>::type;
+
+template <typename T, int CN>
+void SquaredErrorRow(const T* x, const T* y, int cols, double* sse) {
+  Accumulator<T> acc[CN] = {};
+  for (int c = 0; c < cols; c++) {
+    for (int k = 0; k < CN; k++) {
+      Accumulator<T> d = static_cast<Accumulator<T>>(x[CN * c + k]) -
+                         static_cast<Accumulator<T>>(y[CN * c + k]);
+      acc[k] += d * d;
+    }
+  }
+  for (int k = 0; k < CN; k++) {
+    sse[k] += static_cast<double>(acc[k]);
+  }
+}
+
+template <typename T, int CN>
+void WeightedSquaredErrorRow(const T* x, const T* y, const float* w, int cols,
+                             double* sse) {
+  double acc[CN] = {};
+  for (int c = 0; c < cols; c++) {
+    double weight = w[c];
+    for (int k = 0; k < CN; k++) {
+      double d = static_cast<double>(x[CN * c + k]) - y[CN * c + k];
+      acc[k] += weight * d * d;
+    }
+  }
+  for (int k = 0; k < CN; k++) {
+    sse[k] += acc[k];
+  }
+}
+
+/* Add (sign = 1) or remove (sign = -1) one row from the SSIM column sums
+ */
+template <typename T, int CN>
+void UpdateColumnSums(const T* x, const T* y, int n, double sign,
+                      double* sums) {
+  double* sx = sums;
+  double* sy = sums + n;
+  double* sxx = sums + 2 * n;
+  double* syy = sums + 3 * n;
+  double* sxy = sums + 4 * n;
+  for (int idx = 0; idx < n; idx++) {
+    double a = x[idx];
+    double b = y[idx];
+    sx[idx] += sign * a;
+    sy[idx] += sign * b;
+    sxx[idx] += sign * a * a;
+    syy[idx] += sign * b * b;
+    sxy[idx] += sign * a * b;
+  }
+}
+
+/* Sum of SSIM over the windows whose top rows are in [t0, t1)
+ */
+template <typename T, int CN>
+void SsimBand(const cv::Mat& x, const cv::Mat& y, int t0, int t1, double c1,
+              double c2, vector<double>& buffer, double* ssim) {
+  int n = CN * x.cols;
+  buffer.assign(5 * n, 0);
+  double* sums = buffer.data();
+  for (int r = t0; r < t0 + kSsimWindow; r++) {
+    UpdateColumnSums<T, CN>(x.ptr<T>(r), y.ptr<T>(r), n, 1, sums);
+  }
+
+  const double count = kSsimWindow * kSsimWindow;
+  for (int t = t0; t < t1; t++) {
+    for (int k = 0; k < CN; k++) {
+      // Horizontal running sums over the column sums of this channel
+      double s[5] = {0, 0, 0, 0, 0};
+      for (int c = 0; c < kSsimWindow; c++) {
+        for (int stat = 0; stat < 5; stat++) {
+          s[stat] += sums[stat * n + CN * c + k];
+        }
+      }
+      double total = 0;
+      for (int left = 0; left + kSsimWindow <= x.cols; left++) {
+        double mx = s[0] / count;
+        double my = s[1] / count;
+        double vx = s[2] / count - mx * mx;
+        double vy = s[3] / count - my * my;
+        double cxy = s[4] / count - mx * my;
+        total += ((2 * mx * my + c1) * (2 * cxy + c2)) /
+                 ((mx * mx + my * my + c1) * (vx + vy + c2));
+
+        int right = left + kSsimWindow;
+        if (right < x.cols) {
+          for (int stat = 0; stat < 5; stat++) {
+            s[stat] += sums[stat * n + CN * right + k] -
+                       sums[stat * n + CN * left + k];
+          }
+        }
+      }
+      ssim[k] += total;
+    }
+
+    // Slide the column sums down one row
+    if (t + 1 < t1) {
+      UpdateColumnSums<T, CN>(x.ptr<T>(t), y.ptr<T>(t), n, -1, sums);
+      UpdateColumnSums<T, CN>(x.ptr<T>(t + kSsimWindow),
+                              y.ptr<T>(t + kSsimWindow), n, 1, sums);
+    }
+  }
+}
+
+/* Accumulate one band of rows [r0, r1) for one candidate, band_weights
+ * holds the CV_32F weights of the band (empty if unweighted)
+ */
+template <typename T, int CN>
+void AccumulateBand(const cv::Mat& x, const cv::Mat& y,
+                    const cv::Mat& band_weights, int r0, int r1, bool ssim,
+                    double c1, double c2, vector<double>& buffer,
+                    BandSums& sums) {
+  for (int r = r0; r < r1; r++) {
+    if (band_weights.empty()) {
+      SquaredErrorRow<T, CN>(x.ptr<T>(r), y.ptr<T>(r), x.cols, sums.sse);
+    } else {
+      WeightedSquaredErrorRow<T, CN>(x.ptr<T>(r), y.ptr<T>(r),
+                                     band_weights.ptr<float>(r - r0), x.cols,
+                                     sums.sse);
+    }
+  }
+
+  if (ssim) {
+    int t1 = min(r1, x.rows - kSsimWindow + 1);
+    if (r0 < t1) {
+      SsimBand<T, CN>(x, y, r0, t1, c1, c2, buffer, sums.ssim);
+    }
+  }
+}
+
+using BandFunction = void (*)(const cv::Mat&, const cv::Mat&, const cv::Mat&,
+                              int, int, bool, double, double, vector<double>&,
+                              BandSums&);
+
+template <typename T>
+BandFunction SelectChannels(int channels) {
+  switch (channels) {
+    case 1:
+      return AccumulateBand<T, 1>;
+    case 2:
+      return AccumulateBand<T, 2>;
+    case 3:
+      return AccumulateBand<T, 3>;
+    default:
+      return AccumulateBand<T, 4>;
+  }
+}
+
+BandFunction Select(int depth, int channels) {
+  switch (depth) {
+    case CV_8U:
+      return SelectChannels<uint8_t>(channels);
+    case CV_8S:
+      return SelectChannels<int8_t>(channels);
+    case CV_16U:
+      return SelectChannels<uint16_t>(channels);
+    case CV_16S:
+      return SelectChannels<int16_t>(channels);
+    case CV_32S:
+      return SelectChannels<int32_t>(channels);
+    case CV_32F:
+      return SelectChannels<float>(channels);
+    default:
+      return SelectChannels<double>(channels);
+  }
+}
+
+vector<ImageMetrics> Accumulate(const cv::Mat& reference,
+                                const vector<const cv::Mat*>& candidates,
+                                const cv::Mat& weights, bool ssim,
+                                int max_value) {
+  for (auto candidate : candidates) {
+    if ((candidate->rows != reference.rows) ||
+        (candidate->cols != reference.cols) ||
+        (candidate->type() != reference.type())) {
+      cerr << "Dimensions and types of source images must match exactly for "
+              "image metric computation"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  int channels = reference.channels();
+  if (channels > 4) {
+    cerr << "Source images must have 1 to 4 channels for image metric "
+            "computation"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (!weights.empty()) {
+    if ((weights.rows != reference.rows) || (weights.cols != reference.cols)) {
+      cerr << "Area dimensions of weight map and source images must match "
+              "exactly for image metric computation"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (weights.channels() > 1) {
+      cerr << "Weight map must be single channel for image metric computation"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if (ssim &&
+      ((reference.rows < kSsimWindow) || (reference.cols < kSsimWindow))) {
+    cerr << "Source images must be at least " << kSsimWindow << " x "
+         << kSsimWindow << " for SSIM computation" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  BandFunction accumulate = Select(reference.depth(), channels);
+  double c1 = (0.01 * max_value) * (0.01 * max_value);
+  double c2 = (0.03 * max_value) * (0.03 * max_value);
+
+  size_t n = candidates.size();
+  int bands = (reference.rows + kBandRows - 1) / kBandRows;
+  vector<BandSums> sums(bands * n);
+  vector<double> weight_sums(bands, 0);
+
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    cv::Mat band_weights;
+    vector<double> buffer;
+    for (int band = range.start; band < range.end; band++) {
+      int r0 = band * kBandRows;
+      int r1 = min(r0 + kBandRows, reference.rows);
+
+      // The band's weights are converted once and shared by every candidate
+      if (weights.empty()) {
+        weight_sums[band] = static_cast<double>(r1 - r0) * reference.cols;
+      } else {
+        weights.rowRange(r0, r1).convertTo(band_weights, CV_32F);
+        double weight_sum = 0;
+        for (int r = 0; r < r1 - r0; r++) {
+          const float* w = band_weights.ptr<float>(r);
+          for (int c = 0; c < reference.cols; c++) {
+            weight_sum += w[c];
+          }
+        }
+        weight_sums[band] = weight_sum;
+      }
+
+      for (size_t idx = 0; idx < n; idx++) {
+        accumulate(reference, *candidates[idx], band_weights, r0, r1, ssim,
+                   c1, c2, buffer, sums[band * n + idx]);
+      }
+    }
+  });
+
+  double weight_sum = 0;
+  for (int band = 0; band < bands; band++) {
+    weight_sum += weight_sums[band];
+  }
+  double windows = static_cast<double>(reference.rows - kSsimWindow + 1) *
+                   (reference.cols - kSsimWindow + 1);
+
+  vector<ImageMetrics> metrics(n);
+  for (size_t idx = 0; idx < n; idx++) {
+    metrics[idx].channel_sse.assign(channels, 0);
+    metrics[idx].weight_sum = weight_sum;
+    if (ssim) {
+      metrics[idx].channel_ssim.assign(channels, 0);
+    }
+    for (int band = 0; band < bands; band++) {
+      const BandSums& band_sums = sums[band * n + idx];
+      for (int k = 0; k < channels; k++) {
+        metrics[idx].channel_sse[k] += band_sums.sse[k];
+        if (ssim) {
+          metrics[idx].channel_ssim[k] += band_sums.ssim[k] / windows;
+        }
+      }
+    }
+  }
+
+  return metrics;
+}
+
+}  // namespace
+
+ImageMetrics ComputeImageMetrics(const cv::Mat& src1, const cv::Mat& src2,
+                                 const cv::Mat& weights, bool ssim,
+                                 int max_value) {
+  return Accumulate(src1, {&src2}, weights, ssim, max_value)[0];
+}
+
+vector<ImageMetrics> ComputeImageMetrics(const cv::Mat& reference,
+                                         const vector<cv::Mat>& candidates,
+                                         const cv::Mat& weights, bool ssim,
+                                         int max_value) {
+  vector<const cv::Mat*> pointers;
+  for (const auto& candidate : candidates) {
+    pointers.push_back(&candidate);
+  }
+  return Accumulate(reference, pointers, weights, ssim, max_value);
+}
+}
@@ -0,0 +1,99 @@
+/** Interface file for computing image quality metrics between images
+ *
+ *  \file imgs/ipcv/utils/ImageMetrics.h
+ *
+ *  \description
+ *    A fused kernel that reads the compared images once per row band and
+ *    accumulates the per-channel (weighted) sum of squared errors, and
+ *    optionally the mean structural similarity (SSIM), without any
+ *    full-size temporaries.  Unweighted integer errors are accumulated
+ *    exactly in 64-bit integers, weighted errors in double precision.
+ *
+ *    SSIM uses a 7 x 7 uniform window evaluated at every position where the
+ *    window lies entirely within the image (from running window sums), with
+ *    the usual constants C1 = (0.01 L)^2 and C2 = (0.03 L)^2 for a dynamic
+ *    range L of max_value.  The weight map only applies to the squared
+ *    errors.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Accumulated image quality statistics for one pair of images
+ */
+struct ImageMetrics {
+  /* Weighted sum of squared errors for each channel */
+  std::vector<double> channel_sse;
+
+  /* Sum of the weights (the number of pixels if unweighted) */
+  double weight_sum = 0;
+
+  /* Mean SSIM for each channel (empty if not requested) */
+  std::vector<double> channel_ssim;
+
+  /* Mean weighted squared error for a channel */
+  double channel_mse(int channel) const {
+    return channel_sse[channel] / weight_sum;
+  }
+
+  /* Mean weighted squared error over all channels */
+  double mse() const {
+    double sse = 0;
+    for (auto value : channel_sse) {
+      sse += value;
+    }
+    return sse / weight_sum / channel_sse.size();
+  }
+
+  /* Mean SSIM over all channels */
+  double ssim() const {
+    double sum = 0;
+    for (auto value : channel_ssim) {
+      sum += value;
+    }
+    return sum / channel_ssim.size();
+  }
+};
+
+/** Compute image quality statistics between the provided source images
+ *
+ *  \param[in] src1        source cv::Mat of CV_8U, CV_16U, CV_16S, CV_32S,
+ *                         CV_32F, or CV_64F with 1 to 4 channels
+ *  \param[in] src2        source cv::Mat of the same type and size as src1
+ *  \param[in] weights     weight map cv::Mat of any single-channel CV type
+ *                         Used to weight the squared errors by location (if
+ *                         empty, all location weights are unity and no map
+ *                         is built) [default is empty]
+ *  \param[in] ssim        compute the mean SSIM [default is false]
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         (the SSIM dynamic range) [default is 255]
+ *
+ *  \return                accumulated statistics
+ */
+ImageMetrics ComputeImageMetrics(const cv::Mat& src1, const cv::Mat& src2,
+                                 const cv::Mat& weights = cv::Mat(),
+                                 bool ssim = false, int max_value = 255);
+
+/** Compute image quality statistics between a reference and each of many
+ *  candidate images in one pass (each reference row is read while it is
+ *  still in cache for every candidate)
+ *
+ *  \param[in] reference   reference cv::Mat (see ComputeImageMetrics)
+ *  \param[in] candidates  candidate cv::Mats of the reference type and size
+ *  \param[in] weights     weight map as for ComputeImageMetrics
+ *  \param[in] ssim        compute the mean SSIM [default is false]
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         [default is 255]
+ *
+ *  \return                accumulated statistics for each candidate
+ */
+std::vector<ImageMetrics> ComputeImageMetrics(
+    const cv::Mat& reference, const std::vector<cv::Mat>& candidates,
+    const cv::Mat& weights = cv::Mat(), bool ssim = false,
+    int max_value = 255);
+}
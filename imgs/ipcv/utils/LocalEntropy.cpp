@@ -0,0 +1,147 @@
+/** Implementation file for computing the local entropy of an image
+ *
+ *  \file ipcv/utils/LocalEntropy.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "LocalEntropy.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+inline int Bin(uint8_t value) { return value; }
+
+inline int Bin(float value) {
+  // NaN fails every comparison, so it is binned with the negative values
+  if (!(value >= 0)) {
+    return 0;
+  }
+  return static_cast<int>(min(value, 255.0f));
+}
+
+/* Entropy over the column span of each row (spans[r] for row r, clipped to
+ * the image, empty spans are skipped), the n log2(n) table and the
+ * per-thread scratch are set up once for every row
+ */
+template <typename T>
+void SlidingEntropy(const cv::Mat& src, cv::Mat& dst, const int radius,
+                    const vector<cv::Range>& spans) {
+  int n = (2 * radius + 1) * (2 * radius + 1);
+
+  // n log2(n) for every possible count in the neighborhood
+  vector<double> nlog2n(n + 1);
+  nlog2n[0] = 0;
+  for (int count = 1; count <= n; count++) {
+    nlog2n[count] = count * log2(static_cast<double>(count));
+  }
+  double log2n = log2(static_cast<double>(n));
+
+  cv::parallel_for_(
+      cv::Range(0, src.rows), [&](const cv::Range& range) {
+        vector<int> histogram(256);
+        vector<const T*> rows(2 * radius + 1);
+        auto clamp_col = [&](int c) { return min(max(c, 0), src.cols - 1); };
+
+        for (int r = range.start; r < range.end; r++) {
+          cv::Range span(max(spans[r].start, 0),
+                         min(spans[r].end, src.cols));
+          if (span.end <= span.start) {
+            continue;
+          }
+          for (int dr = -radius; dr <= radius; dr++) {
+            rows[dr + radius] = src.ptr<T>(min(max(r + dr, 0), src.rows - 1));
+          }
+
+          std::fill(histogram.begin(), histogram.end(), 0);
+          double sum = 0;
+          auto add = [&](int bin) {
+            sum += nlog2n[histogram[bin] + 1] - nlog2n[histogram[bin]];
+            histogram[bin]++;
+          };
+          auto remove = [&](int bin) {
+            sum += nlog2n[histogram[bin] - 1] - nlog2n[histogram[bin]];
+            histogram[bin]--;
+          };
+
+          // Fill the neighborhood of the first pixel in the span
+          int c = span.start;
+          for (int dc = -radius; dc <= radius; dc++) {
+            int cc = clamp_col(c + dc);
+            for (const T* row : rows) {
+              add(Bin(row[cc]));
+            }
+          }
+
+          float* entropy = dst.ptr<float>(r);
+          entropy[c] = static_cast<float>(log2n - sum / n);
+
+          // Slide across the span one column at a time
+          for (c = span.start + 1; c < span.end; c++) {
+            int leaving = clamp_col(c - radius - 1);
+            int entering = clamp_col(c + radius);
+            for (const T* row : rows) {
+              remove(Bin(row[leaving]));
+              add(Bin(row[entering]));
+            }
+            entropy[c] = static_cast<float>(log2n - sum / n);
+          }
+        }
+      });
+}
+
+}  // namespace
+
+cv::Mat LocalEntropy(const cv::Mat& src, const int radius) {
+  cv::Mat dst(src.size(), CV_32FC1);
+  LocalEntropy(src, dst, radius, cv::Rect(0, 0, src.cols, src.rows));
+  return dst;
+}
+
+void LocalEntropy(const cv::Mat& src, cv::Mat& dst, const int radius,
+                  const cv::Rect& roi) {
+  vector<cv::Range> spans(src.rows, cv::Range(0, 0));
+  if ((roi.width > 0) && (roi.height > 0)) {
+    for (int r = max(roi.y, 0); r < min(roi.y + roi.height, src.rows); r++) {
+      spans[r] = cv::Range(roi.x, roi.x + roi.width);
+    }
+  }
+  LocalEntropy(src, dst, radius, spans);
+}
+
+void LocalEntropy(const cv::Mat& src, cv::Mat& dst, const int radius,
+                  const vector<cv::Range>& spans) {
+  if (radius < 0) {
+    cerr << "Local entropy radius must be non-negative" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (spans.size() != static_cast<size_t>(src.rows)) {
+    cerr << "Local entropy needs one column span per source row" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  dst.create(src.size(), CV_32FC1);
+
+  switch (src.type()) {
+    case CV_8UC1:
+      SlidingEntropy<uint8_t>(src, dst, radius, spans);
+      break;
+
+    case CV_32FC1:
+      SlidingEntropy<float>(src, dst, radius, spans);
+      break;
+
+    default:
+      cerr << "Source image must be of type CV_8UC1 or CV_32FC1 for local "
+              "entropy computation"
+           << endl;
+      exit(EXIT_FAILURE);
+  }
+}
+}  // namespace ipcv
@@ -0,0 +1,61 @@
+/** Interface file for computing the local entropy of an image
+ *
+ *  \file ipcv/utils/LocalEntropy.h
+ *
+ *  \description
+ *    The entropy of the grey-level histogram in a (2 * radius + 1) square
+ *    neighborhood about every pixel.  Each row is processed with a sliding
+ *    histogram, so moving one column only removes the leaving column and
+ *    adds the entering column, and the sum of n log2(n) terms is updated
+ *    incrementally from a precomputed table:
+ *
+ *      H = log2(N) - (1 / N) sum_i n_i log2(n_i)
+ *
+ *    Neighborhoods are clamped (replicated) at the image boundary.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Compute the local entropy of the source image
+ *
+ *  \param[in] src      source cv::Mat of CV_8UC1 or CV_32FC1 (floating
+ *                      point values are truncated to bins in [0, 255])
+ *  \param[in] radius   neighborhood radius [default is 4, i.e. 9x9]
+ *
+ *  \return             destination cv::Mat of CV_32FC1 containing the
+ *                      local entropy [bits]
+ */
+cv::Mat LocalEntropy(const cv::Mat& src, const int radius = 4);
+
+/** Compute the local entropy of the source image over a region of interest
+ *
+ *  \param[in] src      source cv::Mat of CV_8UC1 or CV_32FC1
+ *  \param[out] dst     destination cv::Mat of CV_32FC1 the same size as the
+ *                      source, only the region of interest is written
+ *  \param[in] radius   neighborhood radius
+ *  \param[in] roi      region of the destination to compute (clipped to the
+ *                      image)
+ */
+void LocalEntropy(const cv::Mat& src, cv::Mat& dst, const int radius,
+                  const cv::Rect& roi);
+
+/** Compute the local entropy of the source image over a column span of
+ *  each row (in a single parallel pass, as needed when the spans differ
+ *  from row to row)
+ *
+ *  \param[in] src      source cv::Mat of CV_8UC1 or CV_32FC1
+ *  \param[out] dst     destination cv::Mat of CV_32FC1 the same size as the
+ *                      source, only the spans are written
+ *  \param[in] radius   neighborhood radius
+ *  \param[in] spans    columns to compute in each source row (one per row,
+ *                      clipped to the image, empty ranges are skipped)
+ */
+void LocalEntropy(const cv::Mat& src, cv::Mat& dst, const int radius,
+                  const std::vector<cv::Range>& spans);
+}
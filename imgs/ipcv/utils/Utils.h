@@ -20,5 +20,8 @@
 #include "imgs/ipcv/utils/Histogram.h"
 #include "imgs/ipcv/utils/HistogramToPdf.h"
 #include "imgs/ipcv/utils/HistogramToCdf.h"
+#include "imgs/ipcv/utils/ImageMetrics.h"
+#include "imgs/ipcv/utils/LocalEntropy.h"
 #include "imgs/ipcv/utils/Psnr.h"
 #include "imgs/ipcv/utils/Rmse.h"
+#include "imgs/ipcv/utils/WhiteBalance.h"
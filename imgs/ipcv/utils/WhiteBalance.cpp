@@ -0,0 +1,267 @@
+/** Implementation file for two-pass automatic white balance
+ *
+ *  \file imgs/ipcv/utils/WhiteBalance.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "imgs/ipcv/utils/WhiteBalance.h"
+
+#include "imgs/ipcv/color_conversion/ColorConversion.h"
+
+using namespace std;
+
+namespace ipcv {
+
+namespace {
+
+// Rows per parallel work item (sums are kept per band so the result does
+// not depend on the thread count)
+const int kBandRows = 32;
+
+/* Per-channel statistics of one band
+ */
+struct BandStatistics {
+  double sum[3] = {0, 0, 0};
+  float max[3] = {0, 0, 0};
+  double count = 0;
+};
+
+/* Confirm the source type and resolve the default maximum value
+ */
+int Validate(const cv::Mat& src, int max_value) {
+  if ((src.type() != CV_8UC3) && (src.type() != CV_16UC3)) {
+    cerr << "Source image must be of type CV_8UC3 or CV_16UC3 for white "
+            "balancing"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (max_value < 0) {
+    max_value = (src.depth() == CV_8U) ? 255 : 65535;
+  }
+  return max_value;
+}
+
+/* Table from every raw value of the source type to its linear value
+ */
+vector<float> Linearization(int depth, int max_value, bool srgb) {
+  if (srgb) {
+    return LinearizationLut(depth, max_value);
+  }
+  vector<float> lut((depth == CV_8U) ? 256 : 65536);
+  for (size_t idx = 0; idx < lut.size(); idx++) {
+    lut[idx] = min(static_cast<float>(idx) / max_value, 1.0f);
+  }
+  return lut;
+}
+
+/* Exact linear to encoded value (the gain tables are built once, so the
+ * interpolated encoding table is not needed)
+ */
+double Encode(double v, bool srgb) {
+  v = min(max(v, 0.0), 1.0);
+  if (!srgb) {
+    return v;
+  }
+  return (v <= 0.0031308) ? 12.92 * v : 1.055 * pow(v, 1 / 2.4) - 0.055;
+}
+
+template <typename T>
+void AccumulateRow(const T* src, int cols, int stride,
+                   const vector<float>& lut, AwbMethod method,
+                   BandStatistics& statistics) {
+  for (int c = 0; c < cols; c += stride) {
+    for (int k = 0; k < 3; k++) {
+      float v = lut[src[3 * c + k]];
+      if (method == AwbMethod::white_patch) {
+        statistics.max[k] = max(statistics.max[k], v);
+      } else {
+        statistics.sum[k] += v;
+      }
+    }
+  }
+  statistics.count += (cols + stride - 1) / stride;
+}
+
+template <typename T>
+void GainRow(const T* src, int cols, const vector<T>& lut, T* dst) {
+  const T* lut_b = lut.data();
+  const T* lut_g = lut_b + lut.size() / 3;
+  const T* lut_r = lut_g + lut.size() / 3;
+  for (int c = 0; c < cols; c++) {
+    dst[3 * c] = lut_b[src[3 * c]];
+    dst[3 * c + 1] = lut_g[src[3 * c + 1]];
+    dst[3 * c + 2] = lut_r[src[3 * c + 2]];
+  }
+}
+
+template <typename T>
+void ApplyGains(const cv::Mat& src, const cv::Vec3d& gains, int max_value,
+                bool srgb, cv::Mat& dst) {
+  // One table per channel taking the raw value straight to the balanced
+  // raw value
+  vector<float> linear = Linearization(src.depth(), max_value, srgb);
+  size_t size = linear.size();
+  vector<T> lut(3 * size);
+  for (int k = 0; k < 3; k++) {
+    for (size_t idx = 0; idx < size; idx++) {
+      double v = Encode(linear[idx] * gains[k], srgb);
+      lut[k * size + idx] = cv::saturate_cast<T>(v * max_value);
+    }
+  }
+
+  cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      GainRow(src.ptr<T>(r), src.cols, lut, dst.ptr<T>(r));
+    }
+  });
+}
+
+template <typename T>
+void ApplyMatrix(const cv::Mat& src, const cv::Matx33f& m, int max_value,
+                 bool srgb, cv::Mat& dst) {
+  vector<float> linear = Linearization(src.depth(), max_value, srgb);
+
+  cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+    vector<float> buffer(3 * src.cols);
+    for (int r = range.start; r < range.end; r++) {
+      const T* p = src.ptr<T>(r);
+      for (int idx = 0; idx < 3 * src.cols; idx++) {
+        buffer[idx] = linear[p[idx]];
+      }
+      Transform3x3Row(buffer.data(), src.cols, m, buffer.data());
+      T* q = dst.ptr<T>(r);
+      for (int idx = 0; idx < 3 * src.cols; idx++) {
+        float v = min(max(buffer[idx], 0.0f), 1.0f);
+        v = srgb ? LinearToSrgb(v) : v;
+        q[idx] = cv::saturate_cast<T>(v * max_value);
+      }
+    }
+  });
+}
+
+}  // namespace
+
+AwbMethod ParseAwbMethod(const string& name) {
+  if (name == "gray_world") {
+    return AwbMethod::gray_world;
+  } else if (name == "white_patch") {
+    return AwbMethod::white_patch;
+  } else if (name == "shades_of_gray") {
+    return AwbMethod::shades_of_gray;
+  }
+  cerr << "Invalid white balance method provided: " << name << endl;
+  exit(EXIT_FAILURE);
+}
+
+cv::Vec3d AwbGains(const cv::Mat& src, AwbMethod method, double p,
+                   int stride, int max_value, bool srgb) {
+  max_value = Validate(src, max_value);
+  if (stride < 1) {
+    cerr << "White balance statistics stride must be positive" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if ((method == AwbMethod::shades_of_gray) && (p <= 0)) {
+    cerr << "Shades of gray norm must be positive" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Shades of gray sums v^p, which is folded into the table
+  vector<float> lut = Linearization(src.depth(), max_value, srgb);
+  if (method == AwbMethod::shades_of_gray) {
+    for (auto& v : lut) {
+      v = static_cast<float>(pow(v, p));
+    }
+  }
+
+  // Parallel reduction over the rows of the strided proxy
+  int rows = (src.rows + stride - 1) / stride;
+  int bands = (rows + kBandRows - 1) / kBandRows;
+  vector<BandStatistics> statistics(bands);
+  cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+    for (int band = range.start; band < range.end; band++) {
+      int end = min((band + 1) * kBandRows, rows);
+      for (int r = band * kBandRows; r < end; r++) {
+        if (src.depth() == CV_8U) {
+          AccumulateRow(src.ptr<uint8_t>(r * stride), src.cols, stride, lut,
+                        method, statistics[band]);
+        } else {
+          AccumulateRow(src.ptr<uint16_t>(r * stride), src.cols, stride, lut,
+                        method, statistics[band]);
+        }
+      }
+    }
+  });
+
+  double sum[3] = {0, 0, 0};
+  double maximum[3] = {0, 0, 0};
+  double count = 0;
+  for (const auto& band : statistics) {
+    for (int k = 0; k < 3; k++) {
+      sum[k] += band.sum[k];
+      maximum[k] = max(maximum[k], static_cast<double>(band.max[k]));
+    }
+    count += band.count;
+  }
+
+  // Illuminant estimate of each channel
+  double estimate[3];
+  for (int k = 0; k < 3; k++) {
+    switch (method) {
+      case AwbMethod::gray_world:
+        estimate[k] = sum[k] / count;
+        break;
+      case AwbMethod::white_patch:
+        estimate[k] = maximum[k];
+        break;
+      case AwbMethod::shades_of_gray:
+        estimate[k] = pow(sum[k] / count, 1 / p);
+        break;
+    }
+  }
+
+  cv::Vec3d gains;
+  for (int k = 0; k < 3; k++) {
+    gains[k] = (estimate[k] > 0) ? estimate[1] / estimate[k] : 1.0;
+  }
+  return gains;
+}
+
+cv::Mat ApplyAwbGains(const cv::Mat& src, const cv::Vec3d& gains,
+                      int max_value, bool srgb) {
+  max_value = Validate(src, max_value);
+
+  cv::Mat dst(src.size(), src.type());
+  if (src.depth() == CV_8U) {
+    ApplyGains<uint8_t>(src, gains, max_value, srgb, dst);
+  } else {
+    ApplyGains<uint16_t>(src, gains, max_value, srgb, dst);
+  }
+  return dst;
+}
+
+cv::Mat ApplyColorMatrix(const cv::Mat& src, const cv::Matx33d& m,
+                         int max_value, bool srgb) {
+  max_value = Validate(src, max_value);
+
+  cv::Mat dst(src.size(), src.type());
+  if (src.depth() == CV_8U) {
+    ApplyMatrix<uint8_t>(src, cv::Matx33f(m), max_value, srgb, dst);
+  } else {
+    ApplyMatrix<uint16_t>(src, cv::Matx33f(m), max_value, srgb, dst);
+  }
+  return dst;
+}
+
+cv::Mat WhiteBalance(const cv::Mat& src, AwbMethod method, double p,
+                     int stride, int max_value, bool srgb) {
+  cv::Vec3d gains = AwbGains(src, method, p, stride, max_value, srgb);
+  return ApplyAwbGains(src, gains, max_value, srgb);
+}
+}
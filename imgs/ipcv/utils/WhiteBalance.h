@@ -0,0 +1,104 @@
+/** Interface file for two-pass automatic white balance
+ *
+ *  \file imgs/ipcv/utils/WhiteBalance.h
+ *
+ *  \description
+ *    Illuminant estimation from per-channel statistics of the linear
+ *    (sRGB decoded) image, gathered in a parallel reduction over a strided
+ *    proxy of the source, followed by a single pass that applies either
+ *    per-channel gains (a table lookup per sample for 8- and 16-bit data)
+ *    or a 3x3 matrix in linear RGB.  No full-size temporaries are built.
+ *
+ *    The illuminant estimates are
+ *      gray world       the mean of each channel
+ *      white patch      the maximum of each channel
+ *      shades of gray   the p-norm mean (mean(v^p))^(1/p) of each channel
+ *    and the gains scale each channel's estimate to that of green.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace ipcv {
+
+/** Illuminant estimation method
+ */
+enum class AwbMethod { gray_world, white_patch, shades_of_gray };
+
+/** Parse an illuminant estimation method name
+ *
+ *  \param[in] name   gray_world, white_patch, or shades_of_gray
+ *
+ *  \return           method
+ */
+AwbMethod ParseAwbMethod(const std::string& name);
+
+/** Estimate white balance gains for the source image
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC3 or CV_16UC3
+ *  \param[in] method      illuminant estimation method [default is gray
+ *                         world]
+ *  \param[in] p           shades of gray norm (ignored otherwise)
+ *                         [default is 6]
+ *  \param[in] stride      statistics are taken from every stride-th row and
+ *                         column [default is 1]
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         [default (-1) is the maximum of the data type]
+ *  \param[in] srgb        source is sRGB encoded (false for linear data)
+ *                         [default is true]
+ *
+ *  \return                BGR gains (the green gain is 1)
+ */
+cv::Vec3d AwbGains(const cv::Mat& src,
+                   AwbMethod method = AwbMethod::gray_world, double p = 6.0,
+                   int stride = 1, int max_value = -1, bool srgb = true);
+
+/** Apply per-channel gains to the source image in linear RGB
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC3 or CV_16UC3
+ *  \param[in] gains       BGR gains
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         [default (-1) is the maximum of the data type]
+ *  \param[in] srgb        source is sRGB encoded (false for linear data)
+ *                         [default is true]
+ *
+ *  \return                balanced image of the source type
+ */
+cv::Mat ApplyAwbGains(const cv::Mat& src, const cv::Vec3d& gains,
+                      int max_value = -1, bool srgb = true);
+
+/** Apply a 3x3 matrix to the source image in linear RGB
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC3 or CV_16UC3
+ *  \param[in] m           matrix applied to each BGR column vector
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         [default (-1) is the maximum of the data type]
+ *  \param[in] srgb        source is sRGB encoded (false for linear data)
+ *                         [default is true]
+ *
+ *  \return                transformed image of the source type
+ */
+cv::Mat ApplyColorMatrix(const cv::Mat& src, const cv::Matx33d& m,
+                         int max_value = -1, bool srgb = true);
+
+/** Automatic white balance source image (estimate gains, then apply them)
+ *
+ *  \param[in] src         source cv::Mat of CV_8UC3 or CV_16UC3
+ *  \param[in] method      illuminant estimation method [default is gray
+ *                         world]
+ *  \param[in] p           shades of gray norm [default is 6]
+ *  \param[in] stride      statistics proxy stride [default is 1]
+ *  \param[in] max_value   maximum possible value data sources may take on
+ *                         [default (-1) is the maximum of the data type]
+ *  \param[in] srgb        source is sRGB encoded [default is true]
+ *
+ *  \return                automatic white balanced source image
+ */
+cv::Mat WhiteBalance(const cv::Mat& src,
+                     AwbMethod method = AwbMethod::gray_world,
+                     double p = 6.0, int stride = 1, int max_value = -1,
+                     bool srgb = true);
+}
@@ -1,19 +1,137 @@
-/** Implementation file for linear interpolation of one-dimensional data
+/** Implementation file for interpolation of one-dimensional data
  *
  *  \file numerical/interpolation/Interp1.cpp
  *  \author Carl Salvaggio, Ph.D. (salvaggio@cis.rit.edu)
  *  \date 21 February 2020
  */
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <string>
 
 #include "Interp1.h"
 
 namespace numerical {
 
-Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
-                        const Eigen::VectorXd& y) {
-  Eigen::VectorXd yhat = Eigen::VectorXd::Zero(xhat.size());
+namespace {
+
+double Sign(double v) { return (v > 0) - (v < 0); }
+
+/* Derivative at the first point of a shape-preserving cubic (the end
+ * condition of MATLAB pchip)
+ */
+double PchipEnd(double h0, double h1, double d0, double d1) {
+  double s = ((2 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+  if (Sign(s) != Sign(d0)) {
+    s = 0;
+  } else if ((Sign(d0) != Sign(d1)) && (std::abs(s) > std::abs(3 * d0))) {
+    s = 3 * d0;
+  }
+  return s;
+}
+
+/* Derivatives of the cubic Hermite interpolant at every x
+ */
+template <typename In>
+void Slopes(const Eigen::VectorXd& x, const In& y, InterpMethod method,
+            std::vector<double>& s) {
+  Eigen::Index n = x.size();
+  std::vector<double> h(n - 1);
+  std::vector<double> d(n - 1);
+  for (Eigen::Index i = 0; i < n - 1; i++) {
+    h[i] = x[i + 1] - x[i];
+    d[i] = (y[i + 1] - y[i]) / h[i];
+  }
+
+  s.resize(n);
+  if (n == 2) {
+    s[0] = s[1] = d[0];
+    return;
+  }
+
+  if (method == InterpMethod::pchip) {
+    // Weighted harmonic mean of the neighboring slopes, zero at extrema
+    for (Eigen::Index i = 1; i < n - 1; i++) {
+      if (d[i - 1] * d[i] <= 0) {
+        s[i] = 0;
+      } else {
+        double w1 = 2 * h[i] + h[i - 1];
+        double w2 = h[i] + 2 * h[i - 1];
+        s[i] = (w1 + w2) / (w1 / d[i - 1] + w2 / d[i]);
+      }
+    }
+    s[0] = PchipEnd(h[0], h[1], d[0], d[1]);
+    s[n - 1] = PchipEnd(h[n - 2], h[n - 3], d[n - 2], d[n - 3]);
+    return;
+  }
+
+  // Not-a-knot spline through 3 points is the parabola through them
+  if (n == 3) {
+    double c = (d[1] - d[0]) / (x[2] - x[0]);
+    s[0] = d[0] - c * h[0];
+    s[1] = d[0] + c * h[0];
+    s[2] = d[0] + c * (x[2] - x[0] + h[1]);
+    return;
+  }
+
+  // Tridiagonal system for the not-a-knot spline slopes (sub-diagonal a,
+  // diagonal b, super-diagonal c, right-hand side r), solved by elimination
+  std::vector<double> a(n, 0);
+  std::vector<double> b(n);
+  std::vector<double> c(n, 0);
+  std::vector<double> r(n);
+  double x31 = x[2] - x[0];
+  b[0] = h[1];
+  c[0] = x31;
+  r[0] = ((h[0] + 2 * x31) * h[1] * d[0] + h[0] * h[0] * d[1]) / x31;
+  for (Eigen::Index i = 1; i < n - 1; i++) {
+    a[i] = h[i];
+    b[i] = 2 * (h[i] + h[i - 1]);
+    c[i] = h[i - 1];
+    r[i] = 3 * (h[i] * d[i - 1] + h[i - 1] * d[i]);
+  }
+  double xn = x[n - 1] - x[n - 3];
+  a[n - 1] = xn;
+  b[n - 1] = h[n - 3];
+  r[n - 1] = (h[n - 2] * h[n - 2] * d[n - 3] +
+              (2 * xn + h[n - 2]) * h[n - 3] * d[n - 2]) /
+             xn;
+
+  for (Eigen::Index i = 1; i < n; i++) {
+    double m = a[i] / b[i - 1];
+    b[i] -= m * c[i - 1];
+    r[i] -= m * r[i - 1];
+  }
+  s[n - 1] = r[n - 1] / b[n - 1];
+  for (Eigen::Index i = n - 2; i >= 0; i--) {
+    s[i] = (r[i] - c[i] * s[i + 1]) / b[i];
+  }
+}
+
+}  // namespace
+
+Interp1Plan::Interp1Plan(const Eigen::VectorXd& xhat,
+                         const Eigen::VectorXd& x)
+    : x_(x) {
+  if (x.size() < 2) {
+    std::string msg = "At least two independent coefficients are required";
+    throw std::runtime_error(msg);
+  }
+
+  // Repeated (or descending) x would make an interval width zero (or
+  // negative) and fill the plan and the cubic slopes with inf/NaN
+  for (Eigen::Index i = 0; i < x.size() - 1; i++) {
+    if (!(x[i + 1] > x[i])) {
+      std::string msg = "Independent coefficients must be strictly increasing";
+      throw std::runtime_error(msg);
+    }
+  }
+
+  Eigen::Index m = xhat.size();
+  if (m == 0) {
+    return;
+  }
 
   if (xhat.minCoeff() < x.minCoeff()) {
     std::string msg = "Minimum independent coefficient out of range";
@@ -25,44 +143,100 @@ Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
     throw std::runtime_error(msg);
   }
 
-  for (size_t idx = 0; idx < static_cast<size_t>(xhat.size()); idx++) {
-    // Binary search for interpolation interval (assumes ascending sort order)
-    // Running time classification: O(log2 n)
-    size_t low = 0;
-    size_t high = x.size() - 1;
-    size_t middle;
-    while (low <= high) {
-      middle = (low + high) / 2;
-      if (xhat[idx] > x[middle]) {
-        low = middle + 1;
-      } else if (xhat[idx] < x[middle]) {
-        high = middle - 1;
-      } else {
-        break;
+  // Intervals are [x[i], x[i + 1]] with i in [0, n - 2], so a query point
+  // equal to the last x falls in the last interval
+  Eigen::Index last = x.size() - 2;
+  interval_.resize(m);
+  bool ascending = std::is_sorted(xhat.data(), xhat.data() + m);
+  if (ascending) {
+    // Merge walk (assumes ascending x)
+    // Running time classification: O(n + m)
+    Eigen::Index i = 0;
+    for (Eigen::Index k = 0; k < m; k++) {
+      while ((i < last) && (xhat[k] >= x[i + 1])) {
+        i++;
       }
+      interval_[k] = i;
     }
-    if (xhat[idx] < x[middle]) {
-      middle = middle - 1;
+  } else {
+    // Binary search for each interpolation interval (assumes ascending x)
+    // Running time classification: O(m log2 n)
+    for (Eigen::Index k = 0; k < m; k++) {
+      auto it = std::upper_bound(x.data(), x.data() + x.size(), xhat[k]);
+      interval_[k] = std::min<Eigen::Index>(it - x.data() - 1, last);
     }
-    yhat[idx] = (y[middle + 1] - y[middle]) / (x[middle + 1] - x[middle]) *
-                    (xhat[idx] - x[middle]) +
-                y[middle];
-
-    /*
-    // Linear search for interpolation interval (no sort order assumption)
-    // Running time classification: O(n)
-    for (size_t jdx = 0; jdx < static_cast<size_t>(x.size() - 1); jdx++) {
-      if (((x[jdx] <= xhat[idx]) && (xhat[idx] <= x[jdx + 1])) ||
-          ((x[jdx + 1] <= xhat[idx]) && (xhat[idx] <= x[jdx]))) {
-        yhat[idx] = (y[jdx + 1] - y[jdx]) / (x[jdx + 1] - x[jdx]) *
-                        (xhat[idx] - x[jdx]) +
-                    y[jdx];
-        break;
-      }
+  }
+
+  offset_.resize(m);
+  fraction_.resize(m);
+  for (Eigen::Index k = 0; k < m; k++) {
+    Eigen::Index i = interval_[k];
+    offset_[k] = xhat[k] - x[i];
+    fraction_[k] = offset_[k] / (x[i + 1] - x[i]);
+  }
+}
+
+template <typename In, typename Out>
+void Interp1Plan::Interpolate(const In& y, InterpMethod method,
+                              Out yhat) const {
+  if (y.size() != x_.size()) {
+    std::string msg = "Dependent and independent coefficient counts differ";
+    throw std::runtime_error(msg);
+  }
+
+  Eigen::Index m = offset_.size();
+  if (method == InterpMethod::linear) {
+    for (Eigen::Index k = 0; k < m; k++) {
+      Eigen::Index i = interval_[k];
+      yhat[k] = y[i] + fraction_[k] * (y[i + 1] - y[i]);
     }
-    */
+    return;
+  }
+
+  // Cubic Hermite evaluation of each interval from the endpoint slopes
+  std::vector<double> s;
+  Slopes(x_, y, method, s);
+  for (Eigen::Index k = 0; k < m; k++) {
+    Eigen::Index i = interval_[k];
+    double h = x_[i + 1] - x_[i];
+    double d = (y[i + 1] - y[i]) / h;
+    double c2 = (3 * d - 2 * s[i] - s[i + 1]) / h;
+    double c3 = (s[i] - 2 * d + s[i + 1]) / (h * h);
+    double t = offset_[k];
+    yhat[k] = y[i] + t * (s[i] + t * (c2 + t * c3));
   }
+}
+
+Eigen::VectorXd Interp1Plan::Apply(const Eigen::VectorXd& y,
+                                   InterpMethod method) const {
+  Eigen::VectorXd yhat(offset_.size());
+  Interpolate(y, method, yhat.col(0));
+  return yhat;
+}
 
+Eigen::MatrixXd Interp1Plan::ApplyColumns(const Eigen::MatrixXd& y,
+                                          InterpMethod method) const {
+  Eigen::MatrixXd yhat(offset_.size(), y.cols());
+  for (Eigen::Index j = 0; j < y.cols(); j++) {
+    Interpolate(y.col(j), method, yhat.col(j));
+  }
   return yhat;
 }
+
+Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
+                        const Eigen::VectorXd& y) {
+  return Interp1Plan(xhat, x).Apply(y);
+}
+
+Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
+                        const Eigen::VectorXd& y, InterpMethod method) {
+  return Interp1Plan(xhat, x).Apply(y, method);
+}
+
+Eigen::MatrixXd Interp1Columns(const Eigen::VectorXd& xhat,
+                               const Eigen::VectorXd& x,
+                               const Eigen::MatrixXd& y,
+                               InterpMethod method) {
+  return Interp1Plan(xhat, x).ApplyColumns(y, method);
+}
 }
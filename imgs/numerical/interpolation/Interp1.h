@@ -1,16 +1,88 @@
-/** Interface file for linear interpolation of one-dimensional data
+/** Interface file for interpolation of one-dimensional data
  *
  *  \file numerical/interpolation/Interp1.h
  *  \author Carl Salvaggio, Ph.D. (salvaggio@cis.rit.edu)
  *  \date 21 February 2020
+ *
+ *  \description
+ *    Locating the interval of every query point only depends on (x, x-hat),
+ *    so it is done once in an Interp1Plan and reused for any number of
+ *    dependent vectors (e.g. an illuminant and three color matching
+ *    functions resampled to one wavelength grid).  Ascending query points
+ *    (the usual case for wavelength grids) are located with a single merge
+ *    walk, O(n + m), other orderings with a binary search per point.
+ *
+ *    Methods
+ *      linear   piecewise linear
+ *      spline   not-a-knot cubic spline (as MATLAB spline)
+ *      pchip    shape-preserving piecewise cubic Hermite (as MATLAB pchip)
  */
 
 #pragma once
 
+#include <vector>
+
 #include <eigen3/Eigen/Dense>
 
 namespace numerical {
 
+/** Interpolation method
+ */
+enum class InterpMethod { linear, spline, pchip };
+
+class Interp1Plan {
+ public:
+  /* Constructor
+   *
+   * \param[in] xhat
+   *     independent variable values at which to interpolate (within the
+   *     range of x)
+   * \param[in] x
+   *     independent variable vector in strictly ascending order (at least
+   *     2 values)
+   */
+  Interp1Plan(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x);
+
+  /* Interpolate one dependent variable vector
+   *
+   * \param[in] y
+   *     dependent variable vector (one value per x)
+   * \param[in] method
+   *     interpolation method [default is linear]
+   *
+   * \return
+   *     interpolated dependent values at x-hat
+   */
+  Eigen::VectorXd Apply(const Eigen::VectorXd& y,
+                        InterpMethod method = InterpMethod::linear) const;
+
+  /* Interpolate each column of a dependent variable matrix
+   *
+   * \param[in] y
+   *     dependent variable matrix (one row per x)
+   * \param[in] method
+   *     interpolation method [default is linear]
+   *
+   * \return
+   *     interpolated dependent values at x-hat (one row per x-hat)
+   */
+  Eigen::MatrixXd ApplyColumns(
+      const Eigen::MatrixXd& y,
+      InterpMethod method = InterpMethod::linear) const;
+
+ private:
+  template <typename In, typename Out>
+  void Interpolate(const In& y, InterpMethod method, Out yhat) const;
+
+  Eigen::VectorXd x_;
+
+  // Left end of the interval holding each query point, the query point's
+  // offset into the interval, and that offset as a fraction of the interval
+  std::vector<Eigen::Index> interval_;
+  Eigen::VectorXd offset_;
+  Eigen::VectorXd fraction_;
+};
+
 /** Perform linear interpolation of provided (x,y) data at provided locations
  *
  *  \param[in] xhat
@@ -27,4 +99,41 @@ namespace numerical {
  */
 Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
                         const Eigen::VectorXd& y);
+
+/** Perform interpolation of provided (x,y) data at provided locations
+ *
+ *  \param[in] xhat
+ *      values at which to interpolate
+ *  \param[in] x
+ *      independent variable vector
+ *  \param[in] y
+ *      dependent variable vector
+ *  \param[in] method
+ *      interpolation method
+ *
+ *  \return
+ *      interpolated dependent values (y-hat) at x-hat
+ */
+Eigen::VectorXd Interp1(const Eigen::VectorXd& xhat, const Eigen::VectorXd& x,
+                        const Eigen::VectorXd& y, InterpMethod method);
+
+/** Perform interpolation of each column of provided (x,Y) data at provided
+ *  locations
+ *
+ *  \param[in] xhat
+ *      values at which to interpolate
+ *  \param[in] x
+ *      independent variable vector
+ *  \param[in] y
+ *      dependent variable matrix (one row per x)
+ *  \param[in] method
+ *      interpolation method [default is linear]
+ *
+ *  \return
+ *      interpolated dependent values (one row per x-hat)
+ */
+Eigen::MatrixXd Interp1Columns(const Eigen::VectorXd& xhat,
+                               const Eigen::VectorXd& x,
+                               const Eigen::MatrixXd& y,
+                               InterpMethod method = InterpMethod::linear);
 }
@@ -0,0 +1,138 @@
+/** Interface file for parallel merge sorting
+ *
+ *  \file imgs/numerical/sorting/ParallelSort.h
+ *
+ *  \description
+ *    Stable sorting with any comparator on several threads.  The range is
+ *    split into one run per thread, the runs are sorted concurrently with
+ *    std::stable_sort, and neighboring runs are then merged pairwise (each
+ *    round of merges also in parallel) through a buffer of the same size.
+ *    Small ranges, or a single thread, fall back to std::stable_sort.
+ *
+ *    Running time classification: O(n log2 n / threads + n log2 threads)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace numerical {
+
+// Elements per thread below which sorting is not split
+constexpr size_t kParallelSortGrain = 1 << 15;
+
+/* Stable sort of [first, last) on several threads
+ *
+ * \param[in] first    random access iterator to the first element
+ * \param[in] last     random access iterator past the last element
+ * \param[in] compare  strict weak ordering [default is std::less]
+ * \param[in] threads  threads, 0 for one per hardware thread [default is 0]
+ */
+template <typename It, typename Compare = std::less<>>
+void ParallelSort(It first, It last, Compare compare = Compare(),
+                  unsigned int threads = 0) {
+  using T = typename std::iterator_traits<It>::value_type;
+  size_t n = std::distance(first, last);
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  size_t runs = std::min<size_t>(threads, n / kParallelSortGrain);
+  if (runs < 2) {
+    std::stable_sort(first, last, compare);
+    return;
+  }
+
+  // Run boundaries, run r is [bound[r], bound[r + 1])
+  std::vector<size_t> bound(runs + 1);
+  for (size_t r = 0; r <= runs; r++) {
+    bound[r] = (n * r) / runs;
+  }
+
+  auto parallel = [](size_t count, const auto& work) {
+    std::vector<std::thread> workers;
+    for (size_t idx = 1; idx < count; idx++) {
+      workers.emplace_back(work, idx);
+    }
+    work(0);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  };
+
+  parallel(runs, [&](size_t r) {
+    std::stable_sort(first + bound[r], first + bound[r + 1], compare);
+  });
+
+  // Merge neighboring runs back and forth between the range and the buffer
+  // (a last run without a partner is moved across)
+  std::vector<T> buffer(std::make_move_iterator(first),
+                        std::make_move_iterator(last));
+  bool in_buffer = true;
+  auto merge = [&](auto src, auto dst, size_t p) {
+    size_t lo = bound[2 * p];
+    if (2 * p + 2 < bound.size()) {
+      size_t mid = bound[2 * p + 1];
+      size_t hi = bound[2 * p + 2];
+      std::merge(std::make_move_iterator(src + lo),
+                 std::make_move_iterator(src + mid),
+                 std::make_move_iterator(src + mid),
+                 std::make_move_iterator(src + hi), dst + lo, compare);
+    } else {
+      std::move(src + lo, src + bound.back(), dst + lo);
+    }
+  };
+  while (bound.size() > 2) {
+    size_t merges = bound.size() / 2;
+    parallel(merges, [&](size_t p) {
+      if (in_buffer) {
+        merge(buffer.begin(), first, p);
+      } else {
+        merge(first, buffer.begin(), p);
+      }
+    });
+
+    std::vector<size_t> merged;
+    for (size_t r = 0; r < bound.size(); r += 2) {
+      merged.push_back(bound[r]);
+    }
+    if (merged.back() != n) {
+      merged.push_back(n);
+    }
+    bound.swap(merged);
+    in_buffer = !in_buffer;
+  }
+
+  if (in_buffer) {
+    std::move(buffer.begin(), buffer.end(), first);
+  }
+}
+
+/* Indices that stably sort the elements of a vector
+ *
+ * \param[in] values   elements to order
+ * \param[in] compare  strict weak ordering [default is std::less]
+ * \param[in] threads  threads, 0 for one per hardware thread [default is 0]
+ *
+ * \return             permutation, values[index[0]] is the first element
+ */
+template <typename Index = uint32_t, typename T,
+          typename Compare = std::less<>>
+std::vector<Index> ArgSort(const std::vector<T>& values,
+                           Compare compare = Compare(),
+                           unsigned int threads = 0) {
+  std::vector<Index> index(values.size());
+  std::iota(index.begin(), index.end(), Index(0));
+  ParallelSort(
+      index.begin(), index.end(),
+      [&](Index a, Index b) { return compare(values[a], values[b]); },
+      threads);
+  return index;
+}
+
+}  // namespace numerical
@@ -0,0 +1,182 @@
+/** Interface file for LSD radix sorting
+ *
+ *  \file imgs/numerical/sorting/RadixSort.h
+ *
+ *  \description
+ *    Stable least-significant-digit radix sorts of integral and floating
+ *    point keys (ascending), one 8-bit digit per pass.  Keys are mapped to
+ *    unsigned integers whose order matches the key order (the sign bit of
+ *    signed integers is flipped, every bit of negative floating point values
+ *    and the sign bit of positive ones are flipped), so -0 sorts before +0
+ *    and NaNs sort to the ends according to their sign bit.  The histograms
+ *    of every digit are gathered in a single pass and digits shared by all
+ *    keys are skipped, so 8-bit pixel values need one pass and 16-bit ones
+ *    at most two.
+ *
+ *    Running time classification: O(n sizeof(key))
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace numerical {
+
+namespace detail {
+
+template <size_t Bytes>
+struct UnsignedOfSize;
+template <>
+struct UnsignedOfSize<1> {
+  using type = uint8_t;
+};
+template <>
+struct UnsignedOfSize<2> {
+  using type = uint16_t;
+};
+template <>
+struct UnsignedOfSize<4> {
+  using type = uint32_t;
+};
+template <>
+struct UnsignedOfSize<8> {
+  using type = uint64_t;
+};
+
+/* Order preserving map of a key to an unsigned integer of the same size
+ */
+template <typename T>
+struct RadixKey {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "Radix sort keys must be integral or floating point");
+  static_assert(!std::is_floating_point_v<T> || (sizeof(T) <= 8),
+                "Radix sort floating point keys are float or double");
+
+  using Bits = typename UnsignedOfSize<sizeof(T)>::type;
+  static constexpr Bits kSign = Bits(1) << (8 * sizeof(T) - 1);
+
+  static Bits Get(T key) {
+    Bits bits;
+    std::memcpy(&bits, &key, sizeof(T));
+    if constexpr (std::is_floating_point_v<T>) {
+      return (bits & kSign) ? Bits(~bits) : Bits(bits | kSign);
+    } else if constexpr (std::is_signed_v<T>) {
+      return bits ^ kSign;
+    } else {
+      return bits;
+    }
+  }
+};
+
+/* Stable LSD radix sort of keys, carrying values (when values is not null)
+ * along with them, using buffers of n elements
+ */
+template <typename K, typename V>
+void RadixSort(K* keys, K* key_buffer, V* values, V* value_buffer, size_t n) {
+  using Key = RadixKey<K>;
+  constexpr size_t kDigits = sizeof(K);
+  if (n < 2) {
+    return;
+  }
+
+  // Histograms of every digit from one pass over the keys
+  std::vector<std::array<size_t, 256>> counts(kDigits);
+  for (auto& count : counts) {
+    count.fill(0);
+  }
+  for (size_t idx = 0; idx < n; idx++) {
+    auto bits = Key::Get(keys[idx]);
+    for (size_t d = 0; d < kDigits; d++) {
+      counts[d][(bits >> (8 * d)) & 0xFF]++;
+    }
+  }
+
+  K* src_keys = keys;
+  K* dst_keys = key_buffer;
+  V* src_values = values;
+  V* dst_values = value_buffer;
+  for (size_t d = 0; d < kDigits; d++) {
+    auto& count = counts[d];
+    // Every key has the same digit, this pass would not move anything
+    if (std::find(count.begin(), count.end(), n) != count.end()) {
+      continue;
+    }
+
+    std::array<size_t, 256> offset;
+    std::exclusive_scan(count.begin(), count.end(), offset.begin(),
+                        size_t(0));
+    for (size_t idx = 0; idx < n; idx++) {
+      size_t digit = (Key::Get(src_keys[idx]) >> (8 * d)) & 0xFF;
+      size_t position = offset[digit]++;
+      dst_keys[position] = src_keys[idx];
+      if (values) {
+        dst_values[position] = std::move(src_values[idx]);
+      }
+    }
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  // An odd number of passes leaves the result in the buffers
+  if (src_keys != keys) {
+    std::copy(src_keys, src_keys + n, keys);
+    if (values) {
+      std::move(src_values, src_values + n, values);
+    }
+  }
+}
+
+}  // namespace detail
+
+/* Sort keys in ascending order
+ *
+ * \param[in,out] keys  integral or floating point keys
+ */
+template <typename K>
+void RadixSort(std::vector<K>& keys) {
+  std::vector<K> buffer(keys.size());
+  detail::RadixSort<K, char>(keys.data(), buffer.data(), nullptr, nullptr,
+                             keys.size());
+}
+
+/* Sort keys in ascending order, applying the same (stable) permutation to
+ * the values
+ *
+ * \param[in,out] keys    integral or floating point keys
+ * \param[in,out] values  values, one per key
+ */
+template <typename K, typename V>
+void RadixSortByKey(std::vector<K>& keys, std::vector<V>& values) {
+  if (values.size() != keys.size()) {
+    throw std::runtime_error("Key and value counts differ");
+  }
+  std::vector<K> key_buffer(keys.size());
+  std::vector<V> value_buffer(values.size());
+  detail::RadixSort(keys.data(), key_buffer.data(), values.data(),
+                    value_buffer.data(), keys.size());
+}
+
+/* Indices that sort the keys in ascending order (equal keys keep their
+ * original order)
+ *
+ * \param[in] keys  integral or floating point keys
+ *
+ * \return          permutation, keys[index[0]] is the smallest key
+ */
+template <typename Index = uint32_t, typename K>
+std::vector<Index> RadixArgSort(const std::vector<K>& keys) {
+  std::vector<K> sorted(keys);
+  std::vector<Index> index(keys.size());
+  std::iota(index.begin(), index.end(), Index(0));
+  RadixSortByKey(sorted, index);
+  return index;
+}
+
+}  // namespace numerical
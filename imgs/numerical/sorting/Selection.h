@@ -0,0 +1,367 @@
+/** Interface file for selection and order statistics
+ *
+ *  \file imgs/numerical/sorting/Selection.h
+ *
+ *  \description
+ *    Order statistics without fully sorting the data
+ *      IntroSelect         k-th element by quickselect (median of three
+ *                          pivots, three-way partitions) that switches to
+ *                          median-of-medians pivots when the recursion gets
+ *                          too deep, O(n) worst case
+ *      Quantile/Median     interpolated sample quantiles from IntroSelect
+ *      HistogramPercentile percentile cut point of a histogram, O(bins)
+ *      IntegerPercentile   percentile of 8- or 16-bit integer data from a
+ *                          counting histogram, O(n + 2^bits)
+ *      P2Quantile          streaming quantile estimate in constant memory
+ *                          (the P-square algorithm of Jain and Chlamtac)
+ *      TopK                the k largest elements seen, O(n log k)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace numerical {
+
+namespace detail {
+
+// Ranges this short are insertion sorted
+constexpr ptrdiff_t kSelectInsertion = 16;
+
+template <typename It, typename Compare>
+void InsertionSort(It first, It last, Compare& compare) {
+  for (It i = first; i != last; ++i) {
+    for (It j = i; (j != first) && compare(*j, *std::prev(j)); --j) {
+      std::iter_swap(j, std::prev(j));
+    }
+  }
+}
+
+template <typename It, typename Compare>
+It MedianOfThree(It a, It b, It c, Compare& compare) {
+  if (compare(*a, *b)) {
+    return compare(*b, *c) ? b : (compare(*a, *c) ? c : a);
+  }
+  return compare(*a, *c) ? a : (compare(*b, *c) ? c : b);
+}
+
+template <typename It, typename Compare>
+void Select(It first, It nth, It last, Compare& compare);
+
+/* Median of the medians of groups of five (moved to the front of the
+ * range), guaranteed to split the range 30/70 or better
+ */
+template <typename It, typename Compare>
+It MedianOfMedians(It first, It last, Compare& compare) {
+  ptrdiff_t n = last - first;
+  ptrdiff_t medians = 0;
+  for (ptrdiff_t g = 0; g < n; g += 5) {
+    It group = first + g;
+    ptrdiff_t size = std::min<ptrdiff_t>(5, n - g);
+    InsertionSort(group, group + size, compare);
+    std::iter_swap(first + medians++, group + size / 2);
+  }
+  It mid = first + medians / 2;
+  Select(first, mid, first + medians, compare);
+  return mid;
+}
+
+template <typename It, typename Compare>
+void Select(It first, It nth, It last, Compare& compare) {
+  using T = typename std::iterator_traits<It>::value_type;
+  int depth = 2 * static_cast<int>(std::log2(std::max<ptrdiff_t>(
+                      last - first, 1)));
+  while (last - first > kSelectInsertion) {
+    It pivot = (depth-- > 0)
+                   ? MedianOfThree(first, first + (last - first) / 2,
+                                   std::prev(last), compare)
+                   : MedianOfMedians(first, last, compare);
+
+    // Three-way partition, [first, lo) < pivot, [lo, hi) == pivot,
+    // [hi, last) > pivot, so runs of equal elements end the search
+    T value = *pivot;
+    It lo = std::partition(first, last, [&](const T& element) {
+      return compare(element, value);
+    });
+    It hi = std::partition(lo, last, [&](const T& element) {
+      return !compare(value, element);
+    });
+    if (nth < lo) {
+      last = lo;
+    } else if (nth >= hi) {
+      first = hi;
+    } else {
+      return;
+    }
+  }
+  InsertionSort(first, last, compare);
+}
+
+}  // namespace detail
+
+/* Rearrange [first, last) so that *nth is the element that would be there
+ * if the range were sorted, with no element of [first, nth) after it and no
+ * element of (nth, last) before it (as std::nth_element)
+ *
+ * Running time classification: O(n)
+ */
+template <typename It, typename Compare = std::less<>>
+void IntroSelect(It first, It nth, It last, Compare compare = Compare()) {
+  if ((first == last) || (nth == last)) {
+    return;
+  }
+  detail::Select(first, nth, last, compare);
+}
+
+/* Sample quantile, interpolated linearly between the order statistics
+ * around p (n - 1) (the default of MATLAB quantile for sorted positions,
+ * and of numpy)
+ *
+ * \param[in] values  samples (copied, then partially reordered)
+ * \param[in] p       probability in [0, 1]
+ */
+template <typename T>
+double Quantile(std::vector<T> values, double p) {
+  if (values.empty()) {
+    throw std::runtime_error("Quantile of an empty sample");
+  }
+  if (!((p >= 0) && (p <= 1))) {
+    throw std::runtime_error("Quantile probability must be in [0, 1]");
+  }
+  double h = p * (values.size() - 1);
+  size_t k = static_cast<size_t>(h);
+  IntroSelect(values.begin(), values.begin() + k, values.end());
+  double low = static_cast<double>(values[k]);
+  if (k + 1 == values.size()) {
+    return low;
+  }
+  // The next order statistic is the smallest element after the k-th one
+  double high =
+      static_cast<double>(*std::min_element(values.begin() + k + 1,
+                                            values.end()));
+  return low + (h - k) * (high - low);
+}
+
+template <typename T>
+double Median(std::vector<T> values) {
+  return Quantile(std::move(values), 0.5);
+}
+
+/* Smallest bin whose cumulative count reaches the given fraction of the
+ * total count (the first occupied bin for a fraction of 0)
+ *
+ * \param[in] histogram  bin counts
+ * \param[in] bins       number of bins
+ * \param[in] fraction   fraction of the total count in [0, 1]
+ */
+template <typename Count>
+size_t HistogramPercentile(const Count* histogram, size_t bins,
+                           double fraction) {
+  double total = 0;
+  for (size_t idx = 0; idx < bins; idx++) {
+    total += histogram[idx];
+  }
+  if (!(total > 0)) {
+    throw std::runtime_error("Percentile of an empty histogram");
+  }
+
+  double target = std::clamp(fraction, 0.0, 1.0) * total;
+  double cumulative = 0;
+  for (size_t idx = 0; idx < bins; idx++) {
+    cumulative += histogram[idx];
+    if ((cumulative >= target) && (cumulative > 0)) {
+      return idx;
+    }
+  }
+  return bins - 1;
+}
+
+/* Percentile of 8- or 16-bit integer data (such as image pixels) from a
+ * counting histogram, the smallest value with at least the given fraction of
+ * the data at or below it
+ */
+template <typename T>
+T IntegerPercentile(const T* data, size_t n, double fraction) {
+  static_assert(std::is_integral_v<T> && (sizeof(T) <= 2),
+                "Integer percentiles are of 8- or 16-bit data");
+  using Unsigned = std::make_unsigned_t<T>;
+  constexpr size_t bins = size_t(1) << (8 * sizeof(T));
+  constexpr size_t offset = std::is_signed_v<T> ? bins / 2 : 0;
+
+  std::vector<size_t> histogram(bins, 0);
+  for (size_t idx = 0; idx < n; idx++) {
+    histogram[static_cast<Unsigned>(data[idx] + offset) & (bins - 1)]++;
+  }
+  return static_cast<T>(
+      static_cast<ptrdiff_t>(
+          HistogramPercentile(histogram.data(), bins, fraction)) -
+      static_cast<ptrdiff_t>(offset));
+}
+
+/* Streaming estimate of one quantile with five markers whose heights are
+ * adjusted by piecewise-parabolic prediction as samples arrive (P-square
+ * algorithm, Jain and Chlamtac, 1985), exact for the first five samples
+ */
+class P2Quantile {
+ public:
+  /* Constructor
+   *
+   * \param[in] p  probability of the estimated quantile in [0, 1]
+   */
+  explicit P2Quantile(double p) : p_(p) {
+    if (!((p >= 0) && (p <= 1))) {
+      throw std::runtime_error("Quantile probability must be in [0, 1]");
+    }
+    increment_[0] = 0;
+    increment_[1] = p / 2;
+    increment_[2] = p;
+    increment_[3] = (1 + p) / 2;
+    increment_[4] = 1;
+  }
+
+  size_t count() const { return count_; }
+
+  void Add(double x) {
+    if (count_ < 5) {
+      height_[count_++] = x;
+      if (count_ == 5) {
+        std::sort(height_, height_ + 5);
+        for (int i = 0; i < 5; i++) {
+          position_[i] = i + 1;
+          desired_[i] = 1 + 4 * increment_[i];
+        }
+      }
+      return;
+    }
+    count_++;
+
+    // Cell k holding x, extending the extreme markers if needed
+    int k;
+    if (x < height_[0]) {
+      height_[0] = x;
+      k = 0;
+    } else if (x >= height_[4]) {
+      height_[4] = std::max(height_[4], x);
+      k = 3;
+    } else {
+      k = static_cast<int>(std::upper_bound(height_, height_ + 5, x) -
+                           height_) -
+          1;
+    }
+    for (int i = k + 1; i < 5; i++) {
+      position_[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+      desired_[i] += increment_[i];
+    }
+
+    // Move the middle markers toward their desired positions
+    for (int i = 1; i < 4; i++) {
+      double d = desired_[i] - position_[i];
+      if (((d >= 1) && (position_[i + 1] - position_[i] > 1)) ||
+          ((d <= -1) && (position_[i - 1] - position_[i] < -1))) {
+        int s = (d > 0) ? 1 : -1;
+        double q = Parabolic(i, s);
+        if ((height_[i - 1] < q) && (q < height_[i + 1])) {
+          height_[i] = q;
+        } else {
+          height_[i] += s * (height_[i + s] - height_[i]) /
+                        (position_[i + s] - position_[i]);
+        }
+        position_[i] += s;
+      }
+    }
+  }
+
+  /* Current estimate (the interpolated sample quantile until the markers
+   * are first updated, by the sixth sample)
+   */
+  double value() const {
+    if (count_ == 0) {
+      throw std::runtime_error("Quantile of an empty sample");
+    }
+    if (count_ <= 5) {
+      return Quantile(std::vector<double>(height_, height_ + count_), p_);
+    }
+    return height_[2];
+  }
+
+ private:
+  double Parabolic(int i, int s) const {
+    double n0 = position_[i - 1];
+    double n1 = position_[i];
+    double n2 = position_[i + 1];
+    return height_[i] +
+           s / (n2 - n0) *
+               ((n1 - n0 + s) * (height_[i + 1] - height_[i]) / (n2 - n1) +
+                (n2 - n1 - s) * (height_[i] - height_[i - 1]) / (n1 - n0));
+  }
+
+  double p_;
+  size_t count_ = 0;
+  double height_[5];
+  double position_[5];
+  double desired_[5];
+  double increment_[5];
+};
+
+/* The k largest elements pushed so far (by the comparator), kept in a
+ * min-heap of size k
+ */
+template <typename T, typename Compare = std::less<>>
+class TopK {
+ public:
+  explicit TopK(size_t k, Compare compare = Compare())
+      : k_(k), compare_(compare) {
+    heap_.reserve(k);
+  }
+
+  size_t size() const { return heap_.size(); }
+  bool empty() const { return heap_.empty(); }
+
+  /* Smallest of the kept elements
+   */
+  const T& top() const { return heap_.front(); }
+
+  void Push(const T& value) {
+    auto greater = [this](const T& a, const T& b) { return compare_(b, a); };
+    if (heap_.size() < k_) {
+      heap_.push_back(value);
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    } else if ((k_ > 0) && compare_(heap_.front(), value)) {
+      std::pop_heap(heap_.begin(), heap_.end(), greater);
+      heap_.back() = value;
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    }
+  }
+
+  template <typename It>
+  void Push(It first, It last) {
+    for (; first != last; ++first) {
+      Push(*first);
+    }
+  }
+
+  /* The kept elements, largest first
+   */
+  std::vector<T> Sorted() const {
+    std::vector<T> sorted(heap_);
+    std::sort_heap(sorted.begin(), sorted.end(),
+                   [this](const T& a, const T& b) { return compare_(b, a); });
+    return sorted;
+  }
+
+ private:
+  size_t k_;
+  Compare compare_;
+  std::vector<T> heap_;
+};
+
+}  // namespace numerical
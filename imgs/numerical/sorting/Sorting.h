@@ -6,6 +6,10 @@
  * \note help where the heck do they keep php on the CIS server
  */
 
+#pragma once
+
+#include <vector>
+
 template <typename T1>  // we only need one typename because the "ascending"
                         // value will never not be a boolean
                         auto Bubble(std::vector<T1> testvect, bool ascending) {
@@ -3,8 +3,12 @@ Blackbody Class by Josh Carstens
 help me
 */
 
+#pragma once
+
 #include <cmath>
 
+#include <eigen3/Eigen/Dense>
+
 namespace radiometry
 {
 
@@ -19,21 +23,80 @@ public:
   double temperature() const { return temperature_; }
   void set_temperature(double temperature) { temperature_ = temperature; }
 
-  //storing some common physical constants
-  const double h = (6.62607004 * pow(10, -34));
-  const double c = (2.99792458 * pow(10, 8));
-  const double kb = (1.38064852 * pow(10, -23));
-  const double b = (2.897771955 * pow(10, 3)); //this is to the positive 3rd and not negative 3rd because it's in terms of microns instead of meters
+  //storing some common physical constants (compile time, shared by every blackbody)
+  static constexpr double h = 6.62607004e-34;
+  static constexpr double c = 2.99792458e8;
+  static constexpr double kb = 1.38064852e-23;
+  static constexpr double b = 2.897771955e3; //this is to the positive 3rd and not negative 3rd because it's in terms of microns instead of meters
+
+  //Planck's equation with wavelength in microns folded into two radiation constants,
+  //exitance = c1 / (wavelength^5 * (exp(c2 / (wavelength * temperature)) - 1))
+  static constexpr double c1 = 2 * M_PI * h * c * c * 1e24; //[W micron^4/m^2]
+  static constexpr double c2 = h * c / kb * 1e6;            //[micron K]
+
+  double exitance(double wavelength) const
+  {
+    double w2 = wavelength * wavelength;
+    return c1 / (w2 * w2 * wavelength * (std::exp(c2 / (wavelength * temperature_)) - 1)); //Planck’s equation for radiant exitance
+  }
+
+  double radiance(double wavelength) const { return (this->exitance(wavelength) / M_PI); }
+
+  double peak() const { return (b / temperature_); }
+
+  //batch versions, whole arrays are evaluated as single expressions so Eigen vectorizes them
+
+  //exitance/radiance at many wavelengths [micron] for this temperature
+  Eigen::ArrayXd exitance(const Eigen::ArrayXd& wavelengths) const
+  {
+    return Exitance(wavelengths, temperature_);
+  }
+
+  Eigen::ArrayXd radiance(const Eigen::ArrayXd& wavelengths) const
+  {
+    return Radiance(wavelengths, temperature_);
+  }
+
+  //exitance at many wavelengths [micron] for one temperature [K]
+  static Eigen::ArrayXd Exitance(const Eigen::ArrayXd& wavelengths, double temperature)
+  {
+    return c1 / (wavelengths.square().square() * wavelengths * (((c2 / temperature) / wavelengths).exp() - 1));
+  }
+
+  //exitance at one wavelength [micron] for many temperatures [K]
+  static Eigen::ArrayXd Exitance(double wavelength, const Eigen::ArrayXd& temperatures)
+  {
+    double w2 = wavelength * wavelength;
+    return (c1 / (w2 * w2 * wavelength)) / (((c2 / wavelength) / temperatures).exp() - 1);
+  }
+
+  //exitance for every (wavelength, temperature) pair, one row per wavelength and one column per temperature
+  static Eigen::ArrayXXd Exitance(const Eigen::ArrayXd& wavelengths, const Eigen::ArrayXd& temperatures)
+  {
+    Eigen::ArrayXd scale = c1 / (wavelengths.square().square() * wavelengths);
+    Eigen::ArrayXd x = c2 / wavelengths;
+    Eigen::ArrayXXd exitance(wavelengths.size(), temperatures.size());
+    for (Eigen::Index t = 0; t < temperatures.size(); t++)
+    {
+      exitance.col(t) = scale / ((x / temperatures(t)).exp() - 1);
+    }
+    return exitance;
+  }
 
-  double exitance(double wavelength)
+  static Eigen::ArrayXd Radiance(const Eigen::ArrayXd& wavelengths, double temperature)
   {
-    wavelength *= 0.000001; //converting microns to meters
-    return (((2 * M_PI * h * pow(c, 2) * pow(10, -6)) / (pow(wavelength, 5) * (exp((h * c) / (wavelength * kb * temperature_)) - 1)))); //Planck’s equation for radiant exitance
+    return Exitance(wavelengths, temperature) / M_PI;
   }
 
-  double radiance(double wavelength) { return (this->exitance(wavelength) / M_PI); }
+  static Eigen::ArrayXd Radiance(double wavelength, const Eigen::ArrayXd& temperatures)
+  {
+    return Exitance(wavelength, temperatures) / M_PI;
+  }
 
-  double peak() { return (b / temperature_); }
+  static Eigen::ArrayXXd Radiance(const Eigen::ArrayXd& wavelengths, const Eigen::ArrayXd& temperatures)
+  {
+    return Exitance(wavelengths, temperatures) / M_PI;
+  }
 
 private:
   double temperature_;
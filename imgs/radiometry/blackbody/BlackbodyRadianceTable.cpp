@@ -0,0 +1,148 @@
+/** Implementation file for tabulated blackbody band radiance
+ *
+ * \file imgs/radiometry/blackbody/BlackbodyRadianceTable.cpp
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include "imgs/radiometry/blackbody/BlackbodyRadianceTable.h"
+
+#include "imgs/radiometry/blackbody/Blackbody.h"
+
+using namespace std;
+
+namespace radiometry {
+
+namespace {
+
+// Temperatures evaluated per batch while tabulating (bounds the size of the
+// wavelength x temperature radiance block)
+const Eigen::Index kTabulateBatch = 1024;
+
+/* Uniformly spaced band wavelengths (a single one for a zero-width band)
+ */
+Eigen::ArrayXd BandWavelengths(double lower, double upper, int samples) {
+  if (lower == upper) {
+    return Eigen::ArrayXd::Constant(1, lower);
+  }
+  return Eigen::ArrayXd::LinSpaced(max(samples, 2), lower, upper);
+}
+
+template <typename T>
+void RenderRows(const BlackbodyRadianceTable& table, const cv::Mat& src,
+                cv::Mat& dst) {
+  cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      const T* in = src.ptr<T>(r);
+      T* out = dst.ptr<T>(r);
+      for (int c = 0; c < src.cols; c++) {
+        out[c] = static_cast<T>(table.radiance(in[c]));
+      }
+    }
+  });
+}
+
+}  // namespace
+
+BlackbodyRadianceTable::BlackbodyRadianceTable(
+    const Eigen::ArrayXd& wavelengths, const Eigen::ArrayXd& response,
+    double min_temperature, double max_temperature, double temperature_step) {
+  Eigen::Index n = wavelengths.size();
+  if ((n == 0) || (response.size() != n)) {
+    throw runtime_error(
+        "Band wavelengths and response must be non-empty and of equal size");
+  }
+  for (Eigen::Index idx = 1; idx < n; idx++) {
+    if (!(wavelengths(idx - 1) < wavelengths(idx))) {
+      throw runtime_error("Band wavelengths must be strictly increasing");
+    }
+  }
+
+  // Trapezoidal integration weights (a single wavelength is a weight of 1)
+  wavelengths_ = wavelengths;
+  weights_ = Eigen::ArrayXd::Ones(n);
+  if (n > 1) {
+    for (Eigen::Index idx = 0; idx < n; idx++) {
+      double left = wavelengths(max<Eigen::Index>(idx - 1, 0));
+      double right = wavelengths(min<Eigen::Index>(idx + 1, n - 1));
+      weights_(idx) = 0.5 * (right - left);
+    }
+  }
+  weights_ *= response;
+  double sum = weights_.sum();
+  if (!(sum > 0)) {
+    throw runtime_error("Band response must have a positive integral");
+  }
+  weights_ /= sum;
+
+  Tabulate(min_temperature, max_temperature, temperature_step);
+}
+
+BlackbodyRadianceTable::BlackbodyRadianceTable(double lower_wavelength,
+                                               double upper_wavelength,
+                                               double min_temperature,
+                                               double max_temperature,
+                                               double temperature_step,
+                                               int samples)
+    : BlackbodyRadianceTable(
+          BandWavelengths(lower_wavelength, upper_wavelength, samples),
+          Eigen::ArrayXd::Ones(
+              (lower_wavelength == upper_wavelength) ? 1 : max(samples, 2)),
+          min_temperature, max_temperature, temperature_step) {}
+
+void BlackbodyRadianceTable::Tabulate(double min_temperature,
+                                      double max_temperature,
+                                      double temperature_step) {
+  if ((min_temperature <= 0) || (max_temperature <= min_temperature) ||
+      (temperature_step <= 0)) {
+    throw runtime_error(
+        "Table temperatures must satisfy 0 < minimum < maximum with a "
+        "positive step");
+  }
+
+  min_temperature_ = min_temperature;
+  max_temperature_ = max_temperature;
+  temperature_step_ = temperature_step;
+  inverse_step_ = 1 / temperature_step;
+
+  Eigen::Index size = static_cast<Eigen::Index>(
+                          ceil((max_temperature - min_temperature) *
+                               inverse_step_)) +
+                      1;
+  last_ = static_cast<double>(size - 1);
+  table_.resize(size);
+
+  // Each batch is one wavelength x temperature Planck block reduced by the
+  // band weights
+  for (Eigen::Index t0 = 0; t0 < size; t0 += kTabulateBatch) {
+    Eigen::Index count = min(kTabulateBatch, size - t0);
+    Eigen::ArrayXd temperatures =
+        min_temperature +
+        temperature_step * Eigen::ArrayXd::LinSpaced(count, t0, t0 + count - 1);
+    Eigen::VectorXd radiance =
+        Blackbody::Radiance(wavelengths_, temperatures).matrix().transpose() *
+        weights_.matrix();
+    Eigen::Map<Eigen::VectorXd>(table_.data() + t0, count) = radiance;
+  }
+}
+
+double BlackbodyRadianceTable::Evaluate(double temperature) const {
+  return (weights_ * Blackbody::Radiance(wavelengths_, temperature)).sum();
+}
+
+cv::Mat BlackbodyRadianceTable::Render(const cv::Mat& temperature) const {
+  if ((temperature.type() != CV_32FC1) && (temperature.type() != CV_64FC1)) {
+    throw runtime_error(
+        "Temperature image must be of type CV_32FC1 or CV_64FC1");
+  }
+
+  cv::Mat radiance(temperature.size(), temperature.type());
+  if (temperature.depth() == CV_32F) {
+    RenderRows<float>(*this, temperature, radiance);
+  } else {
+    RenderRows<double>(*this, temperature, radiance);
+  }
+  return radiance;
+}
+}  // namespace radiometry
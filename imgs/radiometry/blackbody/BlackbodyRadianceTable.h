@@ -0,0 +1,127 @@
+/** Interface file for tabulated blackbody band radiance
+ *
+ * \file imgs/radiometry/blackbody/BlackbodyRadianceTable.h
+ *
+ * \description
+ *   The effective blackbody radiance of a sensor band,
+ *     L(T) = integral R(w) L(w, T) dw / integral R(w) dw  [W/m^2/sr/micron]
+ *   for a relative spectral response R, tabulated once at a fixed
+ *   temperature step (one matrix-vector product of the band weights with a
+ *   batch Planck evaluation) so that converting a temperature is a linear
+ *   interpolation in the table.  Temperatures outside of the tabulated
+ *   range are evaluated exactly.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
+#include <opencv2/core.hpp>
+
+namespace radiometry {
+
+class BlackbodyRadianceTable {
+ public:
+  /* Constructor for a band with a sampled relative spectral response
+   *
+   * \param[in] wavelengths       response wavelengths [micron], strictly
+   *                              increasing
+   * \param[in] response          relative spectral response at each
+   *                              wavelength
+   * \param[in] min_temperature   lowest tabulated temperature [K]
+   * \param[in] max_temperature   highest tabulated temperature [K]
+   * \param[in] temperature_step  table temperature step [K] [default is
+   *                              0.01]
+   */
+  BlackbodyRadianceTable(const Eigen::ArrayXd& wavelengths,
+                         const Eigen::ArrayXd& response,
+                         double min_temperature, double max_temperature,
+                         double temperature_step = 0.01);
+
+  /* Constructor for a band with a flat response (equal wavelengths give
+   * the spectral radiance at that wavelength)
+   *
+   * \param[in] lower_wavelength  band lower edge [micron]
+   * \param[in] upper_wavelength  band upper edge [micron], not below the
+   *                              lower edge
+   * \param[in] min_temperature   lowest tabulated temperature [K]
+   * \param[in] max_temperature   highest tabulated temperature [K]
+   * \param[in] temperature_step  table temperature step [K] [default is
+   *                              0.01]
+   * \param[in] samples           wavelengths integrated over the band
+   *                              [default is 101]
+   */
+  BlackbodyRadianceTable(double lower_wavelength, double upper_wavelength,
+                         double min_temperature, double max_temperature,
+                         double temperature_step = 0.01, int samples = 101);
+
+  // Getters
+  double min_temperature() const { return min_temperature_; }
+  double max_temperature() const { return max_temperature_; }
+  double temperature_step() const { return temperature_step_; }
+  size_t size() const { return table_.size(); }
+
+  /* Effective band radiance from the table [W/m^2/sr/micron]
+   */
+  double radiance(double temperature) const {
+    double x = (temperature - min_temperature_) * inverse_step_;
+    if (!((x >= 0) && (x <= last_))) {
+      return Evaluate(temperature);
+    }
+    size_t idx = std::min(static_cast<size_t>(x), table_.size() - 2);
+    double f = x - idx;
+    return table_[idx] + f * (table_[idx + 1] - table_[idx]);
+  }
+
+  /* Derivative of the effective band radiance with respect to temperature
+   * [W/m^2/sr/micron/K] (the slope of the table segment, or a central
+   * difference of the exact radiance outside of the table)
+   */
+  double derivative(double temperature) const {
+    double x = (temperature - min_temperature_) * inverse_step_;
+    if (!((x >= 0) && (x <= last_))) {
+      return (Evaluate(temperature + temperature_step_) -
+              Evaluate(temperature - temperature_step_)) *
+             0.5 * inverse_step_;
+    }
+    size_t idx = std::min(static_cast<size_t>(x), table_.size() - 2);
+    return (table_[idx + 1] - table_[idx]) * inverse_step_;
+  }
+
+  /* Response weighted mean wavelength of the band [micron]
+   */
+  double effective_wavelength() const {
+    return (weights_ * wavelengths_).sum();
+  }
+
+  /* Effective band radiance evaluated exactly [W/m^2/sr/micron]
+   */
+  double Evaluate(double temperature) const;
+
+  /* Effective band radiance of every pixel of a temperature image
+   *
+   * \param[in] temperature   temperature [K] cv::Mat of CV_32FC1 or
+   *                          CV_64FC1
+   *
+   * \return                  radiance image of the source type
+   */
+  cv::Mat Render(const cv::Mat& temperature) const;
+
+ private:
+  void Tabulate(double min_temperature, double max_temperature,
+                double temperature_step);
+
+  // Band wavelengths and their normalized integration weights
+  Eigen::ArrayXd wavelengths_;
+  Eigen::ArrayXd weights_;
+
+  double min_temperature_;
+  double max_temperature_;
+  double temperature_step_;
+  double inverse_step_;
+  double last_;
+  std::vector<double> table_;
+};
+}  // namespace radiometry
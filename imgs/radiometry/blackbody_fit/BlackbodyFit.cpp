@@ -17,26 +17,27 @@ using namespace std;
 
 namespace radiometry {
 
-double BlackbodyFit(vector<double>& wavelength,
-                    vector<double>& radiance, const double tolerance,
+double BlackbodyFit(const vector<double>& wavelength,
+                    const vector<double>& radiance, const double tolerance,
                     const double lower_limit, const double upper_limit,
                     vector<double>& em_spec) {
-  // checking if wavelength is in ascending order and reversing the vectors if
-  // it isn't
-  bool reversed = false;
-  if (wavelength.front() > wavelength.back()) {
-    reverse(wavelength.begin(), wavelength.end());
-    reverse(radiance.begin(), radiance.end());
-    reversed = true;
+  // checking if wavelength is in ascending order and searching reversed
+  // copies if it isn't (the caller's vectors are left alone)
+  vector<double> w_sorted(wavelength);
+  vector<double> r_sorted(radiance);
+  if (w_sorted.front() > w_sorted.back()) {
+    reverse(w_sorted.begin(), w_sorted.end());
+    reverse(r_sorted.begin(), r_sorted.end());
   }
 
   // getting the indexes of our vectors at the desired upper and lower bounds
+  // (w_upper is one past the last wavelength in the band)
   auto w_lower =
-      distance(wavelength.begin(),
-               lower_bound(wavelength.begin(), wavelength.end(), lower_limit));
+      distance(w_sorted.begin(),
+               lower_bound(w_sorted.begin(), w_sorted.end(), lower_limit));
   auto w_upper =
-      distance(wavelength.begin(),
-               upper_bound(wavelength.begin(), wavelength.end(), upper_limit));
+      distance(w_sorted.begin(),
+               upper_bound(w_sorted.begin(), w_sorted.end(), upper_limit));
 
   double temperature = 0.0;  // setting an initial temperature
 
@@ -46,12 +47,12 @@ double BlackbodyFit(vector<double>& wavelength,
   while (tolerance_calc >
          tolerance) {  // checking+repeating if our test tolerance hasn't
                        // reached our acceptable error
-    for (double idx = w_lower; idx <= w_upper;
+    for (auto idx = w_lower; idx < w_upper;
          idx++) {  // looping within our bounds
       double difference =
-          (steve.radiance(wavelength[idx]) -
-           radiance[idx]);  // getting the difference between blackbody radiance
-                            // and measured radiance
+          (steve.radiance(w_sorted[idx]) -
+           r_sorted[idx]);  // getting the difference between blackbody
+                            // radiance and measured radiance
       if (difference < 0) {
         temperature += tolerance_calc;  // resetting the temperature value if
                                         // our blackbody radiance goes too low
@@ -63,18 +64,12 @@ double BlackbodyFit(vector<double>& wavelength,
     steve.set_temperature(temperature);
   }
 
-  // putting the vectors back if they got reversed
-  if (reversed == true) {
-    reverse(wavelength.begin(), wavelength.end());
-    reverse(radiance.begin(), radiance.end());
-    reversed = false;
-  }
-
   // actually doing our blackbody-fit calculation for spectral emissivity
-  for (double idx = 0; idx <= radiance.size(); idx++) {
+  em_spec.clear();
+  for (size_t idx = 0; idx < radiance.size(); idx++) {
     em_spec.push_back(radiance[idx] / steve.radiance(wavelength[idx]));
   }
 
   return temperature;
 }
-}  // namespace radiometry
\ No newline at end of file
+}  // namespace radiometry
@@ -6,11 +6,13 @@
  * \note I watched the Big Short recently, good movie
  */
 
+#pragma once
+
 #include <vector>
 
 namespace radiometry {
-double BlackbodyFit(std::vector<double>& wavelength,
-                    std::vector<double>& radiance, const double tolerance,
+double BlackbodyFit(const std::vector<double>& wavelength,
+                    const std::vector<double>& radiance, const double tolerance,
                     const double lower_limit, const double upper_limit,
                     std::vector<double>& em_spec);
-}  // namespace radiometry
\ No newline at end of file
+}  // namespace radiometry
@@ -0,0 +1,243 @@
+/** Implementation file for least-squares temperature/emissivity separation
+ *
+ * \file imgs/radiometry/blackbody_fit/TemperatureEmissivity.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "imgs/radiometry/blackbody_fit/TemperatureEmissivity.h"
+
+#include "imgs/radiometry/blackbody/Blackbody.h"
+#include "imgs/radiometry/blackbody_temperature/BlackbodyTemperature.h"
+
+using namespace std;
+
+namespace radiometry {
+
+namespace {
+
+// Parameters are (temperature, e0[, e1]), so the normal equations are at
+// most 3 x 3 and live on the stack
+using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 3, 1>;
+using Matrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 3, 3>;
+
+/* Wavelengths of the fitted band, shared by every spectrum
+ */
+struct Band {
+  Band(const Eigen::ArrayXd& wavelengths, const FitParams& params) {
+    for (Eigen::Index idx = 0; idx < wavelengths.size(); idx++) {
+      if ((wavelengths(idx) >= params.lower_limit) &&
+          (wavelengths(idx) <= params.upper_limit)) {
+        index.push_back(idx);
+      }
+    }
+    Eigen::Index n = index.size();
+    parameters = (params.model == EmissivityModel::linear) ? 3 : 2;
+    if (n < parameters) {
+      throw runtime_error("Too few wavelengths in the fitted band");
+    }
+
+    w.resize(n);
+    for (Eigen::Index idx = 0; idx < n; idx++) {
+      w(idx) = wavelengths(index[idx]);
+    }
+    center = w.mean();
+    offset = w - center;
+    // B(w, T) = scale / (exp(c2 / (w T)) - 1)
+    scale = Blackbody::c1 / (M_PI * w.square().square() * w);
+    x = Blackbody::c2 / w;
+  }
+
+  vector<Eigen::Index> index;
+  Eigen::Index parameters;
+  Eigen::ArrayXd w;
+  Eigen::ArrayXd offset;
+  Eigen::ArrayXd scale;
+  Eigen::ArrayXd x;
+  double center;
+};
+
+/* Sum of squared residuals of the model at p, and optionally the normal
+ * equations J^T J and J^T r with the analytic Jacobian
+ *   dL/dT  = e B (c2 / (w T)) exp(c2 / (w T)) / (T (exp(c2 / (w T)) - 1))
+ *   dL/de0 = B
+ *   dL/de1 = (w - center) B
+ */
+double Evaluate(const Band& band, const Eigen::ArrayXd& radiance,
+                const Vector& p, Matrix* jtj = nullptr,
+                Vector* jtr = nullptr) {
+  Eigen::Index np = band.parameters;
+  if (jtj) {
+    jtj->setZero(np, np);
+    jtr->setZero(np);
+  }
+
+  double cost = 0;
+  double j[3];
+  for (Eigen::Index idx = 0; idx < band.w.size(); idx++) {
+    double x = band.x(idx) / p(0);
+    double e = exp(x);
+    double b = band.scale(idx) / (e - 1);
+    double emissivity = p(1);
+    if (np == 3) {
+      emissivity += p(2) * band.offset(idx);
+    }
+    double r = emissivity * b - radiance(idx);
+    cost += r * r;
+    if (jtj) {
+      j[0] = emissivity * b * x * e / ((e - 1) * p(0));
+      j[1] = b;
+      j[2] = band.offset(idx) * b;
+      for (Eigen::Index a = 0; a < np; a++) {
+        (*jtr)(a) += j[a] * r;
+        for (Eigen::Index c = 0; c <= a; c++) {
+          (*jtj)(a, c) += j[a] * j[c];
+        }
+      }
+    }
+  }
+  if (jtj) {
+    *jtj = jtj->selfadjointView<Eigen::Lower>();
+  }
+  return cost;
+}
+
+/* Levenberg-Marquardt fit of one spectrum gathered onto the band
+ */
+FitResult FitBand(const Band& band, const Eigen::ArrayXd& radiance,
+                  const FitParams& params) {
+  FitResult result;
+  Eigen::Index np = band.parameters;
+
+  // Start from the blackbody that just envelopes the spectrum (the largest
+  // brightness temperature in the band) and the best emissivity for it
+  double temperature = 0;
+  for (Eigen::Index idx = 0; idx < band.w.size(); idx++) {
+    temperature = max(temperature, Temperature::BrightnessTemperature(
+                                       radiance(idx), band.w(idx)));
+  }
+  if (!(temperature > 0) || !isfinite(temperature)) {
+    result.temperature = numeric_limits<double>::quiet_NaN();
+    result.emissivity = numeric_limits<double>::quiet_NaN();
+    return result;
+  }
+  Eigen::ArrayXd b =
+      band.scale / ((band.x / temperature).exp() - 1);
+  Vector p = Vector::Zero(np);
+  p(0) = temperature;
+  p(1) = (b * radiance).sum() / b.square().sum();
+
+  Matrix jtj;
+  Vector jtr;
+  double cost = Evaluate(band, radiance, p, &jtj, &jtr);
+  double lambda = 1e-3;
+  int iteration = 0;
+  while (iteration < params.max_iterations) {
+    iteration++;
+
+    // Marquardt damping scales the diagonal, so the temperature and the
+    // emissivities are damped in their own units
+    bool accepted = false;
+    Vector step;
+    while (lambda < 1e16) {
+      Matrix damped = jtj;
+      damped.diagonal() *= 1 + lambda;
+      step = damped.ldlt().solve(-jtr);
+      Vector trial = p + step;
+      if (trial(0) > 0) {
+        double trial_cost = Evaluate(band, radiance, trial);
+        if (trial_cost <= cost) {
+          p = trial;
+          accepted = true;
+          break;
+        }
+      }
+      lambda *= 10;
+    }
+    if (!accepted) {
+      // No step reduces the residual, p is a minimum to working precision
+      result.converged = true;
+      break;
+    }
+    lambda = max(lambda / 10, 1e-12);
+    cost = Evaluate(band, radiance, p, &jtj, &jtr);
+
+    bool small = true;
+    for (Eigen::Index a = 0; a < np; a++) {
+      small = small && (abs(step(a)) <=
+                        params.tolerance * (abs(p(a)) + params.tolerance));
+    }
+    if (small) {
+      result.converged = true;
+      break;
+    }
+  }
+
+  result.temperature = p(0);
+  result.emissivity = p(1);
+  result.slope = (np == 3) ? p(2) : 0;
+  result.rms = sqrt(cost / band.w.size());
+  result.iterations = iteration;
+  return result;
+}
+
+}  // namespace
+
+FitResult FitBlackbody(const Eigen::ArrayXd& wavelengths,
+                       const Eigen::ArrayXd& radiance,
+                       const FitParams& params) {
+  if (radiance.size() != wavelengths.size()) {
+    throw runtime_error("Wavelength and radiance counts differ");
+  }
+
+  Band band(wavelengths, params);
+  Eigen::ArrayXd gathered(band.w.size());
+  for (Eigen::Index idx = 0; idx < gathered.size(); idx++) {
+    gathered(idx) = radiance(band.index[idx]);
+  }
+  return FitBand(band, gathered, params);
+}
+
+void SeparateTemperatureEmissivity(const Eigen::ArrayXd& wavelengths,
+                                   const Eigen::MatrixXd& radiance,
+                                   const FitParams& params,
+                                   Eigen::Ref<Eigen::VectorXd> temperatures,
+                                   Eigen::Ref<Eigen::MatrixXd> emissivity) {
+  Eigen::Index n = wavelengths.size();
+  Eigen::Index m = radiance.cols();
+  if (radiance.rows() != n) {
+    throw runtime_error("Radiance rows and wavelength count differ");
+  }
+  if ((temperatures.size() != m) || (emissivity.rows() != n) ||
+      (emissivity.cols() != m)) {
+    throw runtime_error(
+        "Temperature and emissivity outputs must be preallocated to match "
+        "the radiance spectra");
+  }
+
+  Band band(wavelengths, params);
+  Eigen::ArrayXd scale = Blackbody::c1 / (M_PI * wavelengths.pow(5));
+  Eigen::ArrayXd x = Blackbody::c2 / wavelengths;
+
+  // Spectra are independent, each stripe reuses its own gather buffer
+  cv::parallel_for_(cv::Range(0, static_cast<int>(m)),
+                    [&](const cv::Range& range) {
+    Eigen::ArrayXd gathered(band.w.size());
+    for (int s = range.start; s < range.end; s++) {
+      for (Eigen::Index idx = 0; idx < gathered.size(); idx++) {
+        gathered(idx) = radiance(band.index[idx], s);
+      }
+      double temperature = FitBand(band, gathered, params).temperature;
+      temperatures(s) = temperature;
+      emissivity.col(s) =
+          radiance.col(s).array() * ((x / temperature).exp() - 1) / scale;
+    }
+  });
+}
+}  // namespace radiometry
@@ -0,0 +1,72 @@
+/** Interface file for least-squares temperature/emissivity separation
+ *
+ * \file imgs/radiometry/blackbody_fit/TemperatureEmissivity.h
+ *
+ * \description
+ *   Fits the radiance model
+ *     L(w) = e(w) B(w, T)  [W/m^2/sr/micron]
+ *   over a wavelength band by Levenberg-Marquardt nonlinear least squares
+ *   with analytic Jacobians, where B is Planck's spectral radiance and the
+ *   emissivity e is either a constant (graybody) or a linear function of
+ *   wavelength.  The fit starts from the largest brightness temperature in
+ *   the band.  The emissivity spectrum of a fitted spectrum is L(w) / B(w, T)
+ *   at every wavelength, and many spectra (one per column) may be separated
+ *   in parallel into preallocated matrices.
+ */
+
+#pragma once
+
+#include <eigen3/Eigen/Dense>
+
+namespace radiometry {
+
+enum class EmissivityModel {
+  graybody,  // e(w) = e0
+  linear     // e(w) = e0 + e1 (w - band center)
+};
+
+struct FitParams {
+  EmissivityModel model = EmissivityModel::graybody;
+  double lower_limit = 7.0;   // fitted band lower edge [micron]
+  double upper_limit = 15.0;  // fitted band upper edge [micron]
+  int max_iterations = 100;
+  double tolerance = 1e-10;  // relative parameter step at convergence
+};
+
+struct FitResult {
+  double temperature = 0;  // [K]
+  double emissivity = 0;   // e0
+  double slope = 0;        // e1 [1/micron] (0 for a graybody)
+  double rms = 0;          // residual [W/m^2/sr/micron]
+  int iterations = 0;
+  bool converged = false;
+};
+
+/* Least-squares fit of temperature and emissivity to one spectrum
+ *
+ * \param[in] wavelengths  wavelengths [micron], in any order
+ * \param[in] radiance     spectral radiance at each wavelength
+ *                         [W/m^2/sr/micron]
+ * \param[in] params       emissivity model, band, and stopping criteria
+ *
+ * \return                 fitted parameters
+ */
+FitResult FitBlackbody(const Eigen::ArrayXd& wavelengths,
+                       const Eigen::ArrayXd& radiance,
+                       const FitParams& params = FitParams());
+
+/* Temperature/emissivity separation of many spectra in parallel
+ *
+ * \param[in] wavelengths    wavelengths [micron] (n), in any order
+ * \param[in] radiance       spectral radiance [W/m^2/sr/micron], one
+ *                           spectrum per column (n x m)
+ * \param[in] params         emissivity model, band, and stopping criteria
+ * \param[out] temperatures  fitted temperature of each spectrum [K] (m)
+ * \param[out] emissivity    emissivity spectrum of each spectrum (n x m)
+ */
+void SeparateTemperatureEmissivity(const Eigen::ArrayXd& wavelengths,
+                                   const Eigen::MatrixXd& radiance,
+                                   const FitParams& params,
+                                   Eigen::Ref<Eigen::VectorXd> temperatures,
+                                   Eigen::Ref<Eigen::MatrixXd> emissivity);
+}  // namespace radiometry
@@ -8,35 +8,131 @@
 
 // more headers and libraries
 #include <cmath>
-#include <vector>
+#include <stdexcept>
+#include <eigen3/Eigen/Dense>
 #include "imgs/radiometry/blackbody_temperature/BlackbodyTemperature.h"
 #include "imgs/radiometry/blackbody/Blackbody.h"
 
 namespace Temperature {
 
+namespace {
+
+// Planck's radiance at one wavelength written as L(T) = k / (exp(a / T) - 1)
+struct Planck {
+  explicit Planck(double wavelength)
+      : a(radiometry::Blackbody::c2 / wavelength),
+        k(radiometry::Blackbody::c1 /
+          (M_PI * std::pow(wavelength, 5))) {}
+
+  double Invert(double radiance) const {
+    return (radiance > 0) ? a / std::log1p(k / radiance) : 0;
+  }
+
+  // Newton iterations on L(T) - radiance, with
+  // dL/dT = k a exp(a / T) / (T^2 (exp(a / T) - 1)^2)
+  double Refine(double radiance, double temperature, int iterations) const {
+    for (int i = 0; (i < iterations) && (temperature > 0); i++) {
+      double e = std::exp(a / temperature);
+      double l = k / (e - 1);
+      double slope = l * e * a / (temperature * temperature * (e - 1));
+      if (!(slope > 0)) {
+        break;
+      }
+      temperature -= (l - radiance) / slope;
+    }
+    return temperature;
+  }
+
+  double a;
+  double k;
+};
+
+// Newton iterations on the tabulated band radiance
+double RefineBand(double radiance, double temperature,
+                  const radiometry::BlackbodyRadianceTable& band,
+                  int iterations) {
+  for (int i = 0; (i < iterations) && (temperature > 0); i++) {
+    double slope = band.derivative(temperature);
+    if (!(slope > 0)) {
+      break;
+    }
+    temperature -= (band.radiance(temperature) - radiance) / slope;
+  }
+  return temperature;
+}
+
+// Closed form over a whole row as one (vectorized) array expression,
+// non-positive radiances are 0 K
+template <typename T>
+void InvertRow(const T* in, T* out, int cols, const Planck& planck) {
+  using Row = Eigen::Array<T, Eigen::Dynamic, 1>;
+  Eigen::Map<const Row> l(in, cols);
+  Eigen::Map<Row> t(out, cols);
+  T a = static_cast<T>(planck.a);
+  T k = static_cast<T>(planck.k);
+  t = (l > 0).select(a / (k / l).log1p(), T(0));
+}
+
+template <typename T, typename Refine>
+void InvertRows(const cv::Mat& src, cv::Mat& dst, const Planck& planck,
+                int iterations, const Refine& refine) {
+  cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+    for (int r = range.start; r < range.end; r++) {
+      const T* in = src.ptr<T>(r);
+      T* out = dst.ptr<T>(r);
+      InvertRow(in, out, src.cols, planck);
+      if (iterations > 0) {
+        for (int c = 0; c < src.cols; c++) {
+          if (in[c] > 0) {
+            out[c] = static_cast<T>(refine(in[c], out[c]));
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename Refine>
+cv::Mat Invert(const cv::Mat& radiance, const Planck& planck,
+               int iterations, const Refine& refine) {
+  if ((radiance.type() != CV_32FC1) && (radiance.type() != CV_64FC1)) {
+    throw std::runtime_error(
+        "Radiance image must be of type CV_32FC1 or CV_64FC1");
+  }
+
+  cv::Mat temperature(radiance.size(), radiance.type());
+  if (radiance.depth() == CV_32F) {
+    InvertRows<float>(radiance, temperature, planck, iterations, refine);
+  } else {
+    InvertRows<double>(radiance, temperature, planck, iterations, refine);
+  }
+  return temperature;
+}
+
+}  // namespace
+
 // passing our variables from the application to the implementation
 double CalcTemp(double rad_search, double wavelength, double tolerance) {
-  // a vector with sequential values from 1-6000
+  // searching the temperatures 1-6000 [K], the temperature at an index is
+  // just the index + 1 (no need to build the whole list of them)
   // I was initially going from 0-6000 but then I was getting 301 K instead of
   // 300 K
-  std::vector<double> temp_search;
-  for (size_t idx = 0; idx < 6000; idx++) {
-    temp_search.push_back(idx + 1);
-  }
+  const size_t temp_count = 6000;
 
   // basically doing what it says on the flow chart
   double low = 0;
-  double high = temp_search.size() - 1;
+  double high = temp_count - 1;
   double middle = (low + high) / 2;
   double range = high - low;
   while (range > tolerance) {
     // calling our blackbody function for the current middle temperature
-    radiometry::Blackbody steve(temp_search[middle]);
+    radiometry::Blackbody steve(static_cast<size_t>(middle) + 1);
+    double radiance = steve.radiance(wavelength);
     // comparing the radiance we're searching for to the radiance at the middle
     // temperature
-    if (rad_search < steve.radiance(wavelength)) {
+    if (rad_search < radiance) {
       high = middle;
-    } else if (rad_search > steve.radiance(wavelength)) {
+    } else if (rad_search > radiance) {
       low = middle;
     } else {
       break;
@@ -48,4 +144,37 @@ double CalcTemp(double rad_search, double wavelength, double tolerance) {
   // sending the number we have after the loop back to the application file
   return middle;
 }
-}  // namespace Temperature
\ No newline at end of file
+
+double BrightnessTemperature(double radiance, double wavelength) {
+  return Planck(wavelength).Invert(radiance);
+}
+
+double BrightnessTemperature(double radiance,
+                             const radiometry::BlackbodyRadianceTable& band,
+                             int iterations) {
+  if (!(radiance > 0)) {
+    return 0;
+  }
+  double temperature = Planck(band.effective_wavelength()).Invert(radiance);
+  return RefineBand(radiance, temperature, band, iterations);
+}
+
+cv::Mat BrightnessTemperature(const cv::Mat& radiance, double wavelength,
+                              int iterations) {
+  Planck planck(wavelength);
+  return Invert(radiance, planck, iterations,
+                [&](double l, double t) {
+                  return planck.Refine(l, t, iterations);
+                });
+}
+
+cv::Mat BrightnessTemperature(const cv::Mat& radiance,
+                              const radiometry::BlackbodyRadianceTable& band,
+                              int iterations) {
+  Planck planck(band.effective_wavelength());
+  return Invert(radiance, planck, iterations,
+                [&](double l, double t) {
+                  return RefineBand(l, t, band, iterations);
+                });
+}
+}  // namespace Temperature
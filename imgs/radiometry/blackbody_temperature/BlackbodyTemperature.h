@@ -6,6 +6,42 @@
  * \note I have nothing to note in this file
  */
 
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include "imgs/radiometry/blackbody/BlackbodyRadianceTable.h"
+
 namespace Temperature {
 double CalcTemp(double rad_search, double wavelength, double tolerance);
+
+/* Brightness temperature [K] of a spectral radiance [W/m^2/sr/micron] at a
+ * wavelength [micron], from the closed-form inverse of Planck's equation
+ *   T = c2 / (wavelength * ln(1 + c1 / (pi * wavelength^5 * radiance)))
+ * (non-positive radiances give 0 K)
+ */
+double BrightnessTemperature(double radiance, double wavelength);
+
+/* Brightness temperature [K] of an effective band radiance, starting from
+ * the closed form at the band's effective wavelength followed by Newton
+ * iterations on the band radiance table
+ */
+double BrightnessTemperature(double radiance,
+                             const radiometry::BlackbodyRadianceTable& band,
+                             int iterations = 3);
+
+/* Brightness temperature map [K] of a CV_32FC1 or CV_64FC1 spectral radiance
+ * image (rows in parallel, the closed form is evaluated as vectorized array
+ * expressions, and each Newton iteration on the exact Planck equation in
+ * double precision is optional) [default is no iterations]
+ */
+cv::Mat BrightnessTemperature(const cv::Mat& radiance, double wavelength,
+                              int iterations = 0);
+
+/* Brightness temperature map [K] of a CV_32FC1 or CV_64FC1 effective band
+ * radiance image
+ */
+cv::Mat BrightnessTemperature(const cv::Mat& radiance,
+                              const radiometry::BlackbodyRadianceTable& band,
+                              int iterations = 3);
 };  // namespace TempNamespace
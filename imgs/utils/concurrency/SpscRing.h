@@ -0,0 +1,137 @@
+/** Interface file for a single producer, single consumer ring buffer
+ *
+ *  \file imgs/utils/concurrency/SpscRing.h
+ *
+ *  \description
+ *    Fixed-capacity, lock-free queue between exactly one producer thread and
+ *    one consumer thread.  The storage is allocated once at construction,
+ *    the producer only writes the tail index and the consumer only writes
+ *    the head index (each on its own cache line), so pushing and popping
+ *    never lock or allocate.  The blocking Push and Pop spin briefly, then
+ *    yield, then sleep while the ring is full or empty, which gives
+ *    back-pressure between pipeline stages.  Close lets the consumer drain
+ *    the ring and then see the end of the stream.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+template <typename T>
+class SpscRing {
+ public:
+  /* Constructor
+   *
+   * \param[in] capacity  maximum number of queued elements (rounded up to a
+   *                      power of two)
+   */
+  explicit SpscRing(size_t capacity) {
+    if (capacity == 0) {
+      throw std::runtime_error("Ring buffer capacity must be positive");
+    }
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    buffer_.resize(size);
+    mask_ = size - 1;
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  size_t capacity() const { return buffer_.size(); }
+
+  /* Number of queued elements (exact only from the producer or consumer
+   * thread while the other is idle)
+   */
+  size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+  /* Producer, queue an element unless the ring is full
+   */
+  bool TryPush(const T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == buffer_.size()) {
+      return false;
+    }
+    buffer_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /* Producer, queue an element, waiting while the ring is full
+   */
+  void Push(const T& value) {
+    for (int attempt = 0; !TryPush(value); attempt++) {
+      Wait(attempt);
+    }
+  }
+
+  /* Producer, no more elements will be pushed
+   */
+  void Close() { closed_.store(true, std::memory_order_release); }
+
+  /* Consumer, dequeue an element unless the ring is empty
+   */
+  bool TryPop(T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = std::move(buffer_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /* Consumer, dequeue an element, waiting while the ring is empty
+   *
+   * \return  false once the ring is closed and drained
+   */
+  bool Pop(T& value) {
+    for (int attempt = 0; !TryPop(value); attempt++) {
+      // Anything pushed before Close is visible once closed is seen
+      if (closed()) {
+        return TryPop(value);
+      }
+      Wait(attempt);
+    }
+    return true;
+  }
+
+ private:
+  static void Wait(int attempt) {
+    if (attempt < 64) {
+      return;
+    }
+    if (attempt < 128) {
+      std::this_thread::yield();
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  static constexpr size_t kCacheLine = 64;
+
+  std::vector<T> buffer_;
+  size_t mask_ = 0;
+  alignas(kCacheLine) std::atomic<size_t> head_{0};
+  alignas(kCacheLine) std::atomic<size_t> tail_{0};
+  alignas(kCacheLine) std::atomic<bool> closed_{false};
+};
+
+}  // namespace utils
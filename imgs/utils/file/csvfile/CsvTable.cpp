@@ -0,0 +1,341 @@
+/** Implementation file for a memory-mapped, columnar CSV table
+ *
+ * \file imgs/utils/file/csvfile/CsvTable.cpp
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "imgs/utils/file/csvfile/CsvTable.h"
+
+using namespace std;
+
+namespace utils {
+
+namespace {
+
+// Files smaller than this per thread are not worth splitting [bytes]
+const size_t kMinChunkSize = 1 << 20;
+
+bool IsBlank(char c) { return (c == ' ') || (c == '\t') || (c == '\r'); }
+
+/* Field [begin, end) with the surrounding blanks removed
+ */
+void Trim(const char*& begin, const char*& end) {
+  while ((begin < end) && IsBlank(*begin)) {
+    begin++;
+  }
+  while ((end > begin) && IsBlank(*(end - 1))) {
+    end--;
+  }
+}
+
+const char* EndOfLine(const char* p, const char* end) {
+  const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+  return eol ? eol : end;
+}
+
+const char* NextLine(const char* eol, const char* end) {
+  return (eol < end) ? eol + 1 : end;
+}
+
+/* Calls field(begin, end, index) for each delimited field of a line and
+ * returns the number of fields
+ */
+template <typename Field>
+size_t Split(const char* begin, const char* end, char delimiter,
+             const Field& field) {
+  size_t count = 0;
+  while (true) {
+    const char* next =
+        static_cast<const char*>(memchr(begin, delimiter, end - begin));
+    const char* stop = next ? next : end;
+    field(begin, stop, count++);
+    if (!next) {
+      return count;
+    }
+    begin = next + 1;
+  }
+}
+
+/* Mapped file with its header lines consumed
+ */
+struct Source {
+  Source(const string& filename, size_t header_lines, size_t label_line,
+         char delimiter, vector<string>& labels) {
+    if (!filesystem::exists(filename)) {
+      throw runtime_error("Specified file does not exist");
+    }
+    if (filesystem::file_size(filename) == 0) {
+      throw runtime_error("Specified file is empty");
+    }
+
+    file.open(filename);
+    begin = file.data();
+    end = begin + file.size();
+
+    data = begin;
+    const char* p = begin;
+    for (size_t line = 1; (line <= max(header_lines, label_line)) && (p < end);
+         line++) {
+      const char* eol = EndOfLine(p, end);
+      if (line == label_line) {
+        Split(p, eol, delimiter, [&](const char* b, const char* e, size_t) {
+          Trim(b, e);
+          labels.emplace_back(b, e);
+        });
+      }
+      p = NextLine(eol, end);
+      if (line <= header_lines) {
+        data = p;
+      }
+    }
+
+    // Columns are counted on the first non-blank data line
+    for (const char* p = data; p < end;) {
+      const char* eol = EndOfLine(p, end);
+      const char* b = p;
+      const char* e = eol;
+      Trim(b, e);
+      if (b < e) {
+        cols = Split(p, eol, delimiter,
+                     [](const char*, const char*, size_t) {});
+        break;
+      }
+      p = NextLine(eol, end);
+    }
+  }
+
+  /* Line number of a position, only needed to report errors
+   */
+  size_t Line(const char* p) const { return count(begin, p, '\n') + 1; }
+
+  boost::iostreams::mapped_file_source file;
+  const char* begin;
+  const char* end;
+  const char* data;  // first line after the header
+  size_t cols = 0;
+};
+
+double Parse(const Source& source, const char* begin, const char* end) {
+  const char* field = begin;
+  Trim(begin, end);
+  if ((begin < end) && (*begin == '+')) {
+    begin++;
+  }
+  double value;
+  auto [ptr, ec] = from_chars(begin, end, value);
+  if ((ec != errc()) || (ptr != end) || (begin == end)) {
+    throw runtime_error("Invalid number on line " +
+                        to_string(source.Line(field)) + ": \"" +
+                        string(begin, end) + "\"");
+  }
+  return value;
+}
+
+/* Parses up to max_rows data lines starting at p (advanced past them) and
+ * stopping at end into column-major storage with a leading dimension of
+ * capacity rows
+ *
+ * \return  rows parsed
+ */
+size_t ParseRows(const Source& source, const char*& p, const char* end,
+                 char delimiter, size_t max_rows, double* data,
+                 size_t capacity) {
+  size_t cols = source.cols;
+  size_t rows = 0;
+  while ((p < end) && (rows < max_rows)) {
+    const char* begin = p;
+    const char* eol = EndOfLine(p, end);
+    p = NextLine(eol, end);
+
+    const char* b = begin;
+    const char* e = eol;
+    Trim(b, e);
+    if (b == e) {
+      continue;
+    }
+
+    size_t fields = Split(begin, eol, delimiter,
+                          [&](const char* fb, const char* fe, size_t c) {
+                            if (c < cols) {
+                              data[c * capacity + rows] =
+                                  Parse(source, fb, fe);
+                            }
+                          });
+    if (fields != cols) {
+      throw runtime_error("Line " + to_string(source.Line(begin)) + " has " +
+                          to_string(fields) + " fields, expected " +
+                          to_string(cols));
+    }
+    rows++;
+  }
+  return rows;
+}
+
+/* Column buffers of one newline-aligned chunk of the file
+ */
+struct Chunk {
+  const char* begin;
+  const char* end;
+  size_t capacity = 0;
+  size_t rows = 0;
+  vector<double> data;
+  exception_ptr error;
+};
+
+}  // namespace
+
+CsvTable::CsvTable(const string& filename, size_t header_lines,
+                   size_t label_line, char delimiter, unsigned int threads)
+    : filename_(filename) {
+  Source source(filename, header_lines, label_line, delimiter, labels_);
+  cols_ = source.cols;
+  if (cols_ == 0) {
+    return;
+  }
+
+  if (threads == 0) {
+    threads = max(thread::hardware_concurrency(), 1u);
+  }
+  size_t size = source.end - source.data;
+  size_t chunks = max<size_t>(min<size_t>(threads, size / kMinChunkSize), 1);
+
+  if (chunks == 1) {
+    // Every remaining line could be a data line, so the columns are laid out
+    // with this capacity and compacted once the row count is known
+    size_t capacity = count(source.data, source.end, '\n') + 1;
+    data_.resize(cols_ * capacity);
+    const char* p = source.data;
+    rows_ = ParseRows(source, p, source.end, delimiter, capacity,
+                      data_.data(), capacity);
+    for (size_t c = 1; c < cols_; c++) {
+      copy_n(data_.begin() + c * capacity, rows_, data_.begin() + c * rows_);
+    }
+    data_.resize(cols_ * rows_);
+    return;
+  }
+
+  // Chunk boundaries are moved forward to the start of the next line
+  vector<Chunk> parts(chunks);
+  const char* start = source.data;
+  for (size_t idx = 0; idx < chunks; idx++) {
+    const char* stop = source.data + (size * (idx + 1)) / chunks;
+    if (idx + 1 < chunks) {
+      stop = NextLine(EndOfLine(max(stop, start), source.end), source.end);
+    } else {
+      stop = source.end;
+    }
+    parts[idx].begin = start;
+    parts[idx].end = stop;
+    start = stop;
+  }
+
+  auto run = [&](const auto& work) {
+    vector<thread> workers;
+    for (size_t idx = 0; idx < chunks; idx++) {
+      workers.emplace_back([&, idx]() {
+        try {
+          work(parts[idx]);
+        } catch (...) {
+          parts[idx].error = current_exception();
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    for (auto& part : parts) {
+      if (part.error) {
+        rethrow_exception(part.error);
+      }
+    }
+  };
+
+  // Parse each chunk into its own column buffers
+  run([&](Chunk& part) {
+    part.capacity = count(part.begin, part.end, '\n') + 1;
+    part.data.resize(cols_ * part.capacity);
+    const char* p = part.begin;
+    part.rows = ParseRows(source, p, part.end, delimiter, part.capacity,
+                          part.data.data(), part.capacity);
+  });
+
+  // Concatenate the chunks, each copying its rows into every column
+  vector<size_t> offset(chunks, 0);
+  for (size_t idx = 1; idx < chunks; idx++) {
+    offset[idx] = offset[idx - 1] + parts[idx - 1].rows;
+  }
+  rows_ = offset.back() + parts.back().rows;
+  data_.resize(cols_ * rows_);
+  run([&](Chunk& part) {
+    size_t row = offset[&part - parts.data()];
+    for (size_t c = 0; c < cols_; c++) {
+      copy_n(part.data.begin() + c * part.capacity, part.rows,
+             data_.begin() + c * rows_ + row);
+    }
+    vector<double>().swap(part.data);
+  });
+}
+
+size_t CsvTable::Index(size_t column) const {
+  if ((column == 0) || (column > cols_)) {
+    throw runtime_error("Requested column is out of range");
+  }
+  return column - 1;
+}
+
+const string& CsvTable::label(size_t column) const {
+  if (labels_.empty()) {
+    throw runtime_error("No line for labels specified");
+  }
+  size_t idx = Index(column);
+  if (idx >= labels_.size()) {
+    throw runtime_error("Requested column has no label");
+  }
+  return labels_[idx];
+}
+
+struct CsvBatchReader::File : Source {
+  using Source::Source;
+};
+
+CsvBatchReader::CsvBatchReader(const string& filename, size_t batch_rows,
+                               size_t header_lines, size_t label_line,
+                               char delimiter)
+    : batch_rows_(batch_rows), delimiter_(delimiter) {
+  if (batch_rows == 0) {
+    throw runtime_error("Batch rows must be positive");
+  }
+  file_ = make_unique<File>(filename, header_lines, label_line, delimiter,
+                            labels_);
+  position_ = file_->data;
+  cols_ = file_->cols;
+}
+
+CsvBatchReader::~CsvBatchReader() = default;
+
+bool CsvBatchReader::Next(Eigen::MatrixXd& batch) {
+  if ((cols_ == 0) || (position_ >= file_->end)) {
+    batch.resize(0, cols_);
+    return false;
+  }
+
+  batch.resize(batch_rows_, cols_);
+  size_t rows = ParseRows(*file_, position_, file_->end, delimiter_,
+                          batch_rows_, batch.data(), batch_rows_);
+  if (rows < batch_rows_) {
+    // Trailing blank lines can leave a last batch without any rows
+    batch.conservativeResize(rows, cols_);
+  }
+  return rows > 0;
+}
+
+}  // namespace utils
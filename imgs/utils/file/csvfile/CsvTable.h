@@ -0,0 +1,119 @@
+/** Interface file for a memory-mapped, columnar CSV table
+ *
+ * \file imgs/utils/file/csvfile/CsvTable.h
+ *
+ * \description
+ *   Loads every column of a numeric CSV file at once.  The file is memory
+ *   mapped and tokenized in a single pass, numbers are converted with
+ *   std::from_chars, and the values are stored column-major in one
+ *   contiguous buffer, so a column (or the whole table) is returned as an
+ *   Eigen::Map without copying.  Blank lines are skipped, fields may be
+ *   padded with spaces or tabs, and every data line must have the same
+ *   number of fields.
+ *
+ *   Large files may be parsed on several threads, each parsing a
+ *   newline-aligned chunk of the file into its own column buffers, which
+ *   are then concatenated into the table.  CsvBatchReader instead streams
+ *   the rows in fixed-size batches for tables too large to hold at once.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
+
+namespace utils {
+
+class CsvTable {
+ public:
+  /* Constructor
+   *
+   * \param[in] filename      CSV filename
+   * \param[in] header_lines  number of header lines [default is 0]
+   * \param[in] label_line    line number that column labels appear on
+   *                          [default is 0, no labels]
+   * \param[in] delimiter     field delimiter [default is ',']
+   * \param[in] threads       parsing threads, 0 for one per hardware
+   *                          thread (small files are always parsed on
+   *                          one) [default is 1]
+   */
+  CsvTable(const std::string& filename, size_t header_lines = 0,
+           size_t label_line = 0, char delimiter = ',',
+           unsigned int threads = 1);
+
+  // Getters
+  std::string filename() const { return filename_; }
+  size_t rows() const { return rows_; }
+  size_t cols() const { return cols_; }
+
+  /* Return data from desired column (begin numbering at 1, as CsvFile)
+   *
+   * \return  view of the column, valid for the lifetime of the table
+   */
+  Eigen::Map<const Eigen::VectorXd> column(size_t column) const {
+    return Eigen::Map<const Eigen::VectorXd>(
+        data_.data() + (Index(column) * rows_), rows_);
+  }
+
+  /* Return the whole table (rows x cols, column-major)
+   */
+  Eigen::Map<const Eigen::MatrixXd> matrix() const {
+    return Eigen::Map<const Eigen::MatrixXd>(data_.data(), rows_, cols_);
+  }
+
+  /* Return label/title from desired column (begin numbering at 1)
+   */
+  const std::string& label(size_t column) const;
+
+ private:
+  size_t Index(size_t column) const;
+
+  std::string filename_;
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  std::vector<double> data_;
+  std::vector<std::string> labels_;
+};
+
+class CsvBatchReader {
+ public:
+  /* Constructor
+   *
+   * \param[in] filename      CSV filename
+   * \param[in] batch_rows    rows returned per batch
+   * \param[in] header_lines  number of header lines [default is 0]
+   * \param[in] label_line    line number that column labels appear on
+   *                          [default is 0, no labels]
+   * \param[in] delimiter     field delimiter [default is ',']
+   */
+  CsvBatchReader(const std::string& filename, size_t batch_rows,
+                 size_t header_lines = 0, size_t label_line = 0,
+                 char delimiter = ',');
+  ~CsvBatchReader();
+
+  size_t cols() const { return cols_; }
+  const std::vector<std::string>& labels() const { return labels_; }
+
+  /* Read the next batch of rows
+   *
+   * \param[out] batch  next batch_rows rows (fewer for the last batch) x
+   *                    cols, reusing its storage from call to call
+   *
+   * \return            false once every row has been returned
+   */
+  bool Next(Eigen::MatrixXd& batch);
+
+ private:
+  struct File;
+  std::unique_ptr<File> file_;
+  const char* position_;
+  size_t batch_rows_;
+  size_t cols_ = 0;
+  char delimiter_;
+  std::vector<std::string> labels_;
+};
+
+}  // namespace utils
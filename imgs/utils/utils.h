@@ -7,5 +7,7 @@
 
 #pragma once
 
+#include "imgs/utils/concurrency/SpscRing.h"
 #include "imgs/utils/file/csvfile/CsvFile.h"
+#include "imgs/utils/file/csvfile/CsvTable.h"
 #include "imgs/utils/shift_vector/ShiftVector.h"